@@ -83,7 +83,7 @@ LogicalResult tritonTranslateMain(int argc, char **argv,
 
   static llvm::cl::opt<std::string> targetKind(
       "target",
-      llvm::cl::desc("<translation target, options: llvmir/ptx/hsaco>"),
+      llvm::cl::desc("<translation target, options: llvmir/ptx/amdgcn/hsaco>"),
       llvm::cl::value_desc("target"), llvm::cl::init("llvmir"));
 
   static llvm::cl::opt<int> SMArch("sm", llvm::cl::desc("sm arch"),
@@ -101,7 +101,7 @@ LogicalResult tritonTranslateMain(int argc, char **argv,
       llvm::cl::value_desc("target triple"), llvm::cl::init("-amd-amdhsa"));
 
   static llvm::cl::opt<std::string> GCNFeatures(
-      "", llvm::cl::desc("AMDGCN features. e.g. '+sramecc,-xnack'"),
+      "features", llvm::cl::desc("AMDGCN features. e.g. '+sramecc,-xnack'"),
       llvm::cl::value_desc("features"), llvm::cl::init("+sramecc,-xnack"));
 
   llvm::InitLLVM y(argc, argv);
@@ -143,6 +143,11 @@ LogicalResult tritonTranslateMain(int argc, char **argv,
   } else if (targetKind == "ptx") {
     llvm::outs() << ::triton::translateLLVMIRToPTX(*llvmir, SMArch.getValue(),
                                                    ptxVersion.getValue());
+  } else if (targetKind == "amdgcn") {
+    auto [amdgcn, hsaco] = mlir::triton::translateLLVMIRToHSACO(
+        *llvmir, GCNArch.getValue(), GCNTriple.getValue(),
+        GCNFeatures.getValue());
+    llvm::outs() << amdgcn;
   } else if (targetKind == "hsaco") {
     auto [module, hsaco] = mlir::triton::translateLLVMIRToHSACO(
         *llvmir, GCNArch.getValue(), GCNTriple.getValue(),
@@ -90,6 +90,40 @@ public:
                  ArrayRef<dataflow::Lattice<AliasInfo> *> results) override;
 };
 
+//===----------------------------------------------------------------------===//
+// Global Memory Alias Analysis
+//===----------------------------------------------------------------------===//
+
+/// Alias analysis for pointers into global memory.
+///
+/// Every pointer is traced back through `tt.addptr` chains (and the shape and
+/// layout manipulations in between) to its base. Two pointers whose bases are
+/// different kernel arguments are known not to alias if at least one of the
+/// arguments carries the opt-in `tt.noalias` attribute, which has the same
+/// meaning as C's `restrict`: the memory reached through that argument is not
+/// reached through any other argument of the function.
+class GlobalMemoryAliasAnalysis {
+public:
+  static constexpr const char *noAliasAttrName = "tt.noalias";
+
+  /// Returns the function argument `ptr` is derived from, or a null value if
+  /// the base cannot be determined.
+  static Value getUnderlyingBase(Value ptr);
+
+  /// Given two pointers (or tensors of pointers), returns their aliasing
+  /// behavior.
+  AliasResult alias(Value lhs, Value rhs);
+
+  /// Returns the modify-reference behavior of `op` on the memory pointed to by
+  /// `location`.
+  ModRefResult getModRef(Operation *op, Value location);
+
+  /// Returns true if `op` may write to the memory pointed to by `location`.
+  bool mayClobber(Operation *op, Value location) {
+    return getModRef(op, location).isMod();
+  }
+};
+
 } // namespace mlir
 
 #endif // TRITON_ANALYSIS_ALIAS_H
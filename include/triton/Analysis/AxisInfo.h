@@ -297,8 +297,8 @@ public:
 /// do not have recursive functions.
 /// Since each function will be called multiple times, we need to
 /// calculate the axis info based on the axis info of all the callers.
-/// In the future, we can perform optimization using function cloning so that
-/// each call site will have unique axis info.
+/// `triton-specialize-calls` clones callees so that call sites with different
+/// axis info no longer share (and pessimize) the same function.
 using AxisInfoMapT = DenseMap<Value, AxisInfo>;
 class ModuleAxisInfoAnalysis : public CallGraph<AxisInfoMapT> {
 public:
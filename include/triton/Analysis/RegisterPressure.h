@@ -0,0 +1,67 @@
+#ifndef TRITON_ANALYSIS_REGISTER_PRESSURE_H
+#define TRITON_ANALYSIS_REGISTER_PRESSURE_H
+
+#include "mlir/IR/Operation.h"
+#include "mlir/Support/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+
+namespace mlir {
+
+//===----------------------------------------------------------------------===//
+// RegisterPressureAnalysis
+//===----------------------------------------------------------------------===//
+
+/// Estimates the number of 32-bit vector registers each thread needs to hold
+/// the values live at every program point.
+///
+/// A tensor in a distributed layout costs its elements per thread times its
+/// element width; tensors in shared memory and scalars, which end up in scalar
+/// registers, cost nothing. The estimate ignores the temporaries created when
+/// lowering to LLVM (addresses, masks, shuffles, ...), so it is a lower bound
+/// of the final register usage that is meant to compare configurations and
+/// detect the ones that are bound to spill, not to predict the exact count.
+///
+/// Liveness is computed by a backward walk of each block. A value defined
+/// outside of a region and live after its parent op is counted live in the
+/// whole region, and loop-carried values are live across the loop body.
+class RegisterPressureAnalysis {
+public:
+  explicit RegisterPressureAnalysis(Operation *root);
+
+  /// Returns the number of registers live while `op` executes: its operands,
+  /// its results and the values live across it. For ops with regions this
+  /// includes the peak of the ops nested in them.
+  unsigned getPressure(Operation *op) const { return pressure.lookup(op); }
+
+  /// Returns the number of registers per thread taken by a value of `type`.
+  static unsigned getNumRegs(Type type);
+
+  /// Returns the number of vector registers a thread may use without
+  /// spilling when `wavesPerEU` waves share each SIMD, or the size of the
+  /// register file when `wavesPerEU` is not set. `matrixCoreVersion` selects
+  /// the register file: 1 is gfx908, whose AGPRs are a separate file that
+  /// only MFMA instructions use, so only its VGPRs count.
+  static unsigned getRegisterBudget(int wavesPerEU, int matrixCoreVersion = 0);
+
+private:
+  using ValueSet = DenseSet<Value>;
+
+  /// Visits the blocks of `region` and adds the values defined above it and
+  /// used in it to `usedAbove`. Returns the peak pressure in the region.
+  unsigned visitRegion(Region &region, ValueSet &usedAbove,
+                       const ValueSet &across, unsigned acrossRegs);
+
+  /// Visits the ops of `block` backward. `live` holds the values live at the
+  /// end of the block on entry, and the ones live at its beginning on exit.
+  /// `across` holds the values live across the parent op of the block.
+  /// Returns the peak pressure in the block.
+  unsigned visitBlock(Block &block, ValueSet &live, const ValueSet &across,
+                      unsigned acrossRegs);
+
+  DenseMap<Operation *, unsigned> pressure;
+};
+
+} // namespace mlir
+
+#endif // TRITON_ANALYSIS_REGISTER_PRESSURE_H
@@ -0,0 +1,52 @@
+#ifndef TRITON_ANALYSIS_UNIFORMITY_H
+#define TRITON_ANALYSIS_UNIFORMITY_H
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Support/LLVM.h"
+#include "triton/Analysis/AxisInfo.h"
+#include "llvm/ADT/DenseSet.h"
+
+namespace mlir {
+
+//===----------------------------------------------------------------------===//
+// UniformityAnalysis
+//===----------------------------------------------------------------------===//
+
+/// Determines which values hold the same value in every lane of a program.
+///
+/// Scalars are uniform by construction. A tensor is uniform if all of its
+/// elements are equal: either AxisInfo proves it constant over its whole
+/// shape, or it is computed from uniform values by an operation that does not
+/// depend on the position of the element (splats, elementwise math,
+/// broadcasts, reductions, loads from a uniform address, ...). Lowering uses
+/// this to compute such values once per program and keep them in scalar
+/// registers instead of materializing a copy per element and per lane.
+///
+/// The analysis is optimistic: every value starts uniform and is demoted when
+/// one of its inputs is shown not to be, until a fixed point is reached. This
+/// lets loop-carried values stay uniform when both their initial value and
+/// the value yielded by the loop body are.
+class UniformityAnalysis {
+public:
+  UniformityAnalysis(ModuleOp moduleOp,
+                     ModuleAxisInfoAnalysis &axisInfoAnalysis);
+
+  /// Returns true if every element of `value` is the same across the program.
+  bool isUniform(Value value) const { return !nonUniform.contains(value); }
+
+private:
+  bool computeIsUniform(Value value) const;
+
+  bool computeIsUniform(BlockArgument arg) const;
+
+  bool computeIsUniform(OpResult result) const;
+
+  bool allUniform(ValueRange values) const;
+
+  ModuleAxisInfoAnalysis &axisInfoAnalysis;
+  DenseSet<Value> nonUniform;
+};
+
+} // namespace mlir
+
+#endif // TRITON_ANALYSIS_UNIFORMITY_H
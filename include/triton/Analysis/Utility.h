@@ -7,6 +7,7 @@
 #include "triton/Dialect/TritonGPU/IR/Dialect.h"
 #include <algorithm>
 #include <numeric>
+#include <optional>
 #include <string>
 
 namespace mlir {
@@ -116,6 +117,15 @@ bool maybeAliasOp(Operation *op);
 
 #ifdef USE_ROCM
 bool supportMFMA(triton::DotOp op);
+
+bool supportWMMA(triton::DotOp op);
+
+/// Returns true if copying a `srcTy` tile of pointers into the `dstTy` shared
+/// buffer, reading `vec` contiguous elements per access, can use direct
+/// global to LDS loads. Those copy one dword per lane, and lane i writes its
+/// dword at a wave-uniform address plus 4 * i.
+bool supportDirectToLDS(RankedTensorType srcTy, RankedTensorType dstTy,
+                        unsigned vec, int matrixCoreVersion);
 #endif
 
 bool supportMMA(triton::DotOp op, int version);
@@ -180,7 +190,52 @@ template <typename T> T nextPowOf2(T n) {
 }
 
 #ifdef USE_ROCM
+/// Register-only conversion of an MFMA accumulator to an MFMA dot operand.
+///
+/// Both layouts are made of chunks of 4 elements consecutive along K, and a
+/// lane holds the same row (A) or column (B) of every instruction in both of
+/// them. Lanes are split in groups of nonKDim lanes: for the destination
+/// chunk c, lane l of group h takes the source chunk srcChunks[c][h] of lane
+/// l + nonKDim * srcGroups[c][h] of the group it reads from.
+struct MfmaToDotShortcut {
+  unsigned nonKDim;
+  SmallVector<SmallVector<unsigned>> srcChunks;
+  SmallVector<SmallVector<unsigned>> srcGroups;
+
+  /// Number of chunks moved between lanes, one lane permutation each
+  unsigned getNumPermutedChunks() const;
+};
+
+std::optional<MfmaToDotShortcut>
+getMfmaToDotShortcut(RankedTensorType srcTy, RankedTensorType dstTy);
+
 bool isMfmaToDotShortcut(RankedTensorType &srcTy, RankedTensorType &dstTy);
+
+/// Vectorized stores of an MFMA accumulator along its columns.
+///
+/// A lane holds units of unitSize elements: chunks of 4 consecutive columns
+/// in transposed layouts, single elements of consecutive columns in lanes
+/// next to each other otherwise. Transposing blocks of numLanes units between
+/// numLanes lanes laneStride apart leaves every lane with vectors of
+/// numLanes * unitSize consecutive columns. blocks lists the index of the
+/// first element of each unit of a block; the lane at position b of its
+/// lanes stores the vector made of the units at position b of the block.
+struct MfmaStoreVectorization {
+  unsigned numLanes;
+  unsigned unitSize;
+  unsigned laneStride;
+  SmallVector<SmallVector<unsigned>> blocks;
+
+  unsigned getVectorSize() const { return numLanes * unitSize; }
+
+  /// Number of units moved between lanes, one lane permutation each
+  unsigned getNumPermutedUnits() const;
+};
+
+/// Returns how to store `type` with vectors of at most maxVec elements along
+/// its columns, or std::nullopt if its layout cannot give vectors.
+std::optional<MfmaStoreVectorization>
+getMfmaStoreVectorization(RankedTensorType type, unsigned maxVec);
 #endif
 
 /// Multi-root DAG topological sort.
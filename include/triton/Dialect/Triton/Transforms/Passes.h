@@ -13,6 +13,17 @@ std::unique_ptr<Pass>
 createRewriteTensorPointerPass(int computeCapability = 80,
                                        bool isROCM = false);
 
+std::unique_ptr<Pass> createHoistInvariantLoadsPass();
+
+std::unique_ptr<Pass> createSpecializeCallsPass(int maxClones = 4);
+
+std::unique_ptr<Pass> createStrengthReduceDivRemPass();
+
+std::unique_ptr<Pass> createNarrowIndicesPass();
+
+std::unique_ptr<Pass>
+createVersionMaskedAccessesPass(int maxVersionedOps = 256);
+
 } // namespace triton
 
 #define GEN_PASS_REGISTRATION
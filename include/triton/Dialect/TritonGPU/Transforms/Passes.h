@@ -11,16 +11,24 @@ std::unique_ptr<Pass> createTritonGPUPipelinePass(int numStages = 3,
                                                   int numCTAs = 1,
                                                   int computeCapability = 80);
 
-std::unique_ptr<Pass> createTritonGPUStreamPipelinePass();
+std::unique_ptr<Pass>
+createTritonGPUStreamPipelinePass(int numStages = 2, int wavesPerEU = 0,
+                                  int matrixCoreVersion = 0);
 
 std::unique_ptr<Pass>
 createTritonGPUAccelerateMatmulPass(int computeCapability = 80);
 
 std::unique_ptr<Pass>
 createTritonAMDGPUAccelerateMatmulPass(int matrixCoreVersion = 0,
-                                       int matrixInstructionSize = 0);
+                                       int matrixInstructionSize = 0,
+                                       int wavesPerEU = 0, int kPack = 1);
+
+std::unique_ptr<Pass> createTritonGPUPersistentTilesPass(int numPrograms = 0);
+
+std::unique_ptr<Pass> createTritonGPUPrefetchPass(int wavesPerEU = -1,
+                                                  int matrixCoreVersion = 0);
 
-std::unique_ptr<Pass> createTritonGPUPrefetchPass();
+std::unique_ptr<Pass> createTritonGPUAnnotateRegisterPressurePass();
 
 std::unique_ptr<Pass> createTritonGPUCanonicalizeLoopsPass();
 
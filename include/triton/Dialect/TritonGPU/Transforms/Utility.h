@@ -121,6 +121,32 @@ LogicalResult getConvertBackwardSlice(
     DenseMap<Value, Attribute> &layout,
     std::function<bool(Operation *)> stopPropagation = nullptr);
 
+// Estimated per-thread cost of a convert_layout.
+struct ConvertLayoutCost {
+  // Bytes written to and read back from shared memory.
+  int64_t sharedBytes = 0;
+  // Barriers guarding the shared memory round-trip.
+  int64_t numBarriers = 0;
+  // Cross-lane moves of conversions that stay in registers.
+  int64_t numShuffles = 0;
+  // Registers the destination layout needs on top of the source one.
+  int64_t regDuplication = 0;
+
+  // Cost in bytes of shared memory traffic equivalent.
+  int64_t total() const;
+};
+
+// Returns the estimated cost of converting `srcTy` to `dstEncoding`.
+ConvertLayoutCost getConvertLayoutCost(RankedTensorType srcTy,
+                                       Attribute dstEncoding);
+
+// Returns the number of 32-bit registers each thread needs to hold `type`.
+int64_t getNumRegsPerThread(RankedTensorType type);
+
+// Returns the estimated per-thread cost of computing `op` again with its
+// results in `encoding`, in the unit of ConvertLayoutCost::total().
+int64_t getRematerializationCost(Operation *op, Attribute encoding);
+
 // Populate pattern to remove dead cycles in ForOp.
 void populateForOpDeadArgumentElimination(RewritePatternSet &patterns);
 
@@ -29,7 +29,9 @@ std::unique_ptr<llvm::Module>
 translateTritonGPUToLLVMIR(llvm::LLVMContext *llvmContext,
                            mlir::ModuleOp module, int computeCapability,
                            mlir::triton::gpu::TMAMetadataTy &tmaInfos,
-                           Target target, int wavesPerEU);
+                           Target target, int wavesPerEU,
+                           int matrixCoreVersion = 0,
+                           const std::string &schedVariant = "none");
 
 // Translate mlir LLVM dialect to LLVMIR, return null if failed.
 std::unique_ptr<llvm::Module>
@@ -30,9 +30,12 @@
 namespace triton {
 
 const std::set<std::string> ENV_VARS = {
-    "ENABLE_MMA_V3",     "TRITON_DISABLE_LINE_INFO", "DISABLE_FAST_REDUCTION",
-    "ENABLE_TMA",        "MLIR_ENABLE_DUMP",         "LLVM_IR_ENABLE_DUMP",
-    "AMDGCN_ENABLE_DUMP"};
+    "ENABLE_MMA_V3",          "TRITON_DISABLE_LINE_INFO",
+    "DISABLE_FAST_REDUCTION", "DISABLE_UNIFORMITY_ANALYSIS",
+    "ENABLE_TMA",             "MLIR_ENABLE_DUMP",
+    "LLVM_IR_ENABLE_DUMP",    "AMDGCN_ENABLE_DUMP",
+    "AMDGCN_ENABLE_DIRECT_TO_LDS", "AMDGCN_VERSION_MASKED_ACCESSES",
+    "AMDGCN_ENABLE_PREFETCH"};
 
 namespace tools {
 
@@ -1,8 +1,10 @@
 #include "triton/Analysis/Alias.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "triton/Analysis/Utility.h"
 #include "triton/Dialect/TritonGPU/IR/Dialect.h"
 #include "triton/Dialect/TritonNvidiaGPU/IR/Dialect.h"
+#include "llvm/ADT/ScopeExit.h"
 
 namespace mlir {
 
@@ -68,4 +70,137 @@ ModRefResult SharedMemoryAliasAnalysis::getModRef(Operation *op,
   return ModRefResult::getModAndRef();
 }
 
+static Value getUnderlyingBaseImpl(Value ptr, DenseSet<Value> &inProgress) {
+  // A loop-carried pointer that refers back to itself: the caller decides
+  // whether the cycle preserves the base.
+  if (!inProgress.insert(ptr).second)
+    return ptr;
+  auto guard = llvm::make_scope_exit([&]() { inProgress.erase(ptr); });
+
+  if (auto arg = ptr.dyn_cast<BlockArgument>()) {
+    Operation *parentOp = arg.getOwner()->getParentOp();
+    if (isa<FunctionOpInterface>(parentOp) && arg.getOwner()->isEntryBlock())
+      return arg;
+    auto forOp = dyn_cast<scf::ForOp>(parentOp);
+    if (!forOp || arg.getArgNumber() < forOp.getNumInductionVars())
+      return {};
+    unsigned idx = arg.getArgNumber() - forOp.getNumInductionVars();
+    Value initBase = getUnderlyingBaseImpl(forOp.getInitArgs()[idx], inProgress);
+    if (!initBase)
+      return {};
+    Value yielded = forOp.getBody()->getTerminator()->getOperand(idx);
+    Value yieldedBase = getUnderlyingBaseImpl(yielded, inProgress);
+    if (yieldedBase == initBase || yieldedBase == arg)
+      return initBase;
+    return {};
+  }
+
+  Operation *defOp = ptr.getDefiningOp();
+  if (isa<triton::AddPtrOp, triton::SplatOp, triton::BroadcastOp,
+          triton::ExpandDimsOp, triton::ViewOp, triton::BitcastOp,
+          triton::AdvanceOp, triton::gpu::ConvertLayoutOp>(defOp))
+    return getUnderlyingBaseImpl(defOp->getOperand(0), inProgress);
+  if (auto makeTensorPtrOp = dyn_cast<triton::MakeTensorPtrOp>(defOp))
+    return getUnderlyingBaseImpl(makeTensorPtrOp.getBase(), inProgress);
+  if (auto forOp = dyn_cast<scf::ForOp>(defOp)) {
+    unsigned idx = ptr.cast<OpResult>().getResultNumber();
+    return getUnderlyingBaseImpl(forOp.getRegionIterArgs()[idx], inProgress);
+  }
+  // Both alternatives must share the same base.
+  SmallVector<Value, 2> alternatives;
+  if (auto selectOp = dyn_cast<arith::SelectOp>(defOp)) {
+    alternatives = {selectOp.getTrueValue(), selectOp.getFalseValue()};
+  } else if (auto selectOp = dyn_cast<triton::gpu::SelectOp>(defOp)) {
+    alternatives = {selectOp.getTrueValue(), selectOp.getFalseValue()};
+  } else if (auto ifOp = dyn_cast<scf::IfOp>(defOp)) {
+    if (!ifOp.elseBlock())
+      return {};
+    unsigned idx = ptr.cast<OpResult>().getResultNumber();
+    alternatives = {ifOp.thenYield().getOperand(idx),
+                    ifOp.elseYield().getOperand(idx)};
+  }
+  if (alternatives.empty())
+    return {};
+  Value base = getUnderlyingBaseImpl(alternatives[0], inProgress);
+  if (!base || getUnderlyingBaseImpl(alternatives[1], inProgress) != base)
+    return {};
+  return base;
+}
+
+Value GlobalMemoryAliasAnalysis::getUnderlyingBase(Value ptr) {
+  DenseSet<Value> inProgress;
+  Value base = getUnderlyingBaseImpl(ptr, inProgress);
+  // Only function arguments are meaningful bases.
+  if (auto arg = base.dyn_cast_or_null<BlockArgument>())
+    if (isa<FunctionOpInterface>(arg.getOwner()->getParentOp()))
+      return base;
+  return {};
+}
+
+static bool isNoAliasArg(Value base) {
+  auto arg = base.cast<BlockArgument>();
+  auto funcOp = cast<FunctionOpInterface>(arg.getOwner()->getParentOp());
+  return static_cast<bool>(
+      funcOp.getArgAttr(arg.getArgNumber(),
+                        GlobalMemoryAliasAnalysis::noAliasAttrName));
+}
+
+AliasResult GlobalMemoryAliasAnalysis::alias(Value lhs, Value rhs) {
+  Value lhsBase = getUnderlyingBase(lhs);
+  Value rhsBase = getUnderlyingBase(rhs);
+  if (!lhsBase || !rhsBase || lhsBase == rhsBase)
+    return AliasResult::MayAlias;
+  if (isNoAliasArg(lhsBase) || isNoAliasArg(rhsBase))
+    return AliasResult::NoAlias;
+  return AliasResult::MayAlias;
+}
+
+ModRefResult GlobalMemoryAliasAnalysis::getModRef(Operation *op,
+                                                  Value location) {
+  auto accessIf = [&](Value ptr, ModRefResult result) {
+    return alias(ptr, location) == AliasResult::NoAlias
+               ? ModRefResult::getNoModRef()
+               : result;
+  };
+  if (auto storeOp = dyn_cast<triton::StoreOp>(op))
+    return accessIf(storeOp.getPtr(), ModRefResult::getMod());
+  if (auto atomicOp = dyn_cast<triton::AtomicRMWOp>(op))
+    return accessIf(atomicOp.getPtr(), ModRefResult::getModAndRef());
+  if (auto atomicOp = dyn_cast<triton::AtomicCASOp>(op))
+    return accessIf(atomicOp.getPtr(), ModRefResult::getModAndRef());
+  if (auto loadOp = dyn_cast<triton::LoadOp>(op)) {
+    if (loadOp.getIsVolatile())
+      return ModRefResult::getModAndRef();
+    return accessIf(loadOp.getPtr(), ModRefResult::getRef());
+  }
+  // These only write shared memory, which global pointers never reach.
+  if (auto insertSliceOp = dyn_cast<triton::gpu::InsertSliceOp>(op))
+    return accessIf(insertSliceOp.getSrc(), ModRefResult::getRef());
+  if (auto insertSliceOp = dyn_cast<triton::gpu::InsertSliceAsyncOp>(op))
+    return accessIf(insertSliceOp.getSrc(), ModRefResult::getRef());
+  if (isa<triton::gpu::AllocTensorOp, triton::gpu::ExtractSliceOp,
+          tensor::InsertSliceOp, tensor::ExtractSliceOp>(op))
+    return ModRefResult::getNoModRef();
+
+  ModRefResult result = ModRefResult::getNoModRef();
+  if (op->hasTrait<OpTrait::HasRecursiveMemoryEffects>()) {
+    for (Region &region : op->getRegions())
+      for (Operation &nestedOp : region.getOps())
+        result = result.merge(getModRef(&nestedOp, location));
+    return result;
+  }
+  auto memInterface = dyn_cast<MemoryEffectOpInterface>(op);
+  if (!memInterface)
+    return ModRefResult::getModAndRef();
+  SmallVector<MemoryEffects::EffectInstance> effects;
+  memInterface.getEffects(effects);
+  for (auto &effect : effects) {
+    if (isa<MemoryEffects::Write>(effect.getEffect()))
+      result = result.merge(ModRefResult::getMod());
+    else if (isa<MemoryEffects::Read>(effect.getEffect()))
+      result = result.merge(ModRefResult::getRef());
+  }
+  return result;
+}
+
 } // namespace mlir
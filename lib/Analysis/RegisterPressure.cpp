@@ -0,0 +1,145 @@
+#include "triton/Analysis/RegisterPressure.h"
+#include "mlir/Interfaces/LoopLikeInterface.h"
+#include "triton/Dialect/TritonGPU/IR/Dialect.h"
+
+namespace mlir {
+
+namespace {
+
+// Collects the values defined above `op` and used in its regions.
+void collectUsedAbove(Operation *op, DenseSet<Value> &values) {
+  op->walk([&](Operation *nested) {
+    if (nested == op)
+      return;
+    for (Value operand : nested->getOperands())
+      if (!op->isAncestor(operand.getParentRegion()->getParentOp()))
+        values.insert(operand);
+  });
+}
+
+} // namespace
+
+RegisterPressureAnalysis::RegisterPressureAnalysis(Operation *root) {
+  ValueSet across;
+  for (Region &region : root->getRegions()) {
+    ValueSet usedAbove;
+    visitRegion(region, usedAbove, across, 0);
+  }
+}
+
+unsigned RegisterPressureAnalysis::getNumRegs(Type type) {
+  auto tensorTy = type.dyn_cast<RankedTensorType>();
+  if (!tensorTy || !tensorTy.getEncoding() ||
+      tensorTy.getEncoding().isa<triton::gpu::SharedEncodingAttr>())
+    return 0;
+  Type eltTy = tensorTy.getElementType();
+  unsigned bitWidth = eltTy.isIntOrFloat() ? eltTy.getIntOrFloatBitWidth() : 64;
+  return llvm::divideCeil(
+      triton::gpu::getTotalElemsPerThread(tensorTy) * bitWidth, 32);
+}
+
+unsigned RegisterPressureAnalysis::getRegisterBudget(int wavesPerEU,
+                                                     int matrixCoreVersion) {
+  // Each lane of a SIMD has 512 registers (VGPRs and AGPRs), shared by the
+  // waves resident on it and allocated in granules of 8. gfx908 has 256
+  // VGPRs, allocated in granules of 4, next to a separate file of 256 AGPRs
+  // that values other than MFMA operands and results cannot use.
+  bool splitFiles = matrixCoreVersion == 1;
+  unsigned numRegsPerSIMD = splitFiles ? 256 : 512;
+  unsigned granule = splitFiles ? 4 : 8;
+  if (wavesPerEU <= 1)
+    return numRegsPerSIMD;
+  return numRegsPerSIMD / wavesPerEU / granule * granule;
+}
+
+unsigned RegisterPressureAnalysis::visitRegion(Region &region,
+                                               ValueSet &usedAbove,
+                                               const ValueSet &across,
+                                               unsigned acrossRegs) {
+  // Blocks are visited in reverse order, which gives exact live-outs for
+  // acyclic CFGs. Structured control flow is handled by visitBlock.
+  DenseMap<Block *, ValueSet> liveIns;
+  unsigned peak = 0;
+  for (Block &block : llvm::reverse(region)) {
+    ValueSet live;
+    for (Block *succ : block.getSuccessors()) {
+      auto it = liveIns.find(succ);
+      if (it != liveIns.end())
+        live.insert(it->second.begin(), it->second.end());
+    }
+    peak = std::max(peak, visitBlock(block, live, across, acrossRegs));
+    liveIns[&block] = std::move(live);
+  }
+  for (auto &[block, live] : liveIns)
+    for (Value value : live)
+      if (value.getParentRegion() != &region)
+        usedAbove.insert(value);
+  return peak;
+}
+
+unsigned RegisterPressureAnalysis::visitBlock(Block &block, ValueSet &live,
+                                              const ValueSet &across,
+                                              unsigned acrossRegs) {
+  // Registers of the values in `live` that are not already in `across`
+  unsigned liveRegs = 0;
+  auto insertLive = [&](Value value) {
+    if (live.insert(value).second && !across.contains(value))
+      liveRegs += getNumRegs(value.getType());
+  };
+  auto eraseLive = [&](Value value) {
+    if (live.erase(value) && !across.contains(value))
+      liveRegs -= getNumRegs(value.getType());
+  };
+  for (Value value : live)
+    if (!across.contains(value))
+      liveRegs += getNumRegs(value.getType());
+
+  unsigned peak = 0;
+  for (Operation &op : llvm::reverse(block)) {
+    // Results take registers when the op executes, even if they are unused
+    unsigned resultRegs = 0;
+    for (Value result : op.getResults()) {
+      eraseLive(result);
+      resultRegs += getNumRegs(result.getType());
+    }
+
+    unsigned opPressure = 0;
+    if (op.getNumRegions() != 0) {
+      // Values live after the op are live in all of its regions. The values
+      // a loop uses from above are live in all of its iterations as well.
+      ValueSet nestedAcross(across);
+      unsigned nestedAcrossRegs = acrossRegs;
+      auto insertAcross = [&](Value value) {
+        if (nestedAcross.insert(value).second)
+          nestedAcrossRegs += getNumRegs(value.getType());
+      };
+      for (Value value : live)
+        insertAcross(value);
+      if (isa<LoopLikeOpInterface>(op)) {
+        ValueSet loopInvariants;
+        collectUsedAbove(&op, loopInvariants);
+        for (Value value : loopInvariants)
+          insertAcross(value);
+      }
+      ValueSet usedAbove;
+      for (Region &region : op.getRegions())
+        opPressure = std::max(opPressure, visitRegion(region, usedAbove,
+                                                      nestedAcross,
+                                                      nestedAcrossRegs));
+      for (Value value : usedAbove)
+        insertLive(value);
+    }
+
+    for (Value operand : op.getOperands())
+      insertLive(operand);
+    opPressure = std::max(opPressure, acrossRegs + liveRegs + resultRegs);
+    pressure[&op] = opPressure;
+    peak = std::max(peak, opPressure);
+  }
+
+  for (BlockArgument arg : block.getArguments())
+    eraseLive(arg);
+  return peak;
+}
+
+} // namespace mlir
@@ -0,0 +1,128 @@
+#include "triton/Analysis/Uniformity.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Interfaces/ControlFlowInterfaces.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "triton/Dialect/Triton/IR/Dialect.h"
+#include "triton/Dialect/TritonGPU/IR/Dialect.h"
+
+namespace mlir {
+
+namespace {
+
+// Returns true if AxisInfo proves that all elements of `value` are equal.
+bool isConstantTensor(ModuleAxisInfoAnalysis &axisInfoAnalysis, Value value) {
+  auto tensorTy = value.getType().cast<RankedTensorType>();
+  AxisInfo *axisInfo = axisInfoAnalysis.getAxisInfo(value);
+  if (!axisInfo || axisInfo->getRank() != tensorTy.getRank())
+    return false;
+  for (int d = 0; d < tensorTy.getRank(); ++d)
+    if (axisInfo->getConstancy(d) < tensorTy.getDimSize(d))
+      return false;
+  return true;
+}
+
+// Returns true if `op` produces uniform results from uniform operands. This
+// excludes ops whose results depend on the position of an element
+// (make_range, scan, cat, ...) and ops that may read lane-dependent state
+// (inline assembly, memory accesses other than tt.load).
+bool preservesUniformity(Operation *op) {
+  if (isa<triton::ElementwiseInlineAsmOp>(op))
+    return false;
+  if (op->hasTrait<OpTrait::Elementwise>())
+    return isMemoryEffectFree(op);
+  return isa<triton::SplatOp, triton::BroadcastOp, triton::ExpandDimsOp,
+             triton::ViewOp, triton::TransOp, triton::ReduceOp,
+             triton::gpu::ConvertLayoutOp>(op);
+}
+
+} // namespace
+
+UniformityAnalysis::UniformityAnalysis(ModuleOp moduleOp,
+                                       ModuleAxisInfoAnalysis &axisInfoAnalysis)
+    : axisInfoAnalysis(axisInfoAnalysis) {
+  bool changed = true;
+  auto update = [&](Value value) {
+    if (nonUniform.contains(value) || computeIsUniform(value))
+      return;
+    nonUniform.insert(value);
+    changed = true;
+  };
+  while (changed) {
+    changed = false;
+    moduleOp.walk<WalkOrder::PreOrder>([&](Operation *op) {
+      for (Region &region : op->getRegions())
+        for (Block &block : region)
+          for (BlockArgument arg : block.getArguments())
+            update(arg);
+      for (Value result : op->getResults())
+        update(result);
+    });
+  }
+}
+
+bool UniformityAnalysis::allUniform(ValueRange values) const {
+  return llvm::all_of(values, [&](Value value) { return isUniform(value); });
+}
+
+bool UniformityAnalysis::computeIsUniform(Value value) const {
+  // Triton programs have no per-lane scalars.
+  if (!value.getType().isa<RankedTensorType>())
+    return true;
+  if (isConstantTensor(axisInfoAnalysis, value))
+    return true;
+  if (auto arg = value.dyn_cast<BlockArgument>())
+    return computeIsUniform(arg);
+  return computeIsUniform(value.cast<OpResult>());
+}
+
+bool UniformityAnalysis::computeIsUniform(BlockArgument arg) const {
+  Block *block = arg.getOwner();
+  unsigned argNo = arg.getArgNumber();
+  if (block->isEntryBlock()) {
+    auto forOp = dyn_cast<scf::ForOp>(block->getParentOp());
+    if (!forOp || argNo < forOp.getNumInductionVars())
+      return false;
+    unsigned iterNo = argNo - forOp.getNumInductionVars();
+    Operation *yieldOp = forOp.getBody()->getTerminator();
+    return isUniform(forOp.getIterOperands()[iterNo]) &&
+           isUniform(yieldOp->getOperand(iterNo));
+  }
+  // Control flow in a Triton program is uniform, so a block argument is
+  // uniform if every value flowing into it is.
+  for (auto it = block->pred_begin(); it != block->pred_end(); ++it) {
+    auto branchOp = dyn_cast<BranchOpInterface>((*it)->getTerminator());
+    if (!branchOp)
+      return false;
+    SuccessorOperands operands =
+        branchOp.getSuccessorOperands(it.getSuccessorIndex());
+    if (operands.isOperandProduced(argNo) || !isUniform(operands[argNo]))
+      return false;
+  }
+  return true;
+}
+
+bool UniformityAnalysis::computeIsUniform(OpResult result) const {
+  Operation *op = result.getOwner();
+  unsigned resultNo = result.getResultNumber();
+  if (auto constantOp = dyn_cast<arith::ConstantOp>(op))
+    return constantOp.getValue().isa<SplatElementsAttr>();
+  if (auto loadOp = dyn_cast<triton::LoadOp>(op))
+    return !loadOp.getIsVolatile() && allUniform(op->getOperands());
+  if (auto forOp = dyn_cast<scf::ForOp>(op)) {
+    Operation *yieldOp = forOp.getBody()->getTerminator();
+    return isUniform(forOp.getIterOperands()[resultNo]) &&
+           isUniform(yieldOp->getOperand(resultNo));
+  }
+  if (auto ifOp = dyn_cast<scf::IfOp>(op)) {
+    if (!ifOp.elseBlock())
+      return false;
+    return isUniform(ifOp.thenYield().getOperand(resultNo)) &&
+           isUniform(ifOp.elseYield().getOperand(resultNo));
+  }
+  if (preservesUniformity(op))
+    return allUniform(op->getOperands());
+  return false;
+}
+
+} // namespace mlir
@@ -37,6 +37,10 @@ bool ReduceOpHelper::isFastReduction() {
   // Disable fast reduction only for debugging purpose
   if (::triton::tools::getBoolEnv("DISABLE_FAST_REDUCTION"))
     return false;
+  // MFMA layouts hold each row and each column in a known set of lanes, so
+  // shuffles reduce along either axis.
+  if (getSrcLayout().isa<triton::gpu::MfmaEncodingAttr>())
+    return true;
   return getParentAxis(getSrcLayout(), axis) ==
          getParentOrder(getSrcLayout())[0];
 }
@@ -192,6 +196,9 @@ bool ReduceOpHelper::isSupportedLayout() {
   if (auto mfmaLayout = srcLayout.dyn_cast<triton::gpu::MfmaEncodingAttr>()) {
     return true;
   }
+  if (srcLayout.isa<triton::gpu::WmmaEncodingAttr>()) {
+    return true;
+  }
   if (auto sliceLayout = srcLayout.dyn_cast<triton::gpu::SliceEncodingAttr>()) {
     return true;
   }
@@ -389,6 +396,10 @@ static bool supportMFMAGranularity(int m, int n, int k) {
       continue;
     return true;
   }
+  // 4x4 instructions compute a 64x4 or 4x64 tile of the result
+  if (k % 4 == 0 && ((m % 4 == 0 && n % 64 == 0) ||
+                     (m % 64 == 0 && n % 4 == 0)))
+    return true;
   return false;
 }
 
@@ -439,6 +450,59 @@ bool supportMFMA(triton::DotOp op) {
 
   return true;
 }
+
+bool supportWMMA(triton::DotOp op) {
+  auto aTy = op.getA().getType().cast<RankedTensorType>();
+  auto bTy = op.getB().getType().cast<RankedTensorType>();
+
+  auto aElemTy = aTy.getElementType();
+  auto bElemTy = bTy.getElementType();
+  if (aElemTy != bElemTy)
+    return false;
+  if (!aElemTy.isF16() && !aElemTy.isBF16() && !aElemTy.isInteger(8))
+    return false;
+  // Only the f32 and i32 accumulators are supported
+  auto dElemTy = op.getD().getType().cast<RankedTensorType>().getElementType();
+  if (!dElemTy.isF32() && !dElemTy.isInteger(32))
+    return false;
+
+  // All WMMA instructions are 16x16x16
+  auto aShape = aTy.getShape();
+  auto bShape = bTy.getShape();
+  assert(aShape[1] == bShape[0]);
+  return aShape[0] % 16 == 0 && bShape[1] % 16 == 0 && aShape[1] % 16 == 0;
+}
+
+bool supportDirectToLDS(RankedTensorType srcTy, RankedTensorType dstTy,
+                        unsigned vec, int matrixCoreVersion) {
+  // global_load_lds_dword is available on CDNA 2 and 3, not on RDNA 3.
+  if (matrixCoreVersion < 2 || matrixCoreVersion > 3)
+    return false;
+  auto srcLayout = srcTy.getEncoding().dyn_cast<triton::gpu::BlockedEncodingAttr>();
+  auto dstLayout = dstTy.getEncoding().dyn_cast<triton::gpu::SharedEncodingAttr>();
+  if (!srcLayout || !dstLayout || srcTy.getRank() != 2)
+    return false;
+  // Lanes write consecutive dwords, so the shared buffer must be laid out
+  // row by row without swizzling or padding.
+  auto order = srcLayout.getOrder();
+  if (dstLayout.getMaxPhase() != 1 || dstLayout.getOrder() != order)
+    return false;
+  unsigned bitWidth = dstTy.getElementTypeBitWidth();
+  auto sizePerThread = srcLayout.getSizePerThread();
+  auto threadsPerWarp = srcLayout.getThreadsPerWarp();
+  auto shape = srcTy.getShape();
+  unsigned inner = order[0], outer = order[1];
+  // Each lane holds exactly one dword of each row it covers.
+  if (sizePerThread[inner] * bitWidth != 32 || vec < sizePerThread[inner] ||
+      sizePerThread[outer] != 1)
+    return false;
+  // Lanes must not hold the same elements, and a row handled by several
+  // lanes must be continued by the next lane at the next row.
+  unsigned rowWidth = threadsPerWarp[inner] * sizePerThread[inner];
+  if (shape[inner] % rowWidth != 0 || shape[outer] % threadsPerWarp[outer] != 0)
+    return false;
+  return threadsPerWarp[outer] == 1 || shape[inner] == rowWidth;
+}
 #endif
 
 bool supportMMA(Value value, int version) {
@@ -463,9 +527,10 @@ bool isMmaToDotShortcut(RankedTensorType &srcTy, RankedTensorType &dstTy) {
   // when #mma = MmaEncoding<version=2, warpsPerCTA=[..., 1]>
   auto srcLayout = srcTy.getEncoding();
   auto dstLayout = dstTy.getEncoding();
-  auto mmaLayout = srcLayout.cast<triton::gpu::MmaEncodingAttr>();
-  auto dotOperandLayout = dstLayout.cast<triton::gpu::DotOperandEncodingAttr>();
-  return mmaLayout.getVersionMajor() == 2 &&
+  auto mmaLayout = srcLayout.dyn_cast<triton::gpu::MmaEncodingAttr>();
+  auto dotOperandLayout =
+      dstLayout.dyn_cast<triton::gpu::DotOperandEncodingAttr>();
+  return mmaLayout && dotOperandLayout && mmaLayout.getVersionMajor() == 2 &&
          mmaLayout.getWarpsPerCTA()[1] == 1 &&
          dotOperandLayout.getOpIdx() == 0 &&
          dotOperandLayout.getParent() == mmaLayout &&
@@ -473,20 +538,173 @@ bool isMmaToDotShortcut(RankedTensorType &srcTy, RankedTensorType &dstTy) {
 }
 
 #ifdef USE_ROCM
+unsigned MfmaToDotShortcut::getNumPermutedChunks() const {
+  unsigned numPermuted = 0;
+  for (auto [chunks, groups] : llvm::zip(srcChunks, srcGroups)) {
+    SmallVector<unsigned> permuted;
+    for (unsigned h = 0; h < chunks.size(); ++h)
+      if (groups[h] != h && !llvm::is_contained(permuted, chunks[h]))
+        permuted.push_back(chunks[h]);
+    numPermuted += permuted.size();
+  }
+  return numPermuted;
+}
+
+std::optional<MfmaToDotShortcut>
+getMfmaToDotShortcut(RankedTensorType srcTy, RankedTensorType dstTy) {
+  auto mfmaLayout =
+      srcTy.getEncoding().dyn_cast<triton::gpu::MfmaEncodingAttr>();
+  auto dotOperandLayout =
+      dstTy.getEncoding().dyn_cast<triton::gpu::DotOperandEncodingAttr>();
+  if (!mfmaLayout || !dotOperandLayout)
+    return std::nullopt;
+  auto parent =
+      dotOperandLayout.getParent().dyn_cast<triton::gpu::MfmaEncodingAttr>();
+  if (!parent)
+    return std::nullopt;
+
+  // Lane l of the accumulator holds row l % nonKDim of the instructions when
+  // the layout is transposed, and column l % nonKDim otherwise, like the
+  // lanes of operand A and B respectively. The elements of 4x4 instructions
+  // are laid out differently.
+  unsigned nonKDim = mfmaLayout.getNonKDim();
+  int opIdx = dotOperandLayout.getOpIdx();
+  if (nonKDim == 4 || parent.getNonKDim() != nonKDim ||
+      mfmaLayout.getIsTransposed() != (opIdx == 0) ||
+      parent.getWarpsPerCTA() != mfmaLayout.getWarpsPerCTA())
+    return std::nullopt;
+  unsigned kWidth = dotOperandLayout.getKWidth();
+  if (kWidth % 4 != 0)
+    return std::nullopt;
+
+  int kDimIdx = opIdx == 0 ? 1 : 0;
+  int nonKDimIdx = 1 - kDimIdx;
+  auto shape = srcTy.getShape();
+  auto warpsPerCTA = mfmaLayout.getWarpsPerCTA();
+  unsigned warpSize = triton::gpu::getWarpSize(mfmaLayout);
+  unsigned numGroups = warpSize / nonKDim;
+  int64_t kTile = kWidth * numGroups;
+  if (shape[nonKDimIdx] % nonKDim != 0 || shape[kDimIdx] % kTile != 0 ||
+      shape[kDimIdx] % nonKDim != 0)
+    return std::nullopt;
+  // Every wave needs the whole K extent of its rows or columns, so K must not
+  // be split between waves
+  if (warpsPerCTA[kDimIdx] > 1 && shape[kDimIdx] > nonKDim)
+    return std::nullopt;
+  // Both layouts must distribute the instructions along the non-K axis the
+  // same way between the waves
+  int64_t numRepNonK = dotOperandLayout.getMFMARep(
+      shape, srcTy.getElementType())[nonKDimIdx];
+  if (numRepNonK != ceil<int64_t>(ceil<int64_t>(shape[nonKDimIdx],
+                                                warpsPerCTA[nonKDimIdx]),
+                                  nonKDim))
+    return std::nullopt;
+  int64_t numRepK = shape[kDimIdx] / kTile;
+  int64_t srcRepK = shape[kDimIdx] / nonKDim;
+
+  // The accumulator of an instruction holds chunks of 4 elements along K.
+  // Lane group h holds chunk g at (4 * numGroups) * g + 4 * h; the chunks of
+  // the instructions are ordered by row of instructions, then by column.
+  unsigned chunksPerInstr = nonKDim * nonKDim / (4 * warpSize);
+  MfmaToDotShortcut shortcut;
+  shortcut.nonKDim = nonKDim;
+  for (int64_t nonK = 0; nonK < numRepNonK; ++nonK)
+    for (int64_t k = 0; k < numRepK; ++k)
+      for (unsigned elem = 0; elem < kWidth; elem += 4) {
+        SmallVector<unsigned> chunks, groups;
+        for (unsigned h = 0; h < numGroups; ++h) {
+          int64_t kIdx = k * kTile + h * kWidth + elem;
+          int64_t instrK = kIdx / nonKDim;
+          unsigned inInstr = kIdx % nonKDim;
+          int64_t instr = opIdx == 0 ? nonK * srcRepK + instrK
+                                     : instrK * numRepNonK + nonK;
+          chunks.push_back(instr * chunksPerInstr +
+                           inInstr / (4 * numGroups));
+          groups.push_back(inInstr % (4 * numGroups) / 4);
+        }
+        shortcut.srcChunks.push_back(chunks);
+        shortcut.srcGroups.push_back(groups);
+      }
+  return shortcut;
+}
+
 bool isMfmaToDotShortcut(RankedTensorType &srcTy, RankedTensorType &dstTy) {
-  auto srcLayout = srcTy.getEncoding();
-  auto dstLayout = dstTy.getEncoding();
-  auto mfmaLayout = srcLayout.cast<triton::gpu::MfmaEncodingAttr>();
-  auto dotOperandLayout = dstLayout.cast<triton::gpu::DotOperandEncodingAttr>();
-  // TODO: Remove the restriction on the warpsPerCTA once chain dot testing is
-  // improved. In addition, we can enable this shortcut for regular MFMA
-  // layout when opIdx == 1.
-  return mfmaLayout.getWarpsPerCTA()[1] == 1 &&
-         dotOperandLayout.getOpIdx() == 0 &&
-         dotOperandLayout.getKWidth() == 4 &&
-         dotOperandLayout.getParent() == mfmaLayout &&
-         mfmaLayout.getNonKDim() == 32 && mfmaLayout.getIsTransposed() &&
-         (srcTy.getElementType().isF16() || srcTy.getElementType().isBF16());
+  return getMfmaToDotShortcut(srcTy, dstTy).has_value();
+}
+
+unsigned MfmaStoreVectorization::getNumPermutedUnits() const {
+  // Every step of the transposition exchanges half of the units of a block
+  return blocks.size() * llvm::Log2_32(numLanes) * numLanes / 2;
+}
+
+std::optional<MfmaStoreVectorization>
+getMfmaStoreVectorization(RankedTensorType type, unsigned maxVec) {
+  auto mfmaLayout =
+      type.getEncoding().dyn_cast<triton::gpu::MfmaEncodingAttr>();
+  if (!mfmaLayout || mfmaLayout.getNonKDim() == 4)
+    return std::nullopt;
+  unsigned nonKDim = mfmaLayout.getNonKDim();
+  unsigned numLaneGroups = triton::gpu::getWarpSize(mfmaLayout) / nonKDim;
+  auto shape = type.getShape();
+  auto warpsPerCTA = mfmaLayout.getWarpsPerCTA();
+  // Tensors smaller than the tile of the CTA hold copies of their elements
+  SmallVector<int64_t> numReps(2);
+  for (unsigned d = 0; d < 2; ++d) {
+    if (shape[d] % (nonKDim * warpsPerCTA[d]) != 0)
+      return std::nullopt;
+    numReps[d] = shape[d] / (nonKDim * warpsPerCTA[d]);
+  }
+
+  // The elements of a lane are ordered by instruction, then by chunk of 4
+  // consecutive rows or columns, 4 * numLaneGroups apart.
+  unsigned chunksPerInstr = nonKDim / (4 * numLaneGroups);
+  unsigned elemsPerInstr = 4 * chunksPerInstr;
+  MfmaStoreVectorization vectorization;
+  if (mfmaLayout.getIsTransposed()) {
+    // Lane group h holds the columns at 4 * h of every chunk: lane groups
+    // next to each other complete each other's chunks.
+    if (maxVec < 4)
+      return std::nullopt;
+    int64_t chunksPerRow = numReps[1] * chunksPerInstr;
+    unsigned numLanes = 1;
+    while (8 * numLanes <= maxVec && 2 * numLanes <= numLaneGroups &&
+           chunksPerRow % (2 * numLanes) == 0)
+      numLanes *= 2;
+    vectorization.numLanes = numLanes;
+    vectorization.unitSize = 4;
+    vectorization.laneStride = nonKDim;
+    int64_t numChunks = numReps[0] * chunksPerRow;
+    for (int64_t chunk = 0; chunk < numChunks; chunk += numLanes) {
+      SmallVector<unsigned> block;
+      for (unsigned b = 0; b < numLanes; ++b)
+        block.push_back((chunk + b) * 4);
+      vectorization.blocks.push_back(block);
+    }
+    return vectorization;
+  }
+
+  // Lanes next to each other hold columns next to each other: transpose the
+  // elements of a column with the ones of the neighbouring lanes.
+  int64_t elemsPerCol = numReps[0] * elemsPerInstr;
+  unsigned numLanes = 1;
+  while (2 * numLanes <= maxVec && 2 * numLanes <= nonKDim &&
+         elemsPerCol % (2 * numLanes) == 0)
+    numLanes *= 2;
+  if (numLanes == 1)
+    return std::nullopt;
+  vectorization.numLanes = numLanes;
+  vectorization.unitSize = 1;
+  vectorization.laneStride = 1;
+  for (int64_t n = 0; n < numReps[1]; ++n) {
+    SmallVector<unsigned> colElems;
+    for (int64_t m = 0; m < numReps[0]; ++m)
+      for (unsigned elem = 0; elem < elemsPerInstr; ++elem)
+        colElems.push_back((m * numReps[1] + n) * elemsPerInstr + elem);
+    for (unsigned i = 0; i < colElems.size(); i += numLanes)
+      vectorization.blocks.emplace_back(colElems.begin() + i,
+                                        colElems.begin() + i + numLanes);
+  }
+  return vectorization;
 }
 #endif
 
@@ -7,6 +7,7 @@
 using ::mlir::LLVM::getSharedMemoryObjectFromStruct;
 using ::mlir::LLVM::getStridesFromShapeAndOrder;
 using ::mlir::LLVM::linearize;
+using ::mlir::LLVM::permuteLanes;
 
 using ::mlir::LLVM::getSharedMemoryObjectFromStruct;
 using ::mlir::LLVM::getStridesFromShapeAndOrder;
@@ -56,6 +57,14 @@ Value convertLayout(int opIdx, ConversionPatternRewriter &rewriter,
                     const SharedMemoryObject &smemObj,
                     TritonGPUToLLVMTypeConverter *typeConverter, Value thread);
 } // namespace SharedToDotOperandMFMA
+
+namespace SharedToDotOperandWMMA {
+Value convertLayout(int opIdx, ConversionPatternRewriter &rewriter,
+                    Location loc, Value tensor,
+                    DotOperandEncodingAttr encoding,
+                    const SharedMemoryObject &smemObj,
+                    TritonGPUToLLVMTypeConverter *typeConverter, Value thread);
+} // namespace SharedToDotOperandWMMA
 #endif
 
 namespace SharedToDotOperandFMA {
@@ -263,6 +272,18 @@ private:
       multiDimOffset[1] = add(multiDimBase[1], i32_val(offsets[elemId][1]));
       return multiDimOffset;
     }
+    if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+      auto multiDimBase =
+          emitBaseIndexForLayout(loc, rewriter, layout, type, false);
+      SmallVector<SmallVector<unsigned>> offsets;
+      assert(rank == 2);
+      SmallVector<Value> multiDimOffset(rank);
+      emitWmmaOffsetForCTA(wmmaLayout, offsets, multiDimCTAInRepId[0],
+                           multiDimCTAInRepId[1]);
+      multiDimOffset[0] = add(multiDimBase[0], i32_val(offsets[elemId][0]));
+      multiDimOffset[1] = add(multiDimBase[1], i32_val(offsets[elemId][1]));
+      return multiDimOffset;
+    }
 #endif
     llvm_unreachable("unexpected layout in getMultiDimOffset");
   }
@@ -642,6 +663,7 @@ private:
           srcLayout.isa<SliceEncodingAttr>() ||
 #ifdef USE_ROCM
           srcLayout.isa<MfmaEncodingAttr>() ||
+          srcLayout.isa<WmmaEncodingAttr>() ||
 #endif
           srcLayout.isa<MmaEncodingAttr>()) {
         if (isSrcMmaV1)
@@ -678,6 +700,7 @@ private:
           dstLayout.isa<SliceEncodingAttr>() ||
 #ifdef USE_ROCM
           dstLayout.isa<MfmaEncodingAttr>() ||
+          dstLayout.isa<WmmaEncodingAttr>() ||
 #endif
           dstLayout.isa<MmaEncodingAttr>()) {
         if (isDstMmaV1)
@@ -891,6 +914,14 @@ private:
                                      .dyn_cast_or_null<MfmaEncodingAttr>()) {
       res = lowerSharedToDotOperandMFMA(op, adaptor, rewriter, mfmaLayout,
                                         dotOperandLayout, isOuter);
+    } else if (dotOperandLayout.getParent()
+                   .dyn_cast_or_null<WmmaEncodingAttr>()) {
+      assert(!isOuter && "unsupported layout found");
+      auto smemObj =
+          getSharedMemoryObjectFromStruct(loc, adaptor.getSrc(), rewriter);
+      res = SharedToDotOperandWMMA::convertLayout(
+          dotOperandLayout.getOpIdx(), rewriter, loc, src, dotOperandLayout,
+          smemObj, getTypeConverter(), tid_val());
 #endif
     } else if (auto blockedLayout =
                    dotOperandLayout.getParent()
@@ -916,42 +947,86 @@ private:
     auto loc = op.getLoc();
     auto srcTy = op.getSrc().getType().cast<RankedTensorType>();
     auto dstTy = op.getResult().getType().cast<RankedTensorType>();
-    if (isMfmaToDotShortcut(srcTy, dstTy)) {
-      // get source values
-      auto vals = getTypeConverter()->unpackLLElements(loc, adaptor.getSrc(),
-                                                       rewriter, srcTy);
-      unsigned elems = getTotalElemsPerThread(srcTy);
-      Type elemTy =
-          this->getTypeConverter()->convertType(srcTy.getElementType());
-      // for the destination type, we need to pack values together
-      // so they can be consumed by tensor core operations
-      SmallVector<Value> vecVals;
-      SmallVector<Type> types;
-      auto elemSize = elemTy.getIntOrFloatBitWidth();
-      // TODO: Support types other than float16 and
-      // bf16 (represented as int16 in llvm ir).
-      assert((type::isFloat(elemTy) || type::isInt(elemTy)) && elemSize == 16);
-      // vecSize is an number of sequential elements stored by one thread
-      // - For MFMA (nonKDim == 32) encoding it is 4
-      // - For MFMA (nonKDim == 32) operand encoding it is dotOperandEndocing::kWidth,
-      //   which is 4 for fp16 and bfloat16 dtypes
-      //
-      // For mentioned types MFMA and MFMA operand layouts are the same
-      const unsigned vecSize = 4;
-      Type vecTy = vec_ty(elemTy, vecSize);
-      types = SmallVector<Type>(elems / vecSize, vecTy);
-      for (unsigned i = 0; i < elems; i += vecSize) {
-        Value packed = rewriter.create<LLVM::UndefOp>(loc, vecTy);
-        for (unsigned j = 0; j < vecSize; j++)
-          packed = insert_element(vecTy, packed, vals[i + j], i32_val(j));
-        vecVals.push_back(packed);
+    auto shortcut = getMfmaToDotShortcut(srcTy, dstTy);
+    if (!shortcut)
+      return failure();
+    auto vals = getTypeConverter()->unpackLLElements(loc, adaptor.getSrc(),
+                                                     rewriter, srcTy);
+    Type elemTy = getTypeConverter()->convertType(srcTy.getElementType());
+
+    // Both layouts are made of chunks of 4 elements consecutive along K
+    const unsigned chunkSize = 4;
+    Type chunkTy = vec_ty(elemTy, chunkSize);
+    SmallVector<Value> srcChunks;
+    for (unsigned i = 0; i < vals.size(); i += chunkSize) {
+      Value chunk = undef(chunkTy);
+      for (unsigned j = 0; j < chunkSize; ++j)
+        chunk = insert_element(chunkTy, chunk, vals[i + j], i32_val(j));
+      srcChunks.push_back(chunk);
+    }
+
+    unsigned nonKDim = shortcut->nonKDim;
+    unsigned numGroups = triton::gpu::getWarpSize(srcTy.getEncoding()) /
+                         nonKDim;
+    Value lane = urem(getThreadId(rewriter, loc),
+                      i32_val(nonKDim * numGroups));
+    Value laneInGroup = urem(lane, i32_val(nonKDim));
+    Value group = udiv(lane, i32_val(nonKDim));
+    SmallVector<Value> isGroup;
+    for (unsigned h = 0; h < numGroups; ++h)
+      isGroup.push_back(icmp_eq(group, i32_val(h)));
+
+    SmallVector<Value> dstChunks;
+    for (auto [chunks, groups] :
+         llvm::zip(shortcut->srcChunks, shortcut->srcGroups)) {
+      // Read every source chunk once, from the lane each group reads it from.
+      // The lanes of the other groups read their own lane.
+      DenseMap<unsigned, Value> readChunks;
+      for (unsigned h = 0; h < numGroups; ++h) {
+        if (readChunks.count(chunks[h]))
+          continue;
+        Value srcLane = lane;
+        bool isPermuted = false;
+        for (unsigned other = h; other < numGroups; ++other) {
+          if (chunks[other] != chunks[h] || groups[other] == other)
+            continue;
+          Value otherLane =
+              add(laneInGroup, i32_val(groups[other] * nonKDim));
+          srcLane = select(isGroup[other], otherLane, srcLane);
+          isPermuted = true;
+        }
+        Value chunk = srcChunks[chunks[h]];
+        if (isPermuted)
+          chunk = permuteLanes(loc, rewriter, chunk, srcLane);
+        readChunks[chunks[h]] = chunk;
       }
-      Value view =
-          getTypeConverter()->packLLElements(loc, vecVals, rewriter, dstTy);
-      rewriter.replaceOp(op, view);
-      return success();
+      Value dstChunk = readChunks[chunks[0]];
+      for (unsigned h = 1; h < numGroups; ++h)
+        if (chunks[h] != chunks[0])
+          dstChunk = select(isGroup[h], readChunks[chunks[h]], dstChunk);
+      dstChunks.push_back(dstChunk);
     }
-    return failure();
+
+    // Gather the chunks of every operand element, then give them the type
+    // the MFMA instructions take
+    Type dstElemTy = getTypeConverter()->getElementTypeForStruct(dstTy);
+    unsigned kWidth =
+        dstTy.getEncoding().cast<DotOperandEncodingAttr>().getKWidth();
+    Type vecTy = vec_ty(elemTy, kWidth);
+    SmallVector<Value> vecVals;
+    for (unsigned i = 0; i < dstChunks.size(); i += kWidth / chunkSize) {
+      Value vec = undef(vecTy);
+      for (unsigned j = 0; j < kWidth; ++j) {
+        Value elem = extract_element(elemTy, dstChunks[i + j / chunkSize],
+                                     i32_val(j % chunkSize));
+        vec = insert_element(vecTy, vec, elem, i32_val(j));
+      }
+      vecVals.push_back(vecTy == dstElemTy ? vec : bitcast(vec, dstElemTy));
+    }
+    Value view =
+        getTypeConverter()->packLLElements(loc, vecVals, rewriter, dstTy);
+    rewriter.replaceOp(op, view);
+    return success();
   }
 #endif
 
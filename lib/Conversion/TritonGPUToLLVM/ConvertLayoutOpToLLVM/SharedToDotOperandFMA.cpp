@@ -89,6 +89,33 @@ ValueTable getValueTableFromStruct(Value val, int K, int n0, int shapePerCTA,
   return res;
 }
 
+// Returns the number of consecutive elements along K read at once from an
+// operand whose K dimension is contiguous in shared memory. Elements narrower
+// than a dword are read a dword at a time, which is the packing of the dot
+// instructions of the FMA path.
+static unsigned getKVecFMA(bool isKContig, int K, Type elemTy) {
+  unsigned bitwidth = elemTy.getIntOrFloatBitWidth();
+  if (!isKContig || bitwidth >= 32)
+    return 1;
+  unsigned kVec = 32 / bitwidth;
+  return K % kVec == 0 ? kVec : 1;
+}
+
+// Loads the `kVec` elements at `ptr` and stores them in `vals` at {mn, k} and
+// the following positions along K.
+static void loadKVecFMA(Value ptr, Type elemTy, unsigned kVec, int mn, int k,
+                        ValueTable &vals, Location loc,
+                        ConversionPatternRewriter &rewriter) {
+  if (kVec == 1) {
+    vals[{mn, k}] = load(ptr);
+    return;
+  }
+  Type vecTy = vec_ty(elemTy, kVec);
+  Value vec = load(bitcast(ptr, ptr_ty(vecTy, 3)));
+  for (unsigned kk = 0; kk < kVec; ++kk)
+    vals[{mn, k + kk}] = extract_element(elemTy, vec, i32_val(kk));
+}
+
 Value loadAFMA(Value A, Value llA, BlockedEncodingAttr dLayout, Value thread,
                Location loc, TritonGPUToLLVMTypeConverter *typeConverter,
                ConversionPatternRewriter &rewriter) {
@@ -140,16 +167,21 @@ Value loadAFMA(Value A, Value llA, BlockedEncodingAttr dLayout, Value thread,
 
   int mShapePerCTATile = getShapePerCTATileForMN(dLayout, true /*isM*/);
   int mSizePerThread = getSizePerThreadForMN(dLayout, true /*isM*/);
+  unsigned kVec = getKVecFMA(isARow, K, elemTy);
 
-  for (unsigned k = 0; k < K; ++k)
+  ValueTable has;
+  for (unsigned k = 0; k < K; k += kVec)
     for (unsigned m = 0; m < M; m += mShapePerCTATile)
       for (unsigned mm = 0; mm < mSizePerThread; ++mm) {
         Value offset =
             add(mul(i32_val(m + mm), strideAM), mul(i32_val(k), strideAK));
         Value pa = gep(ptrTy, aPtrs[0], offset);
-        Value va = load(pa);
-        vas.emplace_back(va);
+        loadKVecFMA(pa, elemTy, kVec, m + mm, k, has, loc, rewriter);
       }
+  for (unsigned k = 0; k < K; ++k)
+    for (unsigned m = 0; m < M; m += mShapePerCTATile)
+      for (unsigned mm = 0; mm < mSizePerThread; ++mm)
+        vas.emplace_back(has[{m + mm, k}]);
 
   return getStructFromValueTable(vas, rewriter, loc, typeConverter, elemTy);
 }
@@ -205,16 +237,21 @@ Value loadBFMA(Value B, Value llB, BlockedEncodingAttr dLayout, Value thread,
 
   int nShapePerCTATile = getShapePerCTATileForMN(dLayout, false /*isM*/);
   int nSizePerThread = getSizePerThreadForMN(dLayout, false /*isM*/);
+  unsigned kVec = getKVecFMA(!isBRow, K, elemTy);
 
-  for (unsigned k = 0; k < K; ++k)
+  ValueTable hbs;
+  for (unsigned k = 0; k < K; k += kVec)
     for (unsigned n = 0; n < N; n += nShapePerCTATile)
       for (unsigned nn = 0; nn < nSizePerThread; ++nn) {
         Value offset =
             add(mul(i32_val(n + nn), strideBN), mul(i32_val(k), strideBK));
         Value pb = gep(ptrTy, bPtrs[0], offset);
-        Value vb = load(pb);
-        vbs.emplace_back(vb);
+        loadKVecFMA(pb, elemTy, kVec, n + nn, k, hbs, loc, rewriter);
       }
+  for (unsigned k = 0; k < K; ++k)
+    for (unsigned n = 0; n < N; n += nShapePerCTATile)
+      for (unsigned nn = 0; nn < nSizePerThread; ++nn)
+        vbs.emplace_back(hbs[{n + nn, k}]);
 
   return getStructFromValueTable(vbs, rewriter, loc, typeConverter, elemTy);
 }
@@ -158,12 +158,15 @@ computeTensorElemMapping(ConversionPatternRewriter &rewriter, Location loc,
       Value tileVOffset = _0;
       Value tileHOffset = i32_val(tile * elemsPerInstr[1]);
 
-      Value laneVOffset = urem(laneId, nonKDim);
+      Value laneVOffset = urem(laneId, i32_val(elemsPerInstr[0]));
       Value laneHOffset;
       if (iNonKDim == 32)
         laneHOffset = select(icmp_uge(laneId, _32), i32_val(numOfElems), _0);
-      else
+      else if (iNonKDim == 16)
         laneHOffset = mul(udiv(laneId, nonKDim), i32_val(numOfElems));
+      else
+        // lanes of 4x4 instructions hold all the elements along K
+        laneHOffset = _0;
 
       for (int loadId = 0; loadId < loadsPerThread; ++loadId) {
         Value elemVOffset = _0;
@@ -200,6 +203,90 @@ Value computeOffset(ConversionPatternRewriter &rewriter, Location loc,
   return add(rowOffset, colOffset);
 }
 
+/**
+ * @brief Checks whether moving by (dRow, dCol) elements keeps the swizzling
+ * pattern of a shared layout
+ *
+ * Swizzling xors the vector index along the contiguous dimension with a
+ * phase that depends on the index along the other one. The phase repeats
+ * every perPhase * maxPhase lines and only changes the low log2(maxPhase)
+ * bits of the vector index, so moving by multiples of these periods moves
+ * the swizzled element by the same distance.
+ *
+ * @param layout shared layout of the tensor
+ * @param dRow distance along the rows of the tensor
+ * @param dCol distance along the cols of the tensor
+ * @return true if offset(row + dRow, col + dCol) equals offset(row, col) +
+ * dRow * stride0 + dCol * stride1 for every row and col
+ */
+bool isSwizzleInvariant(SharedEncodingAttr layout, int64_t dRow,
+                        int64_t dCol) {
+  if (!isSwizzled(layout))
+    return true;
+  bool transposed = (layout.getOrder()[0] != 1);
+  int64_t dContig = transposed ? dRow : dCol;
+  int64_t dStrided = transposed ? dCol : dRow;
+  return dContig % (layout.getVec() * layout.getMaxPhase()) == 0 &&
+         dStrided % (layout.getPerPhase() * layout.getMaxPhase()) == 0;
+}
+
+/**
+ * @brief Computes the offsets of the loads of every repetition of a dot
+ * operand from the element indexes of the first one
+ *
+ * Only the first repetition goes through the swizzling arithmetic when the
+ * others are at distances that keep the swizzling pattern. Their offsets
+ * are then the ones of the first repetition plus a constant, which the
+ * backend folds into the immediate offset of wide ds_read instructions.
+ * This holds for dynamic strides and slice offsets too.
+ *
+ * @param mapping row and col of the loads of the first repetition
+ * @param numRepNonK number of repetitions along the non-K axis
+ * @param numRepK number of repetitions along the K axis
+ * @param nonKStep (row, col) distance between repetitions along non-K
+ * @param kStep (row, col) distance between repetitions along K
+ * @return offsets ordered by non-K repetition, K repetition, then load
+ */
+llvm::SmallVector<Value>
+computeRepOffsets(ConversionPatternRewriter &rewriter, Location loc,
+                  ArrayRef<SmallVector<Value>> mapping, int64_t numRepNonK,
+                  int64_t numRepK, ArrayRef<int64_t> nonKStep,
+                  ArrayRef<int64_t> kStep, const SharedMemoryObject &smemObj,
+                  SharedEncodingAttr srcLayout) {
+  int loadsPerThread = mapping.size();
+  SmallVector<Value> baseOffsets(loadsPerThread);
+  for (int loadId = 0; loadId < loadsPerThread; ++loadId)
+    baseOffsets[loadId] = computeOffset(rewriter, loc, mapping[loadId][0],
+                                        mapping[loadId][1], smemObj,
+                                        srcLayout);
+
+  SmallVector<Value> offsets;
+  for (int64_t nonK = 0; nonK < numRepNonK; ++nonK) {
+    for (int64_t k = 0; k < numRepK; ++k) {
+      int64_t dRow = nonK * nonKStep[0] + k * kStep[0];
+      int64_t dCol = nonK * nonKStep[1] + k * kStep[1];
+      if (dRow == 0 && dCol == 0) {
+        offsets.append(baseOffsets.begin(), baseOffsets.end());
+        continue;
+      }
+      bool invariant = isSwizzleInvariant(srcLayout, dRow, dCol);
+      Value delta = add(mul(i32_val(dRow), smemObj.strides[0]),
+                        mul(i32_val(dCol), smemObj.strides[1]));
+      for (int loadId = 0; loadId < loadsPerThread; ++loadId) {
+        if (invariant) {
+          offsets.push_back(add(baseOffsets[loadId], delta));
+          continue;
+        }
+        Value row = add(mapping[loadId][0], i32_val(dRow));
+        Value col = add(mapping[loadId][1], i32_val(dCol));
+        offsets.push_back(
+            computeOffset(rewriter, loc, row, col, smemObj, srcLayout));
+      }
+    }
+  }
+  return offsets;
+}
+
 llvm::SmallVector<Value>
 computeOffsetsAType(ConversionPatternRewriter &rewriter, Location loc,
                     const ArrayRef<int64_t> &elemsPerInstr, Value waveId,
@@ -217,16 +304,15 @@ computeOffsetsAType(ConversionPatternRewriter &rewriter, Location loc,
       vectorSize = numOfElems;
   }
 
+  SmallVector<int64_t> firstRep{1, 1};
   auto mapping = computeTensorElemMapping(rewriter, loc, elemsPerInstr, waveId,
                                           laneId, warpsPerGroup, numOfElems,
-                                          reps, offsets, vectorSize, nonKDim);
-  llvm::SmallVector<Value> aOffsets(mapping.size());
-  for (int i = 0; i < mapping.size(); ++i) {
-    Value row = mapping[i][0];
-    Value col = mapping[i][1];
-    aOffsets[i] = computeOffset(rewriter, loc, row, col, smemObj, srcLayout);
-  }
-  return aOffsets;
+                                          firstRep, offsets, vectorSize,
+                                          nonKDim);
+  SmallVector<int64_t> nonKStep{elemsPerInstr[0] * warpsPerGroup, 0};
+  SmallVector<int64_t> kStep{0, elemsPerInstr[1]};
+  return computeRepOffsets(rewriter, loc, mapping, reps[0], reps[1], nonKStep,
+                           kStep, smemObj, srcLayout);
 }
 
 llvm::SmallVector<Value>
@@ -238,7 +324,6 @@ computeOffsetsBType(ConversionPatternRewriter &rewriter, Location loc,
   // transpose reps and offsets, because operand B has layout equal to
   // transposed operand A layout
   SmallVector<int64_t> tElemsPerInstr{elemsPerInstr[1], elemsPerInstr[0]};
-  SmallVector<int64_t> tReps{reps[1], reps[0]};
   SmallVector<Value> toffsets{smemObj.offsets[1], smemObj.offsets[0]};
 
   int vectorSize = 1;
@@ -249,18 +334,19 @@ computeOffsetsBType(ConversionPatternRewriter &rewriter, Location loc,
       vectorSize = numOfElems;
   }
 
+  SmallVector<int64_t> firstRep{1, 1};
   auto mapping = computeTensorElemMapping(rewriter, loc, tElemsPerInstr, waveId,
                                           laneId, warpsPerGroup, numOfElems,
-                                          tReps, toffsets, vectorSize, nonKDim);
-  llvm::SmallVector<Value> bOffsets(mapping.size());
-  for (int i = 0; i < mapping.size(); ++i) {
-    // swap row and col, because operand B layout is a transposed operand A
-    // layout
-    Value row = mapping[i][1];
-    Value col = mapping[i][0];
-    bOffsets[i] = computeOffset(rewriter, loc, row, col, smemObj, srcLayout);
-  }
-  return bOffsets;
+                                          firstRep, toffsets, vectorSize,
+                                          nonKDim);
+  // swap row and col, because operand B layout is a transposed operand A
+  // layout
+  for (auto &rowCol : mapping)
+    std::swap(rowCol[0], rowCol[1]);
+  SmallVector<int64_t> nonKStep{0, elemsPerInstr[1] * warpsPerGroup};
+  SmallVector<int64_t> kStep{elemsPerInstr[0], 0};
+  return computeRepOffsets(rewriter, loc, mapping, reps[1], reps[0], nonKStep,
+                           kStep, smemObj, srcLayout);
 }
 
 Value computeBasePtr(ConversionPatternRewriter &rewriter, Location loc,
@@ -274,181 +360,19 @@ Value computeBasePtr(ConversionPatternRewriter &rewriter, Location loc,
   return base;
 }
 
-/**
- * @brief try find if value is an integer constant
- *
- * Trace def-use chain and return integer in case we can proof it is constant.
- * Current implementation can trace chains of insertValue->extractValue
- * operations.
- *
- * @param val Value for that we want to get constant
- * @return std::optional on found integer value or empty std::optional
- */
-std::optional<int> findConstValue(Value val) {
-  while (val && !val.getDefiningOp<LLVM::ConstantOp>()) {
-    LLVM::ExtractValueOp extractValOp =
-        val.getDefiningOp<LLVM::ExtractValueOp>();
-    if (!extractValOp)
-      return std::optional<int>();
-    auto extractPosArr = extractValOp.getPosition();
-    if (extractPosArr.size() > 1)
-      return std::optional<int>();
-    int extractPos = extractPosArr[0];
-
-    int insertPos = -1;
-    LLVM::InsertValueOp insertValOp;
-    Value container = extractValOp.getOperand();
-    do {
-      insertValOp = container.getDefiningOp<LLVM::InsertValueOp>();
-      if (!insertValOp)
-        return std::optional<int>();
-      auto insertPosArr = insertValOp.getPosition();
-      if (insertPosArr.size() > 1)
-        return std::optional<int>();
-      insertPos = insertPosArr[0];
-      container = insertValOp.getContainer();
-    } while (insertPos != extractPos);
-    val = insertValOp.getValue();
-  }
-  if (!val)
-    return std::optional<int>();
-  auto cOp = val.getDefiningOp<LLVM::ConstantOp>();
-  assert(cOp);
-  auto valAttr = cOp.getValueAttr();
-  auto intAttr = dyn_cast<mlir::IntegerAttr>(valAttr);
-  assert(intAttr);
-  return intAttr.getInt();
-}
-
-bool fastPathAvailable(const SharedMemoryObject &smemObj,
-                       const SharedEncodingAttr &srcEncoding,
-                       const MfmaEncodingAttr &dstEncoding) {
-  if (dstEncoding.getNonKDim() != 32)
-    return false;
-  if (srcEncoding.getMaxPhase() > 1)
-    return false;
-  auto stride0 = findConstValue(smemObj.strides[0]);
-  auto stride1 = findConstValue(smemObj.strides[1]);
-  auto offset0 = findConstValue(smemObj.offsets[0]);
-  auto offset1 = findConstValue(smemObj.offsets[1]);
-  bool allValuesDefined = stride0.has_value() && stride1.has_value() &&
-                          offset0.has_value() && offset1.has_value();
-  if (!allValuesDefined)
-    return false;
-  if (offset0.value() != 0 || offset1.value() != 0)
-    return false;
-  return true;
-}
-
-// Computes offsets for operand A or transposed operand B
-// @param rewriter
-// @param loc
-// @param elemsPerInstr operand tile shape consumed by one MFMA instruction
-// @param waveM wave id for the "non K" axis
-// @param laneId lane id in warp [0..63]
-// @param warpsPerGroup number of warps in one block
-// @param numOfElems number of elements accessed by thread per repetition
-// @param reps number of instructions repretition to fully cover dot operand
-// @param cSwizzleOffset
-llvm::SmallVector<Value>
-fastPathComputeOffsetsTy1(ConversionPatternRewriter &rewriter, Location loc,
-                  const ArrayRef<int64_t> &elemsPerInstr, Value waveId,
-                  Value laneId, int warpsPerGroup, int numOfElems,
-                  ArrayRef<int64_t> reps, Value cSwizzleOffset) {
-  const int loadVecSize = numOfElems;
-  const int loadsPerThread = 1; // 1 is just in case if we decide to use different loadVecSize
-  auto numM = reps[0];
-  auto numK = reps[1];
-  SmallVector<Value> offsets(numM * numK * loadsPerThread);
-  int lineSize = elemsPerInstr[1] * numK;
-  int blockSize = elemsPerInstr[0] * warpsPerGroup * lineSize;
-  Value _0 = i32_val(0);
-  Value _32 = i32_val(32);
-  Value waveHalf = udiv(laneId, _32);
-
-  Value waveOffset = mul(waveId, i32_val(elemsPerInstr[0] * lineSize));
-  Value colOffset = select(icmp_uge(laneId, _32), i32_val(numOfElems), _0);
-
-  for (int block = 0; block < numM; ++block) {
-    Value blockOffset = i32_val(block * blockSize);
-    for (int tile = 0; tile < numK; ++tile) {
-      Value tileOffset = i32_val(tile * elemsPerInstr[1]);
-      for (int loadId = 0; loadId < loadsPerThread; ++loadId) {
-        Value rowOffset =
-            add(mul(urem(laneId, _32), i32_val(lineSize)), i32_val(loadId * loadVecSize));
-        Value elemOffset = add(rowOffset, colOffset);
-        Value offset =
-            add(add(add(waveOffset, blockOffset), tileOffset), elemOffset);
-        offsets[numK * loadsPerThread * block + loadsPerThread * tile + loadId] = offset;
-      }
-    }
-  }
-  return offsets;
-}
-
-// Computes offsets for operand B or transposed operand A
-// @param rewriter
-// @param loc
-// @param elemsPerInstr operand tile shape consumed by one MFMA instruction
-// @param waveId wave id for the "non K" axis
-// @param laneId lane id in warp [0..63]
-// @param warpsPerGroup number of warps per horizontal axis
-// @param numOfElems number of elements accessed by threads per repetition
-// @param reps number of instructions repretition to fully cover dot operand
-// @param cSwizzleOffset
-llvm::SmallVector<Value>
-fastPathComputeOffsetsTy2(ConversionPatternRewriter &rewriter, Location loc,
-                          const ArrayRef<int64_t> &elemsPerInstr, Value waveId,
-                          Value laneId, int warpsPerGroup, int numOfElems,
-                          ArrayRef<int64_t> reps, Value cSwizzleOffset) {
-  auto numK = reps[0];
-  auto numN = reps[1];
-  SmallVector<Value> offsets(numK * numN * numOfElems);
-
-  int lineSize = warpsPerGroup * elemsPerInstr[1] * numN;
-  Value _0 = i32_val(0);
-  Value _32 = i32_val(32);
-  Value waveOffset = mul(waveId, i32_val(elemsPerInstr[1]));
-  Value colOffset = urem(laneId, _32);
-
-  for (int block = 0; block < numN; ++block) {
-    Value blockOffset = i32_val(block * elemsPerInstr[1] * warpsPerGroup);
-    for (int tile = 0; tile < numK; ++tile) {
-      Value tileOffset = i32_val(tile * elemsPerInstr[0] * lineSize);
-      for (int elem = 0; elem < numOfElems; ++elem) {
-        Value halfOffset =
-            select(icmp_uge(laneId, _32), i32_val(numOfElems * lineSize), _0);
-        Value rowOffset = add(i32_val(elem * lineSize), halfOffset);
-        Value elemOffset = add(rowOffset, colOffset);
-        Value offset =
-            add(add(add(waveOffset, blockOffset), tileOffset), elemOffset);
-        offsets[numK * numOfElems * block + numOfElems * tile + elem] = offset;
-      }
-    }
-  }
-  return offsets;
-}
-
-bool isTransposed(::llvm::ArrayRef<unsigned> order) {
-  assert(order.size() == 2 && (order[0] & ~1ul) == 0 &&
-         order[0] + order[1] == 1);
-  return order[0] == 0;
-}
-
 Value loadA(ConversionPatternRewriter &rewriter, Location loc, Value thread,
             DotOperandEncodingAttr encoding,
             TritonGPUToLLVMTypeConverter *typeConverter, Value tensor,
             const SharedMemoryObject &smemObj) {
   auto mfmaLayout = encoding.getParent().cast<MfmaEncodingAttr>();
   auto nonKDim = mfmaLayout.getNonKDim();
-  assert(nonKDim == 32 || nonKDim == 16);
+  assert(nonKDim == 32 || nonKDim == 16 || nonKDim == 4);
   auto warpsPerCTA = mfmaLayout.getWarpsPerCTA();
 
   auto aTensorTy = tensor.getType().cast<RankedTensorType>();
   SmallVector<int64_t> shape(aTensorTy.getShape().begin(),
                              aTensorTy.getShape().end());
   auto sharedLayout = aTensorTy.getEncoding().cast<SharedEncodingAttr>();
-  auto order = sharedLayout.getOrder();
 
   auto aElemTy = aTensorTy.getElementType();
   auto aElemsPerInstr = encoding.getMFMAElemsPerInstr();
@@ -467,110 +391,59 @@ Value loadA(ConversionPatternRewriter &rewriter, Location loc, Value thread,
 
   Value waveM =
       getWaveM(rewriter, loc, wave, warpsPerCTA, mfmaInstrM, shape[0]);
-  int numOfElems = mfmaInstrM * mfmaInstrK / iWaveSize;
+  // The operand broadcast to the blocks of 4x4 instructions is smaller than
+  // a wave, every lane still holds the whole K of an instruction
+  int numOfElems =
+      nonKDim == 4 ? mfmaInstrK : mfmaInstrM * mfmaInstrK / iWaveSize;
   assert(numOfElems >= 1);
   unsigned int maxNumWarps = shape[0] / mfmaInstrM;
   int warpsPerGroupM = std::min(warpsPerCTA[0], maxNumWarps);
   aElemTy = typeConverter->convertType(aElemTy);
 
   SmallVector<Value> ha;
-  if (fastPathAvailable(smemObj, sharedLayout, mfmaLayout)) {
-    Value cSwizzleOffset = smemObj.getCSwizzleOffset(order[0]);
-    SmallVector<Value> offsets;
-    if (isTransposed(order)) {
-      SmallVector<int64_t> elemsPerInstr{mfmaInstrK, mfmaInstrM};
-      SmallVector<int64_t> reps{numReps[1], numReps[0]};
-      offsets = fastPathComputeOffsetsTy2(rewriter, loc, elemsPerInstr, waveM,
-                                          lane, warpsPerGroupM, numOfElems,
-                                          reps, cSwizzleOffset);
-    } else {
-      offsets = fastPathComputeOffsetsTy1(rewriter, loc, aElemsPerInstr, waveM,
-                                          lane, warpsPerGroupM, numOfElems,
-                                          numReps, cSwizzleOffset);
-    }
-    Value smemBase = smemObj.getBaseBeforeSlice(order[0], loc, rewriter);
-
-    Type smemPtrTy = getShemPtrTy(aElemTy);
-    Type resElemTy = typeConverter->convertType(aElemTy);
-
-    int loadsPerThread = offsets.size() / (numRepM * numRepK);
-    const int elemsPerLoad = numOfElems / loadsPerThread;
-    assert(numOfElems % loadsPerThread == 0);
-
-    for (int m = 0; m < numRepM; ++m) {
-      for (int k = 0; k < numRepK; ++k) {
-        auto vecTy = vec_ty(resElemTy, numOfElems);
-        Value valVec = undef(vecTy);
-        for (unsigned loadId = 0; loadId < loadsPerThread; ++loadId) {
-          auto loadVecTy = vec_ty(aElemTy, elemsPerLoad);
-          Value loadOffset =
-              offsets[m * loadsPerThread * numRepK + k * loadsPerThread + loadId];
-          Value loadAddress = bitcast(gep(smemPtrTy, smemBase, loadOffset),
-                                      getShemPtrTy(loadVecTy));
-          Value vectorValue = load(loadAddress);
-          if (numOfElems > 1) {
-            for (int elemId = 0; elemId < elemsPerLoad; ++elemId) {
-              Value elemVal =
-                  extract_element(aElemTy, vectorValue, i32_val(elemId));
-              elemVal = bitcast(elemVal, resElemTy);
-              valVec = insert_element(vecTy, valVec, elemVal,
-                                      i32_val(loadId * elemsPerLoad + elemId));
-            }
-          } else {
-            valVec = extract_element(aElemTy, vectorValue, i32_val(0));
-            valVec = bitcast(valVec, resElemTy);
-          }
-        }
-        if (aElemTy == i8_ty && numOfElems == 4)
-          valVec = bitcast(valVec, i32_ty);
-        if (aElemTy == i8_ty && numOfElems == 8)
-          valVec = bitcast(valVec, i64_ty);
-        ha.push_back(valVec);
-      }
-    }
-  } else { // normal path
-    SmallVector<Value> offsets = computeOffsetsAType(
-        rewriter, loc, aElemsPerInstr, waveM, lane, warpsPerGroupM, numOfElems,
-        numReps, smemObj, sharedLayout, nonKDim);
-
-    Value smemBase = computeBasePtr(rewriter, loc, smemObj);
-    Type resElemTy = typeConverter->convertType(aElemTy);
-
-    Type smemPtrTy = getShemPtrTy(aElemTy);
-
-    int loadsPerThread = offsets.size() / (numReps[0] * numReps[1]);
-    int elemsPerLoad = numOfElems / loadsPerThread;
-
-    for (int m = 0; m < numRepM; ++m) {
-      for (int k = 0; k < numRepK; ++k) {
-        auto vecTy = vec_ty(resElemTy, numOfElems);
-        Value valVec = undef(vecTy);
-        for (unsigned loadId = 0; loadId < loadsPerThread; ++loadId) {
-          auto loadVecTy = vec_ty(aElemTy, elemsPerLoad);
-          Value loadOffset = offsets[m * loadsPerThread * numRepK +
-                                     k * loadsPerThread + loadId];
-          Value loadAddress = bitcast(gep(smemPtrTy, smemBase, loadOffset),
-                                      getShemPtrTy(loadVecTy));
-          Value vectorValue = load(loadAddress);
-          if (numOfElems > 1) {
-            for (int elemId = 0; elemId < elemsPerLoad; ++elemId) {
-              Value elemVal =
-                  extract_element(aElemTy, vectorValue, i32_val(elemId));
-              elemVal = bitcast(elemVal, resElemTy);
-              valVec = insert_element(vecTy, valVec, elemVal,
-                                      i32_val(loadId * elemsPerLoad + elemId));
-            }
-          } else {
-            valVec = extract_element(aElemTy, vectorValue, i32_val(0));
-            valVec = bitcast(valVec, resElemTy);
+  SmallVector<Value> offsets = computeOffsetsAType(
+      rewriter, loc, aElemsPerInstr, waveM, lane, warpsPerGroupM, numOfElems,
+      numReps, smemObj, sharedLayout, nonKDim);
+
+  Value smemBase = computeBasePtr(rewriter, loc, smemObj);
+  Type resElemTy = typeConverter->convertType(aElemTy);
+
+  Type smemPtrTy = getShemPtrTy(aElemTy);
+
+  int loadsPerThread = offsets.size() / (numReps[0] * numReps[1]);
+  int elemsPerLoad = numOfElems / loadsPerThread;
+
+  for (int m = 0; m < numRepM; ++m) {
+    for (int k = 0; k < numRepK; ++k) {
+      auto vecTy = vec_ty(resElemTy, numOfElems);
+      Value valVec = undef(vecTy);
+      for (unsigned loadId = 0; loadId < loadsPerThread; ++loadId) {
+        auto loadVecTy = vec_ty(aElemTy, elemsPerLoad);
+        Value loadOffset = offsets[m * loadsPerThread * numRepK +
+                                   k * loadsPerThread + loadId];
+        Value loadAddress = bitcast(gep(smemPtrTy, smemBase, loadOffset),
+                                    getShemPtrTy(loadVecTy));
+        Value vectorValue = load(loadAddress);
+        if (numOfElems > 1) {
+          for (int elemId = 0; elemId < elemsPerLoad; ++elemId) {
+            Value elemVal =
+                extract_element(aElemTy, vectorValue, i32_val(elemId));
+            elemVal = bitcast(elemVal, resElemTy);
+            valVec = insert_element(vecTy, valVec, elemVal,
+                                    i32_val(loadId * elemsPerLoad + elemId));
           }
+        } else {
+          valVec = extract_element(aElemTy, vectorValue, i32_val(0));
+          valVec = bitcast(valVec, resElemTy);
         }
-        if (aElemTy == i8_ty && numOfElems == 4)
-          valVec = bitcast(valVec, i32_ty);
-        if (aElemTy == i8_ty && numOfElems == 8)
-          valVec = bitcast(valVec, i64_ty);
-        ha.push_back(valVec);
       }
+      if (aElemTy == i8_ty && numOfElems == 4)
+        valVec = bitcast(valVec, i32_ty);
+      if (aElemTy == i8_ty && numOfElems == 8)
+        valVec = bitcast(valVec, i64_ty);
+      if (aElemTy == i8_ty && numOfElems == 16)
+        valVec = bitcast(valVec, vec_ty(i64_ty, 2));
+      ha.push_back(valVec);
     }
   }
 
@@ -587,13 +460,12 @@ Value loadB(ConversionPatternRewriter &rewriter, Location loc, Value thread,
             const SharedMemoryObject &smemObj) {
   auto mfmaLayout = encoding.getParent().cast<MfmaEncodingAttr>();
   auto nonKDim = mfmaLayout.getNonKDim();
-  assert(nonKDim == 32 || nonKDim == 16);
+  assert(nonKDim == 32 || nonKDim == 16 || nonKDim == 4);
   auto warpsPerCTA = mfmaLayout.getWarpsPerCTA();
 
   auto bTensorTy = tensor.getType().cast<RankedTensorType>();
   ArrayRef<int64_t> shape = bTensorTy.getShape();
   auto sharedLayout = bTensorTy.getEncoding().cast<SharedEncodingAttr>();
-  auto order = sharedLayout.getOrder();
 
   auto bElemTy = bTensorTy.getElementType();
   auto bElemsPerInstr = encoding.getMFMAElemsPerInstr();
@@ -612,7 +484,9 @@ Value loadB(ConversionPatternRewriter &rewriter, Location loc, Value thread,
 
   Value waveN =
       getWaveN(rewriter, loc, wave, warpsPerCTA, mfmaInstrN, shape[1]);
-  int numOfElems = mfmaInstrK * mfmaInstrN / iWaveSize;
+  // See loadA
+  int numOfElems =
+      nonKDim == 4 ? mfmaInstrK : mfmaInstrK * mfmaInstrN / iWaveSize;
   assert(numOfElems >= 1);
 
   unsigned int maxNumWarps = shape[1] / mfmaInstrN;
@@ -620,105 +494,47 @@ Value loadB(ConversionPatternRewriter &rewriter, Location loc, Value thread,
   bElemTy = typeConverter->convertType(bElemTy);
 
   SmallVector<Value> hb;
-  if (fastPathAvailable(smemObj, sharedLayout, mfmaLayout)) {
-    Value cSwizzleOffset = smemObj.getCSwizzleOffset(order[0]);
-
-    llvm::SmallVector<Value> offsets;
-    unsigned int maxNumWarps = shape[1] / mfmaInstrN;
-    int warpsPerGroupN = std::min(warpsPerCTA[1], maxNumWarps);
-    if (isTransposed(order)) {
-      SmallVector<int64_t> elemsPerInstr{mfmaInstrN, mfmaInstrK};
-      SmallVector<int64_t> reps{numReps[1], numReps[0]};
-      offsets = fastPathComputeOffsetsTy1(rewriter, loc, elemsPerInstr, waveN,
-                                          lane, warpsPerGroupN, numOfElems,
-                                          reps, cSwizzleOffset);
-    } else {
-      offsets = fastPathComputeOffsetsTy2(rewriter, loc, bElemsPerInstr, waveN,
-                                          lane, warpsPerGroupN, numOfElems,
-                                          numReps, cSwizzleOffset);
-    }
-
-    Value smemBase = smemObj.getBaseBeforeSlice(order[0], loc, rewriter);
-
-    Type resElemTy = typeConverter->convertType(bElemTy);
-    Type smemPtrTy = getShemPtrTy(bElemTy);
-
-    const int loadsPerThread = offsets.size() / (numRepN * numRepK);
-    const int elemsPerLoad = numOfElems / loadsPerThread;
-    assert(numOfElems % loadsPerThread == 0);
-
-    for (int n = 0; n < numRepN; ++n) {
-      for (int k = 0; k < numRepK; ++k) {
-        auto vecTy = vec_ty(resElemTy, numOfElems);
-        Value valVec = undef(vecTy);
-        for (unsigned loadId = 0; loadId < loadsPerThread; ++loadId) {
-          auto loadVecTy = vec_ty(bElemTy, elemsPerLoad);
-          Value loadOffset =
-              offsets[n * loadsPerThread * numRepK + k * loadsPerThread + loadId];
-          Value loadAddress = bitcast(gep(smemPtrTy, smemBase, loadOffset),
-                                      getShemPtrTy(loadVecTy));
-          Value vectorValue = load(loadAddress);
-          if (numOfElems > 1) {
-            for (int elemId = 0; elemId < elemsPerLoad; ++elemId) {
-              Value elemVal =
-                  extract_element(bElemTy, vectorValue, i32_val(elemId));
-              elemVal = bitcast(elemVal, resElemTy);
-              valVec = insert_element(vecTy, valVec, elemVal,
-                                      i32_val(loadId * elemsPerLoad + elemId));
-            }
-          } else {
-            valVec = extract_element(bElemTy, vectorValue, i32_val(0));
-            valVec = bitcast(valVec, resElemTy);
-          }
-        }
-        if (bElemTy == i8_ty && numOfElems == 4)
-          valVec = bitcast(valVec, i32_ty);
-        if (bElemTy == i8_ty && numOfElems == 8)
-          valVec = bitcast(valVec, i64_ty);
-        hb.push_back(valVec);
-      }
-    }
-  } else { // normal path
-    llvm::SmallVector<Value> offsets = computeOffsetsBType(
-        rewriter, loc, bElemsPerInstr, waveN, lane, warpsPerGroupN, numOfElems,
-        numReps, smemObj, sharedLayout, nonKDim);
-
-    Value smemBase = computeBasePtr(rewriter, loc, smemObj);
-    Type resElemTy = typeConverter->convertType(bElemTy);
-    Type smemPtrTy = getShemPtrTy(bElemTy);
-
-    int loadsPerThread = offsets.size() / (numReps[0] * numReps[1]);
-    int elemsPerLoad = numOfElems / loadsPerThread;
-    for (int n = 0; n < numRepN; ++n) {
-      for (int k = 0; k < numRepK; ++k) {
-        auto vecTy = vec_ty(resElemTy, numOfElems);
-        Value valVec = undef(vecTy);
-        for (unsigned loadId = 0; loadId < loadsPerThread; ++loadId) {
-          auto loadVecTy = vec_ty(bElemTy, elemsPerLoad);
-          Value loadOffset = offsets[n * loadsPerThread * numRepK +
-                                     k * loadsPerThread + loadId];
-          Value loadAddress = bitcast(gep(smemPtrTy, smemBase, loadOffset),
-                                      getShemPtrTy(loadVecTy));
-          Value vectorValue = load(loadAddress);
-          if (numOfElems > 1) {
-            for (int elemId = 0; elemId < elemsPerLoad; ++elemId) {
-              Value elemVal =
-                  extract_element(bElemTy, vectorValue, i32_val(elemId));
-              elemVal = bitcast(elemVal, resElemTy);
-              valVec = insert_element(vecTy, valVec, elemVal,
-                                      i32_val(loadId * elemsPerLoad + elemId));
-            }
-          } else {
-            valVec = extract_element(bElemTy, vectorValue, i32_val(0));
-            valVec = bitcast(valVec, resElemTy);
+  llvm::SmallVector<Value> offsets = computeOffsetsBType(
+      rewriter, loc, bElemsPerInstr, waveN, lane, warpsPerGroupN, numOfElems,
+      numReps, smemObj, sharedLayout, nonKDim);
+
+  Value smemBase = computeBasePtr(rewriter, loc, smemObj);
+  Type resElemTy = typeConverter->convertType(bElemTy);
+  Type smemPtrTy = getShemPtrTy(bElemTy);
+
+  int loadsPerThread = offsets.size() / (numReps[0] * numReps[1]);
+  int elemsPerLoad = numOfElems / loadsPerThread;
+  for (int n = 0; n < numRepN; ++n) {
+    for (int k = 0; k < numRepK; ++k) {
+      auto vecTy = vec_ty(resElemTy, numOfElems);
+      Value valVec = undef(vecTy);
+      for (unsigned loadId = 0; loadId < loadsPerThread; ++loadId) {
+        auto loadVecTy = vec_ty(bElemTy, elemsPerLoad);
+        Value loadOffset = offsets[n * loadsPerThread * numRepK +
+                                   k * loadsPerThread + loadId];
+        Value loadAddress = bitcast(gep(smemPtrTy, smemBase, loadOffset),
+                                    getShemPtrTy(loadVecTy));
+        Value vectorValue = load(loadAddress);
+        if (numOfElems > 1) {
+          for (int elemId = 0; elemId < elemsPerLoad; ++elemId) {
+            Value elemVal =
+                extract_element(bElemTy, vectorValue, i32_val(elemId));
+            elemVal = bitcast(elemVal, resElemTy);
+            valVec = insert_element(vecTy, valVec, elemVal,
+                                    i32_val(loadId * elemsPerLoad + elemId));
           }
+        } else {
+          valVec = extract_element(bElemTy, vectorValue, i32_val(0));
+          valVec = bitcast(valVec, resElemTy);
         }
-        if (bElemTy == i8_ty && numOfElems == 4)
-          valVec = bitcast(valVec, i32_ty);
-        if (bElemTy == i8_ty && numOfElems == 8)
-          valVec = bitcast(valVec, i64_ty);
-        hb.push_back(valVec);
       }
+      if (bElemTy == i8_ty && numOfElems == 4)
+        valVec = bitcast(valVec, i32_ty);
+      if (bElemTy == i8_ty && numOfElems == 8)
+        valVec = bitcast(valVec, i64_ty);
+      if (bElemTy == i8_ty && numOfElems == 16)
+        valVec = bitcast(valVec, vec_ty(i64_ty, 2));
+      hb.push_back(valVec);
     }
   }
 
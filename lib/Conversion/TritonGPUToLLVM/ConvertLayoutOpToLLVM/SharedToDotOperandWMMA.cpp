@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2023, Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifdef USE_ROCM
+
+#include "../ConvertLayoutOpToLLVM.h"
+#include "../Utility.h"
+
+using ::mlir::triton::gpu::DotOperandEncodingAttr;
+using ::mlir::triton::gpu::SharedEncodingAttr;
+using ::mlir::triton::gpu::WmmaEncodingAttr;
+
+// The swizzling of shared memory is the same as for MFMA operands
+namespace SharedToDotOperandMFMA {
+bool isSwizzled(SharedEncodingAttr layout);
+
+Value computeOffset(ConversionPatternRewriter &rewriter, Location loc,
+                    Value row, Value col, SharedMemoryObject smemObj,
+                    SharedEncodingAttr srcLayout);
+
+Value computeBasePtr(ConversionPatternRewriter &rewriter, Location loc,
+                     const SharedMemoryObject &smemObj);
+} // namespace SharedToDotOperandMFMA
+
+namespace SharedToDotOperandWMMA {
+
+/**
+ * @brief Loads a WMMA operand from shared memory
+ *
+ * Each WMMA instruction consumes a 16x16 (non-K x K) tile of each operand.
+ * Lane l holds the 16 elements along K of row (A) or column (B) l % 16 of the
+ * tile, so lanes l and l + 16 hold the same values. The tiles along the
+ * non-K axis are distributed between waves like the tiles of the result.
+ *
+ * @return a struct with one 16-element vector per instruction, ordered by
+ * non-K tile then K tile
+ */
+Value convertLayout(int opIdx, ConversionPatternRewriter &rewriter,
+                    Location loc, Value tensor,
+                    DotOperandEncodingAttr encoding,
+                    const SharedMemoryObject &smemObj,
+                    TritonGPUToLLVMTypeConverter *typeConverter,
+                    Value thread) {
+  assert((opIdx == 0 || opIdx == 1) && "unexpected operand idx");
+  auto wmmaLayout = encoding.getParent().cast<WmmaEncodingAttr>();
+  auto warpsPerCTA = wmmaLayout.getWarpsPerCTA();
+
+  auto tensorTy = tensor.getType().cast<RankedTensorType>();
+  ArrayRef<int64_t> shape = tensorTy.getShape();
+  auto sharedLayout = tensorTy.getEncoding().cast<SharedEncodingAttr>();
+  auto order = sharedLayout.getOrder();
+  Type elemTy = typeConverter->convertType(tensorTy.getElementType());
+
+  int kDimIdx = opIdx == 0 ? 1 : 0;
+  int nonKDimIdx = 1 - kDimIdx;
+  auto elemsPerInstr = encoding.getWMMAElemsPerInstr();
+  int64_t instrNonK = elemsPerInstr[nonKDimIdx];
+  int64_t instrK = elemsPerInstr[kDimIdx];
+  auto numReps = encoding.getWMMARep(shape);
+  int64_t numRepNonK = numReps[nonKDimIdx];
+  int64_t numRepK = numReps[kDimIdx];
+
+  unsigned iWaveSize = wmmaLayout.getWarpSize();
+  Value waveSize = i32_val(iWaveSize);
+  Value wave = udiv(thread, waveSize);
+  Value lane = urem(thread, waveSize);
+
+  // Position of the wave along the non-K axis, as in the result layout
+  unsigned maxNumWarps =
+      std::max<unsigned>(1, shape[nonKDimIdx] / instrNonK);
+  unsigned warpsPerGroup = std::min(warpsPerCTA[nonKDimIdx], maxNumWarps);
+  Value waveNonK = opIdx == 0 ? urem(wave, i32_val(warpsPerCTA[0]))
+                              : urem(udiv(wave, i32_val(warpsPerCTA[0])),
+                                     i32_val(warpsPerCTA[1]));
+  waveNonK = urem(waveNonK, i32_val(maxNumWarps));
+  Value laneNonK = add(mul(waveNonK, i32_val(instrNonK)),
+                       urem(lane, i32_val(instrNonK)));
+  laneNonK = add(laneNonK, smemObj.offsets[nonKDimIdx]);
+
+  // The elements of a lane are contiguous when K is the inner dimension.
+  // Swizzling keeps vectors of `vec` elements together.
+  int loadVecSize = 1;
+  if (order[0] == kDimIdx) {
+    loadVecSize = instrK;
+    if (SharedToDotOperandMFMA::isSwizzled(sharedLayout))
+      loadVecSize = std::min<int>(sharedLayout.getVec(), instrK);
+  }
+
+  Value smemBase = SharedToDotOperandMFMA::computeBasePtr(rewriter, loc,
+                                                          smemObj);
+  Type smemPtrTy = ptr_ty(elemTy, 3);
+  auto loadVecTy = vec_ty(elemTy, loadVecSize);
+  auto vecTy = vec_ty(elemTy, instrK);
+
+  SmallVector<Value> vals;
+  for (int64_t nonK = 0; nonK < numRepNonK; ++nonK) {
+    Value nonKIdx =
+        add(laneNonK, i32_val(nonK * instrNonK * warpsPerGroup));
+    for (int64_t k = 0; k < numRepK; ++k) {
+      Value valVec = undef(vecTy);
+      for (int elem = 0; elem < instrK; elem += loadVecSize) {
+        Value kIdx =
+            add(smemObj.offsets[kDimIdx], i32_val(k * instrK + elem));
+        Value row = opIdx == 0 ? nonKIdx : kIdx;
+        Value col = opIdx == 0 ? kIdx : nonKIdx;
+        Value offset = SharedToDotOperandMFMA::computeOffset(
+            rewriter, loc, row, col, smemObj, sharedLayout);
+        Value loadAddress = bitcast(gep(smemPtrTy, smemBase, offset),
+                                    ptr_ty(loadVecTy, 3));
+        Value loaded = load(loadAddress);
+        for (int i = 0; i < loadVecSize; ++i) {
+          Value elemVal = extract_element(elemTy, loaded, i32_val(i));
+          valVec = insert_element(vecTy, valVec, elemVal, i32_val(elem + i));
+        }
+      }
+      // The int8 instruction takes its operands packed in dwords
+      if (elemTy.isInteger(8))
+        valVec = bitcast(valVec, vec_ty(i32_ty, instrK / 4));
+      vals.push_back(valVec);
+    }
+  }
+
+  MLIRContext *ctx = wmmaLayout.getContext();
+  Type structTy = LLVM::LLVMStructType::getLiteral(
+      ctx, SmallVector<Type>(vals.size(), vals[0].getType()));
+  return typeConverter->packLLElements(loc, vals, rewriter, structTy);
+}
+
+} // namespace SharedToDotOperandWMMA
+
+#endif // ifdef USE_ROCM
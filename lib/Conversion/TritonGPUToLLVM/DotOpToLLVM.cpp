@@ -11,7 +11,8 @@ using ::mlir::triton::gpu::MmaEncodingAttr;
 
 LogicalResult convertFMADot(triton::DotOp op, triton::DotOp::Adaptor adaptor,
                             TritonGPUToLLVMTypeConverter *typeConverter,
-                            ConversionPatternRewriter &rewriter);
+                            ConversionPatternRewriter &rewriter,
+                            int matrixCoreVersion);
 
 LogicalResult convertMMA884(triton::DotOp op, triton::DotOp::Adaptor adaptor,
                             TritonGPUToLLVMTypeConverter *typeConverter,
@@ -29,6 +30,10 @@ LogicalResult convertMMA16816(triton::DotOp op, triton::DotOp::Adaptor adaptor,
 LogicalResult convertMFMA(triton::DotOp op, triton::DotOp::Adaptor adaptor,
                           TritonGPUToLLVMTypeConverter *typeConverter,
                           ConversionPatternRewriter &rewriter);
+
+LogicalResult convertWMMA(triton::DotOp op, triton::DotOp::Adaptor adaptor,
+                          TritonGPUToLLVMTypeConverter *typeConverter,
+                          ConversionPatternRewriter &rewriter);
 #endif
 LogicalResult convertWGMMA(triton::DotOp op, triton::DotOp::Adaptor adaptor,
                            TritonGPUToLLVMTypeConverter *typeConverter,
@@ -41,8 +46,12 @@ LogicalResult convertAsyncWGMMA(triton::nvidia_gpu::DotAsyncOp op,
                                 Value thread);
 
 struct DotOpConversion : public ConvertTritonGPUOpToLLVMPattern<triton::DotOp> {
-  using ConvertTritonGPUOpToLLVMPattern<
-      triton::DotOp>::ConvertTritonGPUOpToLLVMPattern;
+  DotOpConversion(TritonGPUToLLVMTypeConverter &typeConverter,
+                  ModuleAllocation &allocation, int matrixCoreVersion,
+                  PatternBenefit benefit)
+      : ConvertTritonGPUOpToLLVMPattern<triton::DotOp>(typeConverter,
+                                                       allocation, benefit),
+        matrixCoreVersion(matrixCoreVersion) {}
 
   LogicalResult
   matchAndRewrite(triton::DotOp op, OpAdaptor adaptor,
@@ -85,17 +94,29 @@ struct DotOpConversion : public ConvertTritonGPUOpToLLVMPattern<triton::DotOp> {
     if (!isOuter && mfmaLayout && supportMFMA(op)) {
       return convertMFMA(op, adaptor, getTypeConverter(), rewriter);
     }
+
+    WmmaEncodingAttr wmmaLayout = D.getType()
+                                      .cast<RankedTensorType>()
+                                      .getEncoding()
+                                      .dyn_cast<WmmaEncodingAttr>();
+    if (!isOuter && wmmaLayout && supportWMMA(op)) {
+      return convertWMMA(op, adaptor, getTypeConverter(), rewriter);
+    }
 #endif
 
     if (D.getType()
             .cast<RankedTensorType>()
             .getEncoding()
             .isa<BlockedEncodingAttr>())
-      return convertFMADot(op, adaptor, getTypeConverter(), rewriter);
+      return convertFMADot(op, adaptor, getTypeConverter(), rewriter,
+                           matrixCoreVersion);
 
     llvm::report_fatal_error(
         "Unsupported DotOp found when converting TritonGPU to LLVM.");
   }
+
+private:
+  int matrixCoreVersion;
 };
 
 struct DotAsyncOpConversion
@@ -158,8 +179,10 @@ void populateDotOpToLLVMPatterns(TritonGPUToLLVMTypeConverter &typeConverter,
                                  RewritePatternSet &patterns, int numWarps,
                                  ModuleAxisInfoAnalysis &axisInfoAnalysis,
                                  ModuleAllocation &allocation,
+                                 int matrixCoreVersion,
                                  PatternBenefit benefit) {
-  patterns.add<DotOpConversion>(typeConverter, allocation, benefit);
+  patterns.add<DotOpConversion>(typeConverter, allocation, matrixCoreVersion,
+                                benefit);
   patterns.add<DotAsyncOpConversion>(typeConverter, allocation, benefit);
   patterns.add<DotWaitOpConversion>(typeConverter, allocation, benefit);
 }
@@ -26,9 +26,96 @@ static ValueTableFMA getValueTableFromStructFMA(
   return res;
 }
 
+#ifdef USE_ROCM
+namespace {
+// A dot instruction that accumulates the products of kPack pairs of packed
+// operand elements into a 32-bit accumulator.
+struct PackedDotInstr {
+  StringRef name;
+  unsigned kPack;
+};
+} // namespace
+
+// Returns the packed dot instruction of the target for operands of type
+// `aElemTy` accumulated into `dElemTy`, if any. All the targets with matrix
+// cores have v_dot2_f32_f16 and a v_dot4 for int8, which takes the signedness
+// of its operands on RDNA3. Only RDNA3 has v_dot2_f32_bf16.
+static std::optional<PackedDotInstr>
+getPackedDotInstr(Type aElemTy, Type dElemTy, int matrixCoreVersion) {
+  if (matrixCoreVersion < 1 || matrixCoreVersion > 4)
+    return std::nullopt;
+  if (aElemTy.isF16() && dElemTy.isF32())
+    return PackedDotInstr{"llvm.amdgcn.fdot2", 2};
+  if (aElemTy.isBF16() && dElemTy.isF32() && matrixCoreVersion == 4)
+    return PackedDotInstr{"llvm.amdgcn.fdot2.f32.bf16", 2};
+  if (aElemTy.isInteger(8) && dElemTy.isInteger(32))
+    return PackedDotInstr{matrixCoreVersion == 4 ? "llvm.amdgcn.sudot4"
+                                                 : "llvm.amdgcn.sdot4",
+                          4};
+  return std::nullopt;
+}
+
+static Value packDotOperands(Location loc, ConversionPatternRewriter &rewriter,
+                             ArrayRef<Value> elems) {
+  Type elemTy = elems[0].getType();
+  Type vecTy = vec_ty(elemTy, elems.size());
+  Value vec = undef(vecTy);
+  for (auto [i, elem] : llvm::enumerate(elems))
+    vec = insert_element(vecTy, vec, elem, i32_val(i));
+  // The integer instructions take the 4 bytes in a dword
+  if (elemTy.isInteger(8))
+    return bitcast(vec, i32_ty);
+  return vec;
+}
+
+static Value createPackedDot(Location loc, ConversionPatternRewriter &rewriter,
+                             const PackedDotInstr &instr, Value a, Value b,
+                             Value acc) {
+  Type accTy = acc.getType();
+  Type opTy = a.getType();
+  bool isMixedSign = instr.name == "llvm.amdgcn.sudot4";
+  SmallVector<Type> argTys = {opTy, opTy, accTy, i1_ty};
+  if (isMixedSign)
+    argTys = {i1_ty, opTy, i1_ty, opTy, accTy, i1_ty};
+
+  auto moduleOp =
+      rewriter.getInsertionBlock()->getParentOp()->getParentOfType<ModuleOp>();
+  auto funcOp = moduleOp.lookupSymbol<LLVM::LLVMFuncOp>(instr.name);
+  if (!funcOp) {
+    OpBuilder::InsertionGuard guard(rewriter);
+    rewriter.setInsertionPointToStart(moduleOp.getBody());
+    funcOp = rewriter.create<LLVM::LLVMFuncOp>(
+        loc, instr.name, LLVM::LLVMFunctionType::get(accTy, argTys));
+  }
+  // No saturation of the result
+  Value clamp = int_val(1, 0);
+  if (isMixedSign) {
+    Value isSigned = int_val(1, 1);
+    return call(funcOp, ValueRange{isSigned, a, isSigned, b, acc, clamp})
+        .getResult();
+  }
+  return call(funcOp, ValueRange{a, b, acc, clamp}).getResult();
+}
+#endif
+
+// Extends an operand element of type `elemTy` to the accumulator type
+// `accTy`. Integer operands are signed.
+static Value extendToAccumulator(Location loc,
+                                 ConversionPatternRewriter &rewriter,
+                                 Value val, Type elemTy, Type accTy) {
+  if (val.getType() == accTy)
+    return val;
+  if (elemTy.isBF16())
+    val = bitcast(val, elemTy);
+  if (accTy.isa<FloatType>())
+    return rewriter.create<LLVM::FPExtOp>(loc, accTy, val);
+  return sext(accTy, val);
+}
+
 LogicalResult convertFMADot(triton::DotOp op, triton::DotOp::Adaptor adaptor,
                             TritonGPUToLLVMTypeConverter *typeConverter,
-                            ConversionPatternRewriter &rewriter) {
+                            ConversionPatternRewriter &rewriter,
+                            int matrixCoreVersion) {
   auto *ctx = rewriter.getContext();
   auto loc = op.getLoc();
 
@@ -79,7 +166,19 @@ LogicalResult convertFMADot(triton::DotOp op, triton::DotOp::Adaptor adaptor,
   SmallVector<Value> ret = cc;
   bool isCRow = order[0] == 1;
 
-  for (unsigned k = 0; k < K; k++) {
+  Type aElemTy = aTensorTy.getElementType();
+  Type dElemTy = dTensorTy.getElementType();
+  Type accTy = typeConverter->convertType(dElemTy);
+  // Operands narrower than the accumulator are multiplied kPack at a time
+  // along K when the target has a dot instruction for them
+  unsigned kPack = 1;
+#ifdef USE_ROCM
+  auto packedDot = getPackedDotInstr(aElemTy, dElemTy, matrixCoreVersion);
+  if (packedDot && K % packedDot->kPack == 0)
+    kPack = packedDot->kPack;
+#endif
+
+  for (unsigned k = 0; k < K; k += kPack) {
     for (unsigned m = 0; m < M; m += mShapePerCTATile)
       for (unsigned n = 0; n < N; n += nShapePerCTATile)
         for (unsigned mm = 0; mm < mSizePerThread; ++mm)
@@ -90,8 +189,28 @@ LogicalResult convertFMADot(triton::DotOp op, triton::DotOp::Adaptor adaptor,
             int z = isCRow
                         ? mIdx * N / nShapePerCTATile * mSizePerThread + nIdx
                         : nIdx * M / mShapePerCTATile * nSizePerThread + mIdx;
-            ret[z] = rewriter.create<LLVM::FMulAddOp>(loc, has[{m + mm, k}],
-                                                      hbs[{n + nn, k}], ret[z]);
+#ifdef USE_ROCM
+            if (kPack > 1) {
+              SmallVector<Value> as, bs;
+              for (unsigned kk = 0; kk < kPack; ++kk) {
+                as.push_back(has[{m + mm, k + kk}]);
+                bs.push_back(hbs[{n + nn, k + kk}]);
+              }
+              ret[z] = createPackedDot(loc, rewriter, *packedDot,
+                                       packDotOperands(loc, rewriter, as),
+                                       packDotOperands(loc, rewriter, bs),
+                                       ret[z]);
+              continue;
+            }
+#endif
+            Value a = extendToAccumulator(loc, rewriter, has[{m + mm, k}],
+                                          aElemTy, accTy);
+            Value b = extendToAccumulator(loc, rewriter, hbs[{n + nn, k}],
+                                          aElemTy, accTy);
+            if (accTy.isa<FloatType>())
+              ret[z] = rewriter.create<LLVM::FMulAddOp>(loc, a, b, ret[z]);
+            else
+              ret[z] = add(mul(a, b), ret[z]);
           }
   }
 
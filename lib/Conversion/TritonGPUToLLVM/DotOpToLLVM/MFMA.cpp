@@ -46,6 +46,7 @@ enum class MatrixCoreType : uint8_t {
   FP32_BF16_BF16_FP32,
   FP32_BF16_BF16_FP32_1K,
   FP32_FP32_FP32_FP32,
+  FP32_XF32_XF32_FP32,
   FP64_FP64_FP64_FP64,
   INT32_INT8_INT8_INT32,
   INT32_INT8_INT8_INT32_CDNA3,  
@@ -126,6 +127,11 @@ struct DotOpMFMAConversionHelper {
             ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
       }
     case MatrixCoreType::FP32_FP16_FP16_FP32:
+      if (mfmaDescr.size == 4) {
+        return rewriter.create<ROCDL::mfma_f32_4x4x4f16>(
+            loc, TypeRange{resType},
+            ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
+      }
       if (mfmaDescr.size == 16) {
         return rewriter.create<ROCDL::mfma_f32_16x16x16f16>(
             loc, TypeRange{resType},
@@ -136,6 +142,11 @@ struct DotOpMFMAConversionHelper {
             ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
       }
     case MatrixCoreType::FP32_BF16_BF16_FP32:
+      if (mfmaDescr.size == 4) {
+        return rewriter.create<ROCDL::mfma_f32_4x4x2bf16>(
+            loc, TypeRange{resType},
+            ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
+      }
       if (mfmaDescr.size == 16) {
         return rewriter.create<ROCDL::mfma_f32_16x16x8bf16>(
             loc, TypeRange{resType},
@@ -146,6 +157,11 @@ struct DotOpMFMAConversionHelper {
             ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
       }
     case MatrixCoreType::FP32_BF16_BF16_FP32_1K:
+      if (mfmaDescr.size == 4) {
+        return rewriter.create<ROCDL::mfma_f32_4x4x4bf16_1k>(
+            loc, TypeRange{resType},
+            ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
+      }
       if (mfmaDescr.size == 16) {
         return rewriter.create<ROCDL::mfma_f32_16x16x16bf16_1k>(
             loc, TypeRange{resType},
@@ -157,6 +173,11 @@ struct DotOpMFMAConversionHelper {
             ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
       }
     case MatrixCoreType::FP32_FP32_FP32_FP32:
+      if (mfmaDescr.size == 4) {
+        return rewriter.create<ROCDL::mfma_f32_4x4x1f32>(
+            loc, TypeRange{resType},
+            ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
+      }
       if (mfmaDescr.size == 16) {
         return rewriter.create<ROCDL::mfma_f32_16x16x4f32>(
             loc, TypeRange{resType},
@@ -167,7 +188,23 @@ struct DotOpMFMAConversionHelper {
             loc, TypeRange{resType},
             ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
       }
+    case MatrixCoreType::FP32_XF32_XF32_FP32:
+      if (mfmaDescr.size == 16) {
+        return rewriter.create<ROCDL::mfma_f32_16x16x8_xf32>(
+            loc, TypeRange{resType},
+            ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
+      } else {
+        assert(mfmaDescr.size == 32);
+        return rewriter.create<ROCDL::mfma_f32_32x32x4_xf32>(
+            loc, TypeRange{resType},
+            ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
+      }
     case MatrixCoreType::INT32_INT8_INT8_INT32:
+      if (mfmaDescr.size == 4) {
+        return rewriter.create<ROCDL::mfma_i32_4x4x4i8>(
+            loc, TypeRange{resType},
+            ValueRange{valA, valB, valC, zeroFlag, zeroFlag, zeroFlag});
+      }
       if (mfmaDescr.size == 16) {
         return rewriter.create<ROCDL::mfma_i32_16x16x16i8>(
             loc, TypeRange{resType},
@@ -218,23 +255,26 @@ struct DotOpMFMAConversionHelper {
       return MatrixCoreType::FP32_BF8_BF8_FP32;
     if (aElemTy.isF16())
       return MatrixCoreType::FP32_FP16_FP16_FP32;
-    if (aElemTy.isF32())
+    // The instructions take kWidth / kPack elements of each lane
+    if (aElemTy.isF32()) {
+      auto kWidth = dotOpEncoding.getKWidth() / dotOpEncoding.getKPack();
+      if (kWidth == 2)
+        return MatrixCoreType::FP32_XF32_XF32_FP32;
+      assert(kWidth == 1);
       return MatrixCoreType::FP32_FP32_FP32_FP32;
+    }
     if (aElemTy.isBF16()) {
-      auto nonKDim = mfmaEncoding.getNonKDim();
-      auto kWidth = dotOpEncoding.getKWidth();
-      if ((nonKDim == 32 && kWidth == 4) || (nonKDim == 16 && kWidth == 4)) {
+      auto kWidth = dotOpEncoding.getKWidth() / dotOpEncoding.getKPack();
+      if (kWidth == 4) {
         return MatrixCoreType::FP32_BF16_BF16_FP32_1K;
       } else {
-        assert((nonKDim == 32 && kWidth == 2) ||
-               (nonKDim == 16 && kWidth == 2));
+        assert(kWidth == 2);
         return MatrixCoreType::FP32_BF16_BF16_FP32;
       }
     }
     if (aElemTy.isInteger(8)) {
-      auto nonKDim = mfmaEncoding.getNonKDim();
-      auto kWidth = dotOpEncoding.getKWidth();
-      if ((nonKDim == 32 && kWidth == 8) || (nonKDim == 16 && kWidth == 8)) {
+      auto kWidth = dotOpEncoding.getKWidth() / dotOpEncoding.getKPack();
+      if (kWidth == 8) {
         return MatrixCoreType::INT32_INT8_INT8_INT32_CDNA3;
       }
       else {
@@ -259,7 +299,8 @@ struct DotOpMFMAConversionHelper {
   LogicalResult convertDot(DotOp op, DotOpAdaptor adaptor) const {
     auto warpsPerCTA = mfmaLayout.getWarpsPerCTA();
     auto nonKDim = mfmaLayout.getNonKDim();
-    assert(nonKDim == 32 || nonKDim == 16);
+    assert(nonKDim == 32 || nonKDim == 16 || nonKDim == 4);
+    auto instrShape = mfmaLayout.getMFMAInstrShape();
     auto mfmaInstrDescr = getMatrixInstrDescr(op);
 
     Value a = op.getA();
@@ -275,6 +316,8 @@ struct DotOpMFMAConversionHelper {
 
     auto repA = aEncoding.getMFMARep(aTensorTy.getShape(), elemTy);
     auto repB = bEncoding.getMFMARep(bTensorTy.getShape(), elemTy);
+    unsigned kPack = aEncoding.getKPack();
+    assert(kPack == bEncoding.getKPack());
 
     assert(repA[1] == repB[0]);
 
@@ -297,7 +340,7 @@ struct DotOpMFMAConversionHelper {
     unsigned warpSize = triton::gpu::getWarpSize(mfmaLayout);
     // compute number of output elements that each thread holds for one MFMA
     // instruction
-    auto elemsPerVec = nonKDim * nonKDim / warpSize;
+    auto elemsPerVec = instrShape[0] * instrShape[1] / warpSize;
 
     auto vecTy = vec_ty(dstElemTy, elemsPerVec);
     for (int m = 0; m < numRepM; ++m) {
@@ -310,10 +353,14 @@ struct DotOpMFMAConversionHelper {
         }
 
         for (size_t k = 0; k < numRepK; k++) {
-          acc =
-              mfmaLayout.getIsTransposed()
-                  ? generateMFMAOp(mfmaInstrDescr, hb[{n, k}], ha[{m, k}], acc)
-                  : generateMFMAOp(mfmaInstrDescr, ha[{m, k}], hb[{n, k}], acc);
+          auto aParts = splitKPack(ha[{m, k}], kPack);
+          auto bParts = splitKPack(hb[{n, k}], kPack);
+          for (unsigned p = 0; p < kPack; ++p)
+            acc = mfmaLayout.getIsTransposed()
+                      ? generateMFMAOp(mfmaInstrDescr, bParts[p], aParts[p],
+                                       acc)
+                      : generateMFMAOp(mfmaInstrDescr, aParts[p], bParts[p],
+                                       acc);
         }
         for (unsigned v = 0; v < elemsPerVec; ++v) {
           fc[m * numRepN * elemsPerVec + n * elemsPerVec + v] =
@@ -331,6 +378,42 @@ struct DotOpMFMAConversionHelper {
     return success();
   }
 
+  /// Splits the operand values a lane loaded for kPack instructions along K
+  /// into the operands of each instruction
+  SmallVector<Value> splitKPack(Value packed, unsigned kPack) const {
+    if (kPack == 1)
+      return {packed};
+    Type packedTy = packed.getType();
+    SmallVector<Value> parts;
+    auto vecTy = packedTy.dyn_cast<VectorType>();
+    Type elemTy = vecTy ? vecTy.getElementType() : packedTy;
+    // 16-bit and xf32 operands stay vectors of kWidth / kPack elements
+    unsigned partSize = vecTy ? vecTy.getNumElements() / kPack : 1;
+    if (elemTy.getIntOrFloatBitWidth() == 16 ||
+        (elemTy.isF32() && partSize > 1)) {
+      auto partTy = vec_ty(elemTy, partSize);
+      for (unsigned p = 0; p < kPack; ++p) {
+        Value part = undef(partTy);
+        for (unsigned i = 0; i < partSize; ++i)
+          part = insert_element(
+              partTy, part,
+              extract_element(elemTy, packed, i32_val(p * partSize + i)),
+              i32_val(i));
+        parts.push_back(part);
+      }
+      return parts;
+    }
+    // f32 operands are scalars, int8 ones are packed in an integer
+    unsigned numBits = elemTy.getIntOrFloatBitWidth() *
+                       (vecTy ? vecTy.getNumElements() : 1);
+    Type partTy = elemTy.isF32() ? elemTy
+                                 : (Type)IntegerType::get(ctx, numBits / kPack);
+    Value partsVec = bitcast(packed, vec_ty(partTy, kPack));
+    for (unsigned p = 0; p < kPack; ++p)
+      parts.push_back(extract_element(partTy, partsVec, i32_val(p)));
+    return parts;
+  }
+
   ValueTable getValuesFromDotOperandLayoutStruct(Value value, int n0, int n1,
                                                  Type type) const {
     auto elems = typeConverter->unpackLLElements(loc, value, rewriter, type);
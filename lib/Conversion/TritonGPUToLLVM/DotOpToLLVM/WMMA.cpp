@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2023, Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifdef USE_ROCM
+
+#include "../DotOpToLLVM.h"
+#include "../Utility.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+namespace {
+
+using ::mlir::triton::gpu::DotOperandEncodingAttr;
+using ::mlir::triton::gpu::WmmaEncodingAttr;
+
+using ValueTable = std::map<std::pair<unsigned, unsigned>, Value>;
+
+struct DotOpWMMAConversionHelper {
+  WmmaEncodingAttr wmmaLayout;
+
+  ConversionPatternRewriter &rewriter;
+  TritonGPUToLLVMTypeConverter *typeConverter;
+  Location loc;
+  MLIRContext *ctx{};
+
+  explicit DotOpWMMAConversionHelper(
+      WmmaEncodingAttr wmmaLayout, ConversionPatternRewriter &rewriter,
+      TritonGPUToLLVMTypeConverter *typeConverter, Location loc)
+      : wmmaLayout(wmmaLayout), rewriter(rewriter),
+        typeConverter(typeConverter), loc(loc), ctx(wmmaLayout.getContext()) {}
+
+  // ROCDL has no ops for the WMMA instructions, so they are emitted as calls
+  // to the LLVM intrinsics. The intrinsics are overloaded on the type of the
+  // accumulator only, which is part of their mangled name.
+  LLVM::LLVMFuncOp getIntrinsic(Type aElemTy, Type opTy, Type accTy) const {
+    std::string name;
+    SmallVector<Type> argTys;
+    if (aElemTy.isF16()) {
+      name = "llvm.amdgcn.wmma.f32.16x16x16.f16";
+      argTys = {opTy, opTy, accTy};
+    } else if (aElemTy.isBF16()) {
+      name = "llvm.amdgcn.wmma.f32.16x16x16.bf16";
+      argTys = {opTy, opTy, accTy};
+    } else {
+      assert(aElemTy.isInteger(8) && "unexpected WMMA operand type");
+      name = "llvm.amdgcn.wmma.i32.16x16x16.iu8";
+      argTys = {i1_ty, opTy, i1_ty, opTy, accTy, i1_ty};
+    }
+    auto mangle = [](Type ty) {
+      auto vecTy = ty.cast<VectorType>();
+      Type elemTy = vecTy.getElementType();
+      return ".v" + std::to_string(vecTy.getNumElements()) +
+             (elemTy.isa<FloatType>() ? "f" : "i") +
+             std::to_string(elemTy.getIntOrFloatBitWidth());
+    };
+    name += mangle(accTy);
+
+    auto moduleOp = rewriter.getInsertionBlock()
+                        ->getParentOp()
+                        ->getParentOfType<ModuleOp>();
+    auto funcOp = moduleOp.lookupSymbol<LLVM::LLVMFuncOp>(name);
+    if (!funcOp) {
+      OpBuilder::InsertionGuard guard(rewriter);
+      rewriter.setInsertionPointToStart(moduleOp.getBody());
+      funcOp = rewriter.create<LLVM::LLVMFuncOp>(
+          loc, name, LLVM::LLVMFunctionType::get(accTy, argTys));
+    }
+    return funcOp;
+  }
+
+  Value generateWMMAOp(LLVM::LLVMFuncOp funcOp, Type aElemTy, Value valA,
+                       Value valB, Value valC) const {
+    if (aElemTy.isInteger(8)) {
+      // Signed operands, no saturation of the result
+      Value isSigned = int_val(1, 1);
+      Value clamp = int_val(1, 0);
+      return call(funcOp, ValueRange{isSigned, valA, isSigned, valB, valC,
+                                     clamp})
+          .getResult();
+    }
+    return call(funcOp, ValueRange{valA, valB, valC}).getResult();
+  }
+
+  // Conduct the Dot conversion.
+  LogicalResult convertDot(DotOp op, DotOpAdaptor adaptor) const {
+    Value a = op.getA();
+    Value b = op.getB();
+    Value d = op.getD();
+    auto aTensorTy = a.getType().cast<RankedTensorType>();
+    auto bTensorTy = b.getType().cast<RankedTensorType>();
+    auto dTensorTy = d.getType().cast<RankedTensorType>();
+    auto aElemTy = aTensorTy.getElementType();
+
+    auto aEncoding = aTensorTy.getEncoding().cast<DotOperandEncodingAttr>();
+    auto bEncoding = bTensorTy.getEncoding().cast<DotOperandEncodingAttr>();
+
+    auto repA = aEncoding.getWMMARep(aTensorTy.getShape());
+    auto repB = bEncoding.getWMMARep(bTensorTy.getShape());
+
+    assert(repA[1] == repB[0]);
+
+    Value loadedA = adaptor.getA();
+    Value loadedB = adaptor.getB();
+    Value loadedC = adaptor.getC();
+
+    auto numRepM = repA[0];
+    auto numRepN = repB[1];
+    auto numRepK = repA[1];
+
+    ValueTable ha = getValuesFromDotOperandLayoutStruct(
+        loadedA, numRepM, numRepK, aTensorTy.getElementType());
+    ValueTable hb = getValuesFromDotOperandLayoutStruct(
+        loadedB, numRepN, numRepK, aTensorTy.getElementType());
+    auto dstElemTy = dTensorTy.getElementType();
+    auto fc =
+        typeConverter->unpackLLElements(loc, loadedC, rewriter, dstElemTy);
+
+    // compute number of output elements that each thread holds for one WMMA
+    // instruction
+    unsigned warpSize = wmmaLayout.getWarpSize();
+    auto elemsPerVec = 16 * 16 / warpSize;
+
+    auto vecTy = vec_ty(dstElemTy, elemsPerVec);
+    auto funcOp = getIntrinsic(aElemTy, ha[{0, 0}].getType(), vecTy);
+    for (int m = 0; m < numRepM; ++m) {
+      for (int n = 0; n < numRepN; ++n) {
+        Value acc = undef(vecTy);
+        for (unsigned v = 0; v < elemsPerVec; ++v) {
+          acc = insert_element(
+              vecTy, acc, fc[m * numRepN * elemsPerVec + n * elemsPerVec + v],
+              i32_val(v));
+        }
+
+        for (size_t k = 0; k < numRepK; k++)
+          acc = generateWMMAOp(funcOp, aElemTy, ha[{m, k}], hb[{n, k}], acc);
+
+        for (unsigned v = 0; v < elemsPerVec; ++v) {
+          fc[m * numRepN * elemsPerVec + n * elemsPerVec + v] =
+              extract_element(dstElemTy, acc, i32_val(v));
+        }
+      }
+    }
+
+    // replace with new packed result
+    Type structTy = LLVM::LLVMStructType::getLiteral(
+        ctx, SmallVector<Type>(fc.size(), dstElemTy));
+    Value res = typeConverter->packLLElements(loc, fc, rewriter, structTy);
+    rewriter.replaceOp(op, res);
+
+    return success();
+  }
+
+  ValueTable getValuesFromDotOperandLayoutStruct(Value value, int n0, int n1,
+                                                 Type type) const {
+    auto elems = typeConverter->unpackLLElements(loc, value, rewriter, type);
+    ValueTable vals;
+    for (int i = 0; i < n0; i++) {
+      for (int j = 0; j < n1; j++) {
+        vals[{i, j}] = elems[n1 * i + j];
+      }
+    }
+    return vals;
+  }
+};
+
+} // namespace
+
+LogicalResult convertWMMA(triton::DotOp op, triton::DotOp::Adaptor adaptor,
+                          TritonGPUToLLVMTypeConverter *typeConverter,
+                          ConversionPatternRewriter &rewriter) {
+  auto rankedTType = [](Value tensor) {
+    return tensor.getType().cast<RankedTensorType>();
+  };
+
+  assert(rankedTType(op.getA()).getEncoding().isa<DotOperandEncodingAttr>() &&
+         rankedTType(op.getB()).getEncoding().isa<DotOperandEncodingAttr>() &&
+         "Both $a and %b should be DotOperand layout.");
+
+  auto cTensorTy = rankedTType(op.getC());
+  auto dTensorTy = rankedTType(op.getD());
+  assert(cTensorTy.getEncoding().isa<WmmaEncodingAttr>() &&
+         "Currently, we only support $c with a wmma layout.");
+
+  assert(cTensorTy.getShape()[0] == dTensorTy.getShape()[0] &&
+         cTensorTy.getShape()[1] == dTensorTy.getShape()[1] &&
+         "DotOp's $c operand should pass the same number of values as $d");
+
+  auto loc = op.getLoc();
+  auto wmmaLayout = op.getResult()
+                        .getType()
+                        .cast<RankedTensorType>()
+                        .getEncoding()
+                        .cast<WmmaEncodingAttr>();
+
+  DotOpWMMAConversionHelper helper(wmmaLayout, rewriter, typeConverter, loc);
+
+  return helper.convertDot(op, adaptor);
+}
+
+#endif // ifdef USE_ROCM
@@ -16,11 +16,21 @@ using namespace mlir::triton;
 using ::mlir::LLVM::delinearize;
 using ::mlir::LLVM::getSharedMemoryObjectFromStruct;
 using ::mlir::LLVM::linearize;
+using ::mlir::LLVM::permuteLanes;
 using ::mlir::triton::gpu::getCTALayout;
 using ::mlir::triton::gpu::getShapePerCTA;
 using ::mlir::triton::gpu::getTotalElemsPerThread;
 using ::mlir::triton::gpu::SharedEncodingAttr;
 
+#ifdef USE_ROCM
+// AMD GPUs access global memory with up to dwordx4 (128-bit) instructions, so
+// a whole vector is emitted as one load or store.
+constexpr size_t kMaxGlobalWordWidth = 128;
+#else
+// PTX vector loads and stores are built out of at most 32-bit words.
+constexpr size_t kMaxGlobalWordWidth = 32;
+#endif
+
 // Contains some helper functions for both Load and Store conversions.
 struct LoadStoreConversionBase {
   explicit LoadStoreConversionBase(ModuleAxisInfoAnalysis &axisAnalysisPass)
@@ -59,9 +69,11 @@ struct LoadOpConversion
 
   LoadOpConversion(TritonGPUToLLVMTypeConverter &converter,
                    ModuleAxisInfoAnalysis &axisAnalysisPass,
+                   const UniformityAnalysis *uniformityAnalysis,
                    PatternBenefit benefit)
       : ConvertTritonGPUOpToLLVMPattern<triton::LoadOp>(converter, benefit),
-        LoadStoreConversionBase(axisAnalysisPass) {}
+        LoadStoreConversionBase(axisAnalysisPass),
+        uniformityAnalysis(uniformityAnalysis) {}
 
   LogicalResult
   matchAndRewrite(triton::LoadOp op, OpAdaptor adaptor,
@@ -121,6 +133,22 @@ struct LoadOpConversion
                                                         other.getType());
     }
 
+#ifdef USE_ROCM
+    // Every element reads the same address: load it once through the scalar
+    // unit and share the value, instead of issuing a vector load per element.
+    if (isUniformLoad(op) && valueElemTy.getIntOrFloatBitWidth() >= 8) {
+      Value loaded = loadUniform(loc, rewriter, valueElemTy, ptrElems[0],
+                                 mask ? maskElems[0] : Value(),
+                                 other ? otherElems[0] : Value());
+      SmallVector<Value> loadedVals(numElems, loaded);
+      Type llvmResultStructTy = getTypeConverter()->convertType(valueTy);
+      Value resultStruct = getTypeConverter()->packLLElements(
+          loc, loadedVals, rewriter, llvmResultStructTy);
+      rewriter.replaceOp(op, {resultStruct});
+      return success();
+    }
+#endif
+
     // vectorized iteration through all the pointer/mask/other elements
     const int valueElemNBits =
         std::max(8u, valueElemTy.getIntOrFloatBitWidth());
@@ -131,7 +159,8 @@ struct LoadOpConversion
       // TODO: optimization when ptr is GEP with constant offset
       size_t in_off = 0;
 
-      const size_t maxWordWidth = std::max<size_t>(32, valueElemNBits);
+      const size_t maxWordWidth =
+          std::max<size_t>(kMaxGlobalWordWidth, valueElemNBits);
       const size_t totalWidth = valueElemNBits * vec;
       const size_t width = std::min(totalWidth, maxWordWidth);
       const size_t nWords = std::max<size_t>(1, totalWidth / width);
@@ -149,7 +178,10 @@ struct LoadOpConversion
         auto loaded = rewriter.create<scf::IfOp>(
             loc, pred,
             [&](OpBuilder &builder, Location loc) {
-              auto loadVal = builder.create<LLVM::LoadOp>(loc, ptr);
+              // `vec` already accounts for the pointer alignment, so the
+              // word can be loaded as a single dwordx2/dwordx4 access.
+              auto loadVal = builder.create<LLVM::LoadOp>(
+                  loc, ptr, /*alignment=*/width / 8);
               builder.create<mlir::scf::YieldOp>(loc, ValueRange({loadVal}));
             },
             [&](OpBuilder &builder, Location loc) {
@@ -302,6 +334,47 @@ struct LoadOpConversion
     rewriter.replaceOp(op, {resultStruct});
     return success();
   }
+
+private:
+  bool isUniformLoad(triton::LoadOp op) const {
+    if (!uniformityAnalysis || !op.getType().isa<RankedTensorType>())
+      return false;
+    return uniformityAnalysis->isUniform(op.getResult()) &&
+           llvm::all_of(op->getOperands(), [&](Value operand) {
+             return uniformityAnalysis->isUniform(operand);
+           });
+  }
+
+  // Loads a single element whose address, mask and `other` value are the
+  // same in every lane. Broadcasting the operands with readfirstlane tells the
+  // backend they are wave-uniform, which lets it select a scalar (s_load)
+  // load and keep the result in an SGPR.
+  Value loadUniform(Location loc, ConversionPatternRewriter &rewriter,
+                    Type valueElemTy, Value ptrElem, Value maskElem,
+                    Value otherElem) const {
+    unsigned width = valueElemTy.getIntOrFloatBitWidth();
+    Type wordTy = IntegerType::get(getContext(), width);
+    Value ptr = addrspacecast(LLVM::readFirstLane(loc, rewriter, ptrElem),
+                              ptr_ty(wordTy));
+    Value pred = maskElem ? LLVM::readFirstLane(loc, rewriter, maskElem)
+                          : int_val(1, 1);
+    Value falseVal = otherElem ? bitcast(LLVM::readFirstLane(loc, rewriter,
+                                                             otherElem),
+                                         wordTy)
+                               : int_val(width, 0);
+    auto loaded = rewriter.create<scf::IfOp>(
+        loc, pred,
+        [&](OpBuilder &builder, Location loc) {
+          auto loadVal = builder.create<LLVM::LoadOp>(loc, ptr);
+          builder.create<mlir::scf::YieldOp>(loc, ValueRange({loadVal}));
+        },
+        [&](OpBuilder &builder, Location loc) {
+          builder.create<mlir::scf::YieldOp>(loc, ValueRange({falseVal}));
+        });
+    return bitcast(loaded->getResult(0), valueElemTy);
+  }
+
+  const UniformityAnalysis *uniformityAnalysis;
 };
 
 struct StoreOpConversion
@@ -354,6 +427,26 @@ struct StoreOpConversion
       vec = std::min(vec, maskAlign);
     }
 
+#ifdef USE_ROCM
+    // MFMA accumulators hold at most 4 consecutive elements per lane: gather
+    // wider vectors by exchanging elements between lanes.
+    if (auto valueTensorTy = valueTy.dyn_cast<RankedTensorType>()) {
+      auto ptrTy = ptr.getType().cast<RankedTensorType>();
+      unsigned maxVec =
+          std::min<unsigned>(128 / triton::getPointeeBitWidth(ptrTy),
+                             axisAnalysisPass.getPtrAlignment(ptr));
+      if (llMask)
+        maxVec = std::min(maxVec, getMaskAlignment(op.getMask()));
+      if (auto vectorization =
+              getMfmaStoreVectorization(valueTensorTy, maxVec)) {
+        vectorizeMfmaStore(loc, rewriter, *vectorization,
+                           triton::gpu::getWarpSize(ptrTy.getEncoding()),
+                           valueElems, ptrElems, maskElems);
+        vec = vectorization->getVectorSize();
+      }
+    }
+#endif
+
     Value mask = getMask(valueTy, rewriter, loc);
     const size_t dtsize =
         std::max<int>(1, valueElemTy.getIntOrFloatBitWidth() / 8);
@@ -364,7 +457,7 @@ struct StoreOpConversion
       // TODO: optimization when ptr is AddPtr with constant offset
       size_t in_off = 0;
 
-      const size_t maxWordWidth = std::max<size_t>(32, valueElemNBits);
+      const size_t maxWordWidth = std::max<size_t>(kMaxGlobalWordWidth, valueElemNBits);
       const size_t totalWidth = valueElemNBits * vec;
       const size_t width = std::min(totalWidth, maxWordWidth);
       const size_t nWords = std::max<size_t>(1, totalWidth / width);
@@ -395,12 +488,16 @@ struct StoreOpConversion
         llWord = bitcast(llWord, valArgTy);
 #ifdef USE_ROCM
         Value maskVal = llMask ? and_(mask, maskElems[vecStart]) : mask;
-        rewriter.create<scf::IfOp>(loc, maskVal,
-                                     [&](OpBuilder &builder, Location loc){
-                                       auto storeOp = builder.create<LLVM::StoreOp>(loc, llWord, ptrElems[vecStart + wordIdx * wordNElems]);
-                                       builder.create<scf::YieldOp>(loc);
-                                     },
-                                     nullptr);
+        Value wordPtr = bitcast(ptrElems[vecStart + wordIdx * wordNElems],
+                                ptr_ty(valArgTy, 1));
+        rewriter.create<scf::IfOp>(
+            loc, maskVal,
+            [&](OpBuilder &builder, Location loc) {
+              builder.create<LLVM::StoreOp>(loc, llWord, wordPtr,
+                                            /*alignment=*/width / 8);
+              builder.create<scf::YieldOp>(loc);
+            },
+            nullptr);
 #else
         std::string constraint =
             (width == 64) ? "l" : ((width == 32) ? "r" : "c");
@@ -445,6 +542,85 @@ struct StoreOpConversion
     rewriter.eraseOp(op);
     return success();
   }
+
+#ifdef USE_ROCM
+  // Transpose the blocks of units of `vectorization` between their lanes and
+  // replace the elements, pointers and masks of the thread with the ones of
+  // the vectors it now holds.
+  void vectorizeMfmaStore(Location loc, ConversionPatternRewriter &rewriter,
+                          const MfmaStoreVectorization &vectorization,
+                          unsigned warpSize, SmallVector<Value> &valueElems,
+                          SmallVector<Value> &ptrElems,
+                          SmallVector<Value> &maskElems) const {
+    unsigned numLanes = vectorization.numLanes;
+    unsigned unitSize = vectorization.unitSize;
+    unsigned laneStride = vectorization.laneStride;
+    Value lane = urem(getThreadId(rewriter, loc), i32_val(warpSize));
+    Value pos = urem(udiv(lane, i32_val(laneStride)), i32_val(numLanes));
+    SmallVector<Value> isPos;
+    for (unsigned b = 0; b < numLanes; ++b)
+      isPos.push_back(icmp_eq(pos, i32_val(b)));
+
+    Type elemTy = valueElems[0].getType();
+    Type unitTy = unitSize == 1 ? elemTy : vec_ty(elemTy, unitSize);
+    SmallVector<Value> newValueElems, newPtrElems, newMaskElems;
+    for (const auto &block : vectorization.blocks) {
+      SmallVector<Value> units;
+      for (unsigned first : block) {
+        Value unit = valueElems[first];
+        if (unitSize > 1) {
+          unit = undef(unitTy);
+          for (unsigned e = 0; e < unitSize; ++e)
+            unit = insert_element(unitTy, unit, valueElems[first + e],
+                                  i32_val(e));
+        }
+        units.push_back(unit);
+      }
+      // Exchange the units whose position differs from the one of the lane in
+      // bit s with the lane across that bit. Afterwards, the unit at position
+      // b comes from the lane at position b.
+      for (unsigned s = 1; s < numLanes; s *= 2) {
+        Value hasBit = icmp_ne(and_(pos, i32_val(s)), i32_val(0));
+        Value srcLane = xor_(lane, i32_val(s * laneStride));
+        for (unsigned b = 0; b < numLanes; ++b) {
+          if (b & s)
+            continue;
+          Value send = select(hasBit, units[b], units[b + s]);
+          Value recv = permuteLanes(loc, rewriter, send, srcLane);
+          units[b] = select(hasBit, recv, units[b]);
+          units[b + s] = select(hasBit, units[b + s], recv);
+        }
+      }
+      for (Value unit : units) {
+        if (unitSize == 1) {
+          newValueElems.push_back(unit);
+          continue;
+        }
+        for (unsigned e = 0; e < unitSize; ++e)
+          newValueElems.push_back(extract_element(elemTy, unit, i32_val(e)));
+      }
+
+      // The lane kept its own unit at its position in the vector
+      Value ptr = ptrElems[block[0]];
+      Value mask = maskElems.empty() ? Value() : maskElems[block[0]];
+      for (unsigned b = 1; b < numLanes; ++b) {
+        ptr = select(isPos[b], ptrElems[block[b]], ptr);
+        if (mask)
+          mask = select(isPos[b], maskElems[block[b]], mask);
+      }
+      Type ptrTy = ptr.getType();
+      ptr = gep(ptrTy, ptr, mul(pos, i32_val(-static_cast<int>(unitSize))));
+      for (unsigned i = 0; i < numLanes * unitSize; ++i) {
+        newPtrElems.push_back(i == 0 ? ptr : gep(ptrTy, ptr, i32_val(i)));
+        if (mask)
+          newMaskElems.push_back(mask);
+      }
+    }
+    valueElems = newValueElems;
+    ptrElems = newPtrElems;
+    maskElems = newMaskElems;
+  }
+#endif
 };
 #ifndef USE_ROCM
 
@@ -1615,6 +1791,40 @@ struct InsertSliceAsyncOpConversion
     // single vector read into multiple ones
     auto numVecCols = std::max<unsigned>(inVec / outVec, 1);
 
+#ifdef USE_ROCM
+    // Only layouts accepted by supportDirectToLDS reach this point: each lane
+    // copies one dword per row, and the lanes of a wave write consecutive
+    // dwords of the unswizzled buffer. global_load_lds writes lane i's dword
+    // to M0 + 4 * i, so the wave-uniform base is recovered from any lane.
+    auto mod = op->getParentOfType<ModuleOp>();
+    unsigned warpSize = triton::gpu::TritonGPUDialect::getThreadsPerWarp(mod);
+    Value laneId = urem(getThreadId(rewriter, loc), i32_val(warpSize));
+    Value laneOffset = mul(laneId, i32_val(4));
+    unsigned dwordElems = 32 / resElemTy.getIntOrFloatBitWidth();
+    DenseMap<unsigned, Value> dwordPtrs =
+        getSwizzledSharedPtrs(loc, dwordElems, srcTy, resSharedLayout,
+                              resElemTy, smemObj, rewriter, offsetVals,
+                              srcStrides);
+    for (unsigned elemIdx = 0; elemIdx < numElems; elemIdx += dwordElems) {
+      Value dwordPtr = dwordPtrs[elemIdx];
+      Value ldsBase = sub(ptrtoint(i32_ty, dwordPtr), laneOffset);
+      ldsBase = inttoptr(ptr_ty(i8_ty, 3),
+                         LLVM::readFirstLane(loc, rewriter, ldsBase));
+      if (!llMask) {
+        LLVM::globalLoadLDS(loc, rewriter, srcElems[elemIdx], ldsBase);
+        continue;
+      }
+      // Masked lanes write zeros to their slot instead.
+      // XXX: Always assume other = 0 for now, as on the cp.async path.
+      auto ifOp = rewriter.create<scf::IfOp>(loc, maskElems[elemIdx],
+                                             /*withElseRegion=*/true);
+      rewriter.setInsertionPointToStart(ifOp.thenBlock());
+      LLVM::globalLoadLDS(loc, rewriter, srcElems[elemIdx], ldsBase);
+      rewriter.setInsertionPointToStart(ifOp.elseBlock());
+      store(i32_val(0), bitcast(dwordPtr, ptr_ty(i32_ty, 3)));
+      rewriter.setInsertionPointAfter(ifOp);
+    }
+#else
     auto srcIndices = emitIndices(loc, rewriter, srcBlockedLayout, srcTy);
 
     for (unsigned elemIdx = 0; elemIdx < numElems; elemIdx += minVec) {
@@ -1658,6 +1868,7 @@ struct InsertSliceAsyncOpConversion
         ptxBuilder.launch(rewriter, loc, void_ty(getContext()));
       }
     }
+#endif
 
     rewriter.replaceOp(op, llDst);
     return success();
@@ -2048,8 +2259,10 @@ void populateLoadStoreOpToLLVMPatterns(
     ModuleAllocation &allocation,
     ConvertTritonGPUOpToLLVMPatternBase::IndexCacheInfo &indexCacheInfo,
     mlir::triton::gpu::TMAMetadataTy *tmaMetadata,
-    const TensorPtrMapT *tensorPtrMap, PatternBenefit benefit) {
-  patterns.add<LoadOpConversion>(typeConverter, axisInfoAnalysis, benefit);
+    const TensorPtrMapT *tensorPtrMap, PatternBenefit benefit,
+    const UniformityAnalysis *uniformityAnalysis) {
+  patterns.add<LoadOpConversion>(typeConverter, axisInfoAnalysis,
+                                 uniformityAnalysis, benefit);
   patterns.add<StoreOpConversion>(typeConverter, axisInfoAnalysis, benefit);
   patterns.add<AtomicCASOpConversion>(typeConverter, allocation,
                                       axisInfoAnalysis, benefit);
@@ -2,6 +2,7 @@
 #define TRITON_CONVERSION_TRITONGPU_TO_LLVM_LOAD_STORE_OP_H
 
 #include "TritonGPUToLLVMBase.h"
+#include "triton/Analysis/Uniformity.h"
 
 using namespace mlir;
 using namespace mlir::triton;
@@ -12,6 +13,7 @@ void populateLoadStoreOpToLLVMPatterns(
     ModuleAllocation &allocation,
     ConvertTritonGPUOpToLLVMPatternBase::IndexCacheInfo &indexCacheInfo,
     mlir::triton::gpu::TMAMetadataTy *tmaMetadata,
-    const TensorPtrMapT *tensorPtrMap, PatternBenefit benefit);
+    const TensorPtrMapT *tensorPtrMap, PatternBenefit benefit,
+    const UniformityAnalysis *uniformityAnalysis = nullptr);
 
 #endif
@@ -14,6 +14,28 @@ using ::mlir::LLVM::storeShared;
 using ::mlir::triton::gpu::getOrder;
 using ::mlir::triton::gpu::getTotalElemsPerThread;
 
+// MFMA layouts give consecutive lanes to consecutive rows (transposed) or
+// columns of an instruction tile, and lane groups hold 4 consecutive values
+// each along the other dimension. Return the distance between the lanes
+// holding neighbouring values along `axis`.
+static unsigned getMfmaLaneStride(MfmaEncodingAttr mfmaLayout, unsigned axis) {
+  unsigned laneDim = mfmaLayout.getIsTransposed() ? 0 : 1;
+  if (axis == laneDim)
+    return 1;
+  return triton::gpu::getThreadsPerWarp(mfmaLayout)[laneDim];
+}
+
+// Order of the dimensions of the fast reduction scratch buffer: the reduction
+// axis comes first so that the partial results of a row are contiguous.
+static SmallVector<unsigned> getScratchOrderFast(Attribute layout,
+                                                 unsigned axis) {
+  SmallVector<unsigned> order = getOrder(layout);
+  auto it = llvm::find(order, axis);
+  order.erase(it);
+  order.insert(order.begin(), axis);
+  return order;
+}
+
 struct ReduceOpConversion
     : public ConvertTritonGPUOpToLLVMPattern<triton::ReduceOp> {
 public:
@@ -111,11 +133,6 @@ private:
     Value axisSizePerThread = ints[sizePerThread[axis]];
     Value _8 = ints[8];
     Value _16 = ints[16];
-#ifdef USE_ROCM
-    Value _2 = ints[2];
-    Value _4 = ints[4];
-    Value _32 = ints[32];
-#endif
 
     if (layout.isa<BlockedEncodingAttr>()) {
       // A single thread owns axisSizePerThread contiguous values
@@ -140,13 +157,27 @@ private:
         writeIdx[originalAxis] = udiv(index[originalAxis], axisSizePerThread);
       }
     } else if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>()) {
-      // TODO: Support MFMA transposed layout.
+      // Each instruction tile maps to threadsPerWarp[axis] entries of smem.
+      // Along the dimension indexed by lane % nonKDim the first value of a
+      // thread is at its lane; along the other one, lane groups hold 4
+      // consecutive values each. The mapping is:
+      // (tile index) x threadsPerWarp[axis] + (lane index along axis)
+      unsigned instrSize = mfmaLayout.getMFMAInstrShape()[axis];
+      unsigned threadsPerWarp = triton::gpu::getThreadsPerWarp(layout)[axis];
+      Value tile = udiv(index[axis], i32_val(instrSize));
+      Value inTile = urem(index[axis], i32_val(instrSize));
+      if (getMfmaLaneStride(mfmaLayout, axis) != 1)
+        inTile = udiv(inTile, i32_val(4));
+      writeIdx[axis] = add(mul(tile, i32_val(threadsPerWarp)), inTile);
+    } else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
       if (axis == 0) {
-        // Because warpTileSize = [32, 32] and threadsPerWarp = [2, 32], each 2
-        // rows in smem would correspond to a warp. The mapping
-        // is: (warp_index) x 2 + (row index within warp)
-        writeIdx[axis] = add(mul(udiv(index[axis], _32), _2),
-                             udiv(urem(index[axis], _32), _4));
+        // Each warp tile has 16 rows, and threadsPerWarp = [warpSize / 16,
+        // 16]: lanes hold the rows that are equal to their lane group
+        // modulo warpSize / 16. The mapping is:
+        // (warp_index) x (warpSize / 16) + (row index modulo warpSize / 16)
+        Value laneGroups = ints[wmmaLayout.getWarpSize() / 16];
+        writeIdx[axis] = add(mul(udiv(index[axis], _16), laneGroups),
+                             urem(index[axis], laneGroups));
       } else {
         // Same as BlockedEncodingAttr case
         writeIdx[axis] = udiv(index[axis], axisSizePerThread);
@@ -207,11 +238,6 @@ private:
     ints[sizePerThread[axis]] = i32_val(sizePerThread[axis]);
     ints[8] = i32_val(8);
     ints[16] = i32_val(16);
-#ifdef USE_ROCM
-    ints[2] = i32_val(2);
-    ints[4] = i32_val(4);
-    ints[32] = i32_val(32);
-#endif
     // reduce across threads
     for (auto it : accs) {
       const SmallVector<unsigned> &key = it.first;
@@ -386,11 +412,11 @@ private:
     }
   }
 
-  // Apply warp reduction across the given number of contiguous lanes using op
-  // region and the accumulator values as source.
+  // Apply warp reduction across the given number of lanes, `interleave` lanes
+  // apart, using op region and the accumulator values as source.
   void warpReduce(ConversionPatternRewriter &rewriter, Location loc,
                   SmallVector<Value> &acc, triton::ReduceOp op,
-                  unsigned numLaneToReduce) const {
+                  unsigned numLaneToReduce, unsigned interleave = 1) const {
     if (auto kind = matchReduxKind(op)) {
       // Based on benchmarking on A100 redux op gives a speed up only when doing
       // a single reduction (not partioned) and when the mask is static.
@@ -428,23 +454,7 @@ private:
 
     for (unsigned N = numLaneToReduce / 2; N > 0; N >>= 1) {
       SmallVector<Value> shfl(acc.size());
-      unsigned shuffleIdx = N;
-#ifdef USE_ROCM
-      auto srcTys = op.getInputTypes();
-      auto inputTy = srcTys[0].cast<RankedTensorType>();
-      auto inMfma =
-        inputTy.getEncoding().dyn_cast<triton::gpu::MfmaEncodingAttr>();
-      if (inMfma && inMfma.getIsTransposed()) {
-        assert(numLaneToReduce == 2 || numLaneToReduce == 4);
-        // for mfma 32x32 adjacent threads in y dimension in transposed MFMA
-        // layout are 32 apart: [[0 0 0 0 32 32 32 32 ...] [1 1 1 1 33 33 33 33
-        // ...] ...]. for mfma 16x16 adjacent threads in y dimension in
-        // transposed MFMA layout are 16 apart: [[0 0 0 0 16 16 16 16 32 32 32
-        // 32 ...] [1 1 1 1 33 33 33 33 ...] ...].
-        const int warpSize = 64;
-        shuffleIdx = warpSize / N / 2;
-      }
-#endif
+      unsigned shuffleIdx = N * interleave;
       for (unsigned i = 0; i < acc.size(); ++i) {
         shfl[i] = shflSync(loc, rewriter, acc[i], shuffleIdx);
       }
@@ -459,10 +469,13 @@ private:
                     ConversionPatternRewriter &rewriter) const {
     triton::ReduceOp op = helper.getOperation();
     unsigned sizeIntraWarps = helper.getIntraWarpSizeWithUniqueData();
+    unsigned interleave = 1;
+    if (auto mfmaLayout = helper.getSrcLayout().dyn_cast<MfmaEncodingAttr>())
+      interleave = getMfmaLaneStride(mfmaLayout, op.getAxis());
     for (auto it : accs) {
       const SmallVector<unsigned> &key = it.first;
       SmallVector<Value> &acc = accs[key];
-      warpReduce(rewriter, op.getLoc(), acc, op, sizeIntraWarps);
+      warpReduce(rewriter, op.getLoc(), acc, op, sizeIntraWarps, interleave);
     }
   }
 
@@ -530,23 +543,25 @@ private:
     SmallVector<Value> multiDimWarpId =
         delinearize(rewriter, loc, warpId, warpsPerCTA, order);
 
-#ifdef USE_ROCM
-    auto srcTys = op.getInputTypes();
-    auto inputTy = srcTys[0].cast<RankedTensorType>();
-    auto inMfma =
-        inputTy.getEncoding().dyn_cast<triton::gpu::MfmaEncodingAttr>();
-    // Original logic is buggy for warpsPerCTA=[2, 2], but works fine for
-    // warpsPerCTA=[4, 1] (that is used in flash attention, thus tested).
-    // TODO: Check whether this is the case for MMA layout as well, if yes, this
-    // should be fixed in the upstream repo.
-    if (inMfma) {
-      multiDimLaneId = delinearize(rewriter, loc, laneId, threadsPerWarp);
-      multiDimWarpId = delinearize(rewriter, loc, warpId, warpsPerCTA);
+    if (auto mfmaLayout = srcLayout.dyn_cast<MfmaEncodingAttr>()) {
+      // Lanes are laid out along the lane dimension of the instruction first,
+      // and warps along dimension 0 first. Delinearize with the full shapes
+      // and wrap the warps around the ones holding unique data.
+      SmallVector<unsigned> laneOrder =
+          getMfmaLaneStride(mfmaLayout, 0) == 1 ? SmallVector<unsigned>{0, 1}
+                                                : SmallVector<unsigned>{1, 0};
+      multiDimLaneId = delinearize(rewriter, loc, laneId,
+                                   triton::gpu::getThreadsPerWarp(mfmaLayout),
+                                   laneOrder);
+      multiDimWarpId = delinearize(rewriter, loc, warpId,
+                                   triton::gpu::getWarpsPerCTA(mfmaLayout));
+      multiDimWarpId[axis] =
+          urem(multiDimWarpId[axis], i32_val(warpsPerCTA[axis]));
     }
-#endif
 
     Value laneIdAxis = multiDimLaneId[axis];
     Value warpIdAxis = multiDimWarpId[axis];
+    auto smemOrder = getScratchOrderFast(srcLayout, axis);
 
     Value zero = i32_val(0);
     Value laneZero = icmp_eq(laneIdAxis, zero);
@@ -558,7 +573,7 @@ private:
       SmallVector<Value> writeIdx = indices[key];
       writeIdx[axis] = warpIdAxis;
       Value writeOffset =
-          linearize(rewriter, loc, writeIdx, smemShapes[0], order);
+          linearize(rewriter, loc, writeIdx, smemShapes[0], smemOrder);
       for (unsigned i = 0; i < op.getNumOperands(); ++i) {
         auto elemPtrTy = getElementPtrType(op, i);
         Value writePtr = gep(elemPtrTy, smemBases[i], writeOffset);
@@ -643,7 +658,7 @@ private:
     triton::ReduceOp op = helper.getOperation();
     Location loc = op.getLoc();
     auto smemShapes = helper.getScratchConfigsFast();
-    auto order = getOrder(helper.getSrcLayout());
+    auto smemOrder = getScratchOrderFast(helper.getSrcLayout(), op.getAxis());
     SmallVector<Value> results(op.getNumOperands());
     for (unsigned i = 0; i < op.getNumOperands(); ++i) {
       if (auto resultTy =
@@ -659,7 +674,7 @@ private:
           SmallVector<Value> readIdx = resultIndices[j];
           readIdx.insert(readIdx.begin() + op.getAxis(), i32_val(0));
           Value readOffset =
-              linearize(rewriter, loc, readIdx, smemShapes[0], order);
+              linearize(rewriter, loc, readIdx, smemShapes[0], smemOrder);
           Value readPtr =
               gep(getElementPtrType(op, i), smemBases[i], readOffset);
           resultVals[j] = load(readPtr);
@@ -698,15 +698,23 @@ struct AsyncWaitOpConversion
   LogicalResult
   matchAndRewrite(triton::gpu::AsyncWaitOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
-    PTXBuilder ptxBuilder;
-    auto &asyncWaitOp = *ptxBuilder.create<>("cp.async.wait_group");
     auto num = op->getAttrOfType<IntegerAttr>("num").getInt();
-    asyncWaitOp(ptxBuilder.newConstantOperand(num));
-
     auto ctx = op.getContext();
     auto loc = op.getLoc();
     auto voidTy = void_ty(ctx);
+#ifdef USE_ROCM
+    // Direct global to LDS loads are tracked by vmcnt; `num` has already
+    // been converted to a number of outstanding loads.
+    GCNBuilder gcnBuilder;
+    gcnBuilder.create<>("s_waitcnt vmcnt(" + std::to_string(num) + ")")
+        ->operator()();
+    gcnBuilder.launch(rewriter, loc, voidTy);
+#else
+    PTXBuilder ptxBuilder;
+    auto &asyncWaitOp = *ptxBuilder.create<>("cp.async.wait_group");
+    asyncWaitOp(ptxBuilder.newConstantOperand(num));
     ptxBuilder.launch(rewriter, loc, voidTy);
+#endif
 
     // Safe to remove the op since it doesn't have any return value.
     rewriter.eraseOp(op);
@@ -33,6 +33,7 @@ using ::mlir::triton::gpu::MfmaEncodingAttr;
 using ::mlir::triton::gpu::MmaEncodingAttr;
 using ::mlir::triton::gpu::SliceEncodingAttr;
 using ::mlir::triton::gpu::TMAMetadataTy;
+using ::mlir::triton::gpu::WmmaEncodingAttr;
 namespace ttng = ::mlir::triton::nvidia_gpu;
 
 typedef DenseMap<Operation *, triton::MakeTensorPtrOp> TensorPtrMapT;
@@ -692,6 +693,8 @@ public:
                                                           mmaLayout, type);
       } else if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>()) {
         result = emitBaseIndexForMfmaLayout(loc, rewriter, mfmaLayout, type);
+      } else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+        result = emitBaseIndexForWmmaLayout(loc, rewriter, wmmaLayout, type);
       } else if (auto sliceLayout = layout.dyn_cast<SliceEncodingAttr>()) {
         auto parentLayout = sliceLayout.getParent();
         auto parentShape = sliceLayout.paddedShape(type.getShape());
@@ -734,6 +737,9 @@ public:
     if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>()) {
       return emitOffsetForMfmaLayout(mfmaLayout, type);
     }
+    if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+      return emitOffsetForWmmaLayout(wmmaLayout, type);
+    }
     if (auto sliceLayout = layout.dyn_cast<SliceEncodingAttr>())
       return emitOffsetForSliceLayout(sliceLayout, type);
     llvm_unreachable("unsupported emitOffsetForLayout");
@@ -745,7 +751,8 @@ public:
                             unsigned ctaOffsetX, unsigned ctaOffsetY) const {
     auto nonKDim = mfmaLayout.getNonKDim();
     // MFMA output tile consists of repeated "dot operand B" layout groups along
-    // row axis. This variable defines number of these groups.
+    // row axis. This variable defines number of these groups. The blocks of
+    // 4x4 instructions are covered by the lane offsets.
     const unsigned numGroups = (nonKDim == 32 ? 4 : 1);
     const unsigned elemsPerThreadPerGroup = 4;
     auto warpSize = getWarpSize(mfmaLayout);
@@ -767,6 +774,21 @@ public:
       }
     }
   }
+
+  void emitWmmaOffsetForCTA(const WmmaEncodingAttr &wmmaLayout,
+                            SmallVector<SmallVector<unsigned>> &offsets,
+                            unsigned ctaOffsetX, unsigned ctaOffsetY) const {
+    // Lanes hold one column of the 16x16 tile, and every (warpSize / 16)-th
+    // row of it starting from their lane group.
+    unsigned warpSize = wmmaLayout.getWarpSize();
+    unsigned rowStride = warpSize / 16;
+    unsigned elemsPerThreadPerTile = 256 / warpSize;
+    auto shapePerCta = getShapePerCTATile(wmmaLayout);
+    for (unsigned elem = 0; elem < elemsPerThreadPerTile; elem++) {
+      offsets.push_back({ctaOffsetX * shapePerCta[0] + elem * rowStride,
+                         ctaOffsetY * shapePerCta[1]});
+    }
+  }
 #endif
 
   // -----------------------------------------------------------------------
@@ -794,6 +816,9 @@ public:
       } else if (auto mfma = layout.dyn_cast<MfmaEncodingAttr>()) {
         result = 
             emitIndicesForDistributedLayout(loc, b, mfma, type, withCTAOffset);
+      } else if (auto wmma = layout.dyn_cast<WmmaEncodingAttr>()) {
+        result =
+            emitIndicesForDistributedLayout(loc, b, wmma, type, withCTAOffset);
       } else if (auto slice = layout.dyn_cast<SliceEncodingAttr>()) {
         result =
             emitIndicesForDistributedLayout(loc, b, slice, type, withCTAOffset);
@@ -1161,19 +1186,20 @@ private:
     SmallVector<Value> warpsPerCTA = {i32_val(_warpsPerCTA[0]),
                                       i32_val(_warpsPerCTA[1])};
     int nonKDim = mfmaLayout.getNonKDim();
+    auto instrShape = mfmaLayout.getMFMAInstrShape();
 
     Value threadId = getThreadId(rewriter, loc);
     Value warpSize = i32_val(triton::gpu::getWarpSize(mfmaLayout));
     Value laneId = urem(threadId, warpSize);
 
     Value warpId = udiv(threadId, warpSize);
-    Value warpId0 =
-        urem(urem(warpId, warpsPerCTA[0]), i32_val(shape[0] / nonKDim));
+    Value warpId0 = urem(urem(warpId, warpsPerCTA[0]),
+                         i32_val(ceil<int64_t>(shape[0], instrShape[0])));
     Value warpId1 = urem(urem(udiv(warpId, warpsPerCTA[0]), warpsPerCTA[1]),
-                         i32_val(shape[1] / nonKDim));
+                         i32_val(ceil<int64_t>(shape[1], instrShape[1])));
 
-    Value offWarp0 = mul(warpId0, i32_val(nonKDim));
-    Value offWarp1 = mul(warpId1, i32_val(nonKDim));
+    Value offWarp0 = mul(warpId0, i32_val(instrShape[0]));
+    Value offWarp1 = mul(warpId1, i32_val(instrShape[1]));
 
     SmallVector<Value> multiDimBase(2);
     if (mfmaLayout.getIsTransposed()) {
@@ -1200,7 +1226,8 @@ private:
     for (unsigned d = 0; d < 2; ++d) {
       unsigned inPerCTA = std::min<unsigned>(tensorShape[d], shapePerCTA[d]);
       unsigned inPerWarp = ceil<unsigned>(inPerCTA, warpsPerCTA[d]);
-      numWarpsPerDim[d] = ceil<unsigned>(inPerWarp, mfmaLayout.getNonKDim());
+      numWarpsPerDim[d] =
+          ceil<unsigned>(inPerWarp, mfmaLayout.getMFMAInstrShape()[d]);
     }
 
     for (unsigned i = 0; i < numWarpsPerDim[0]; ++i) {
@@ -1211,6 +1238,62 @@ private:
     return offsets;
   }
 
+  // -----------------------------------------------------------------------
+  // Wmma layout indices
+  // -----------------------------------------------------------------------
+
+  SmallVector<Value>
+  emitBaseIndexForWmmaLayout(Location loc, ConversionPatternRewriter &rewriter,
+                             const WmmaEncodingAttr &wmmaLayout,
+                             RankedTensorType type) const {
+    auto shape = type.getShape();
+    auto _warpsPerCTA = wmmaLayout.getWarpsPerCTA();
+    assert(_warpsPerCTA.size() == 2);
+    SmallVector<Value> warpsPerCTA = {i32_val(_warpsPerCTA[0]),
+                                      i32_val(_warpsPerCTA[1])};
+
+    Value threadId = getThreadId(rewriter, loc);
+    Value warpSize = i32_val(wmmaLayout.getWarpSize());
+    Value laneId = urem(threadId, warpSize);
+
+    Value warpId = udiv(threadId, warpSize);
+    Value warpId0 = urem(urem(warpId, warpsPerCTA[0]),
+                         i32_val(ceil<int64_t>(shape[0], 16)));
+    Value warpId1 = urem(urem(udiv(warpId, warpsPerCTA[0]), warpsPerCTA[1]),
+                         i32_val(ceil<int64_t>(shape[1], 16)));
+
+    Value offWarp0 = mul(warpId0, i32_val(16));
+    Value offWarp1 = mul(warpId1, i32_val(16));
+
+    SmallVector<Value> multiDimBase(2);
+    multiDimBase[0] = add(udiv(laneId, i32_val(16)), offWarp0);
+    multiDimBase[1] = add(urem(laneId, i32_val(16)), offWarp1);
+    return multiDimBase;
+  }
+
+  SmallVector<SmallVector<unsigned>>
+  emitOffsetForWmmaLayout(const WmmaEncodingAttr &wmmaLayout,
+                          RankedTensorType type) const {
+    auto tensorShape = type.getShape();
+    SmallVector<SmallVector<unsigned>> offsets;
+    auto shapePerCTA = getShapePerCTA(wmmaLayout, tensorShape);
+    auto warpsPerCTA = wmmaLayout.getWarpsPerCTA();
+
+    SmallVector<unsigned> numWarpsPerDim(2);
+    for (unsigned d = 0; d < 2; ++d) {
+      unsigned inPerCTA = std::min<unsigned>(tensorShape[d], shapePerCTA[d]);
+      unsigned inPerWarp = ceil<unsigned>(inPerCTA, warpsPerCTA[d]);
+      numWarpsPerDim[d] = ceil<unsigned>(inPerWarp, 16);
+    }
+
+    for (unsigned i = 0; i < numWarpsPerDim[0]; ++i) {
+      for (unsigned j = 0; j < numWarpsPerDim[1]; ++j) {
+        emitWmmaOffsetForCTA(wmmaLayout, offsets, i, j);
+      }
+    }
+    return offsets;
+  }
+
   // Emit indices calculation within each ConversionPattern, and returns a
   // [elemsPerThread X rank] index matrix.
   SmallVector<SmallVector<Value>> emitIndicesForDistributedLayout(
@@ -15,15 +15,18 @@
 #include "mlir/Dialect/LLVMIR/ROCDLDialect.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "triton/Analysis/Alias.h"
 #include "triton/Analysis/Allocation.h"
 #include "triton/Analysis/AxisInfo.h"
 #include "triton/Analysis/Membar.h"
+#include "triton/Analysis/Uniformity.h"
 #include "triton/Dialect/Triton/IR/Dialect.h"
 #include "triton/Dialect/TritonGPU/IR/Dialect.h"
 #ifndef USE_ROCM
 #else
 #include "triton/Dialect/TritonNvidiaGPU/IR/Dialect.h"
 #endif
+#include "triton/Tools/Sys/GetEnv.hpp"
 #include "triton/Tools/Sys/GetPlatform.hpp"
 
 #include "BarrierOpToLLVM.h"
@@ -218,6 +221,14 @@ struct FuncOpConversion : public FuncOpConversionBase {
       return failure();
     }
 
+    // Forward the user's no-alias promises to LLVM. Among other things, this
+    // lets the AMDGPU backend prove that uniform loads are not clobbered and
+    // select scalar loads for them.
+    for (unsigned i = 0; i < funcOp.getNumArguments(); ++i)
+      if (funcOp.getArgAttr(i, GlobalMemoryAliasAnalysis::noAliasAttrName))
+        newFuncOp.setArgAttr(i, LLVM::LLVMDialect::getNoAliasAttrName(),
+                             rewriter.getUnitAttr());
+
     auto ctx = funcOp->getContext();
 
     if (allocation.isRoot(funcOp)) {
@@ -493,6 +504,13 @@ struct ConvertTritonGPUToLLVM
     }
 
     ModuleAxisInfoAnalysis axisInfoAnalysis(mod);
+    // Wave-uniform loads are only specialized on AMD GPUs, where they can go
+    // through the scalar unit.
+    std::optional<UniformityAnalysis> uniformityAnalysis;
+#ifdef USE_ROCM
+    if (!::triton::tools::getBoolEnv("DISABLE_UNIFORMITY_ANALYSIS"))
+      uniformityAnalysis.emplace(mod, axisInfoAnalysis);
+#endif
 
     // Emit logics to get threadId/blockIds/linearized clusterCTAId etc. and
     // cache the values. The reason to do it here is that cluster_ctaid is
@@ -531,7 +549,8 @@ struct ConvertTritonGPUToLLVM
     auto populatePatterns3 = [&](auto populateFunc) {
       populateFunc(typeConverter, patterns, numWarps, axisInfoAnalysis,
                    allocation, indexCacheInfo, tmaMetadata, &tensorPtrMap,
-                   /*benefit*/ 10);
+                   /*benefit*/ 10,
+                   uniformityAnalysis ? &*uniformityAnalysis : nullptr);
     };
 
     auto populatePatterns4 = [&](auto populateFunc) {
@@ -542,7 +561,9 @@ struct ConvertTritonGPUToLLVM
 
     populatePatterns1(populateTritonGPUToLLVMPatterns);
     populatePatterns1(populateConvertLayoutOpToLLVMPatterns);
-    populatePatterns2(populateDotOpToLLVMPatterns);
+    populateDotOpToLLVMPatterns(typeConverter, patterns, numWarps,
+                                axisInfoAnalysis, allocation, matrixCoreVersion,
+                                /*benefit*/ 10);
     populatePatterns4(populateElementwiseOpToLLVMPatterns);
     populatePatterns3(populateLoadStoreOpToLLVMPatterns);
     populatePatterns4(populateReduceOpToLLVMPatterns);
@@ -583,6 +604,11 @@ struct ConvertTritonGPUToLLVM
         id.replaceAllUsesWith(zero);
       });
     }
+
+#ifdef USE_ROCM
+    if (failed(insertInstructionSchedHints(mod)))
+      return signalPassFailure();
+#endif
   }
 
 private:
@@ -691,21 +717,27 @@ private:
   void decomposeMfmaToDotOperand(ModuleOp mod, int numWarps, int threadsPerWarp,
                                  int numCTAs) const {
     // Replace `mfma -> dot_op` with `mfma -> blocked -> dot_op`
-    // unless certain conditions are met
+    // unless certain conditions are met. `wmma -> dot_op` always goes through
+    // a blocked layout.
     mod.walk([&](triton::gpu::ConvertLayoutOp cvtOp) -> void {
       OpBuilder builder(cvtOp);
       auto srcType = cvtOp.getOperand().getType().cast<RankedTensorType>();
       auto dstType = cvtOp.getType().cast<RankedTensorType>();
       auto srcMfma =
           srcType.getEncoding().dyn_cast<triton::gpu::MfmaEncodingAttr>();
+      auto srcWmma =
+          srcType.getEncoding().dyn_cast<triton::gpu::WmmaEncodingAttr>();
       auto dstDotOp =
           dstType.getEncoding().dyn_cast<triton::gpu::DotOperandEncodingAttr>();
-      if (srcMfma && dstDotOp && !isMfmaToDotShortcut(srcType, dstType)) {
+      if (dstDotOp && ((srcMfma && !isMfmaToDotShortcut(srcType, dstType)) ||
+                       srcWmma)) {
+        Attribute srcLayout = srcType.getEncoding();
         auto tmpType = RankedTensorType::get(
             dstType.getShape(), dstType.getElementType(),
             triton::gpu::BlockedEncodingAttr::get(
-                mod.getContext(), srcType.getShape(), getSizePerThread(srcMfma),
-                getOrder(srcMfma), numWarps, threadsPerWarp, numCTAs));
+                mod.getContext(), srcType.getShape(),
+                getSizePerThread(srcLayout), getOrder(srcLayout), numWarps,
+                threadsPerWarp, numCTAs));
         auto tmp = builder.create<triton::gpu::ConvertLayoutOp>(
             cvtOp.getLoc(), tmpType, cvtOp.getOperand());
         auto newConvert = builder.create<triton::gpu::ConvertLayoutOp>(
@@ -910,6 +942,10 @@ private:
     // pipeline pass aware of the vectorization could introduce additional
     // dependencies on the AxisInfoAnalysis and the Coalesce analysis.
     bool decomposed = false;
+#ifdef USE_ROCM
+    // insert_slice_async => number of direct global to LDS loads per lane
+    DenseMap<Operation *, unsigned> numDirectCopies;
+#endif
     // insert_slice_async %src, %dst, %idx, %mask, %other
     // =>
     // %tmp = load %src, %mask, %other
@@ -950,6 +986,16 @@ private:
               .contains(byteWidth)) {
         return;
       }
+#else
+      // The shared layout is not swizzled on this path, so only the
+      // contiguity of the source matters.
+      if (supportDirectToLDS(srcTy, dstTy, inVec, matrixCoreVersion)) {
+        // One global_load_lds_dword per dword held by each lane
+        unsigned numCopies = triton::gpu::getTotalElemsPerThread(srcTy) *
+                             resElemTy.getIntOrFloatBitWidth() / 32;
+        numDirectCopies[insertSliceAsyncOp] = numCopies;
+        return;
+      }
 #endif
 
       // load
@@ -986,6 +1032,27 @@ private:
       decomposed = true;
     });
 
+#ifdef USE_ROCM
+    // There are no commit groups on AMD GPUs: direct global to LDS loads are
+    // counted by vmcnt like any other vector memory load, and complete in
+    // order. Waiting for all but the last N groups thus amounts to waiting
+    // until at most the number of loads issued by N groups are in flight.
+    // Take the smallest group, so that the count never includes loads of the
+    // groups being waited for.
+    std::optional<unsigned> minGroupSize;
+    mod.walk([&](Block *block) {
+      unsigned groupSize = 0;
+      for (Operation &op : *block) {
+        if (numDirectCopies.count(&op))
+          groupSize += numDirectCopies[&op];
+        else if (isa<triton::gpu::AsyncCommitGroupOp>(op)) {
+          minGroupSize = std::min(minGroupSize.value_or(groupSize), groupSize);
+          groupSize = 0;
+        }
+      }
+    });
+#endif
+
     mod.walk([&](triton::gpu::AsyncCommitGroupOp asyncCommitGroupOp) -> void {
       if (!triton::gpu::AsyncCommitGroupOp::isSupported(computeCapability))
         asyncCommitGroupOp.erase();
@@ -993,8 +1060,15 @@ private:
 
     mod.walk([&](triton::gpu::AsyncWaitOp asyncWaitOp) -> void {
 #ifdef USE_ROCM
-      // AsyncWait is not supported for ROCM and should be removed
-      asyncWaitOp.erase();
+      if (numDirectCopies.empty()) {
+        // Nothing is in flight once the decomposed loads have been stored
+        asyncWaitOp.erase();
+        return;
+      }
+      // vmcnt is a 6-bit counter on CDNA
+      unsigned vmcnt = std::min<unsigned>(
+          asyncWaitOp.getNum() * minGroupSize.value_or(0), 63);
+      asyncWaitOp.setNum(vmcnt);
 #else
       if (!triton::gpu::AsyncWaitOp::isSupported(computeCapability)) {
         // async wait is supported in Ampere and later
@@ -1011,6 +1085,117 @@ private:
     });
   }
 
+#ifdef USE_ROCM
+  // Masks of the instruction classes understood by sched_group_barrier
+  enum SchedGroupMask : int32_t {
+    MFMA = 0x008,
+    VMEM_READ = 0x020,
+    DS_READ = 0x100,
+    DS_WRITE = 0x200,
+  };
+
+  static std::optional<SchedGroupMask> getSchedGroup(Operation *op) {
+    if (op->getName().getStringRef().startswith("rocdl.mfma."))
+      return MFMA;
+    auto getAddrSpace = [](Value ptr) -> unsigned {
+      // Global accesses go through generic pointers on AMD GPUs
+      if (auto castOp = ptr.getDefiningOp<LLVM::AddrSpaceCastOp>())
+        ptr = castOp.getArg();
+      return ptr.getType().cast<LLVM::LLVMPointerType>().getAddressSpace();
+    };
+    if (auto loadOp = dyn_cast<LLVM::LoadOp>(op)) {
+      unsigned addrSpace = getAddrSpace(loadOp.getAddr());
+      if (addrSpace == 3)
+        return DS_READ;
+      if (addrSpace == 1)
+        return VMEM_READ;
+    }
+    if (auto storeOp = dyn_cast<LLVM::StoreOp>(op))
+      if (getAddrSpace(storeOp.getAddr()) == 3)
+        return DS_WRITE;
+    if (auto callOp = dyn_cast<LLVM::CallOp>(op))
+      if (callOp.getCallee() == "llvm.amdgcn.global.load.lds")
+        return VMEM_READ;
+    return std::nullopt;
+  }
+
+  // Interleaves memory instructions with the MFMA chain of dot loops. The
+  // AMDGPU backend otherwise tends to issue all LDS reads and global loads
+  // ahead of the MFMAs, so that neither is hidden behind the other.
+  //
+  // Hints only apply within a basic block, so they are computed for each
+  // sequence of operations between region-holding operations (masked
+  // accesses, which end up in their own blocks) and placed at its end:
+  //   * interleave-lds: each MFMA is followed by an even share of the LDS
+  //     reads;
+  //   * interleave-all: LDS writes and global loads are distributed as well.
+  LogicalResult insertInstructionSchedHints(ModuleOp mod) const {
+    if (schedVariant == "none")
+      return success();
+    SmallVector<SchedGroupMask> interleaved;
+    if (schedVariant == "interleave-lds")
+      interleaved = {DS_READ};
+    else if (schedVariant == "interleave-all")
+      interleaved = {DS_READ, VMEM_READ, DS_WRITE};
+    else
+      return mod.emitError("unknown instruction scheduling variant: ")
+             << schedVariant;
+
+    auto insertHints = [&](Operation *insertPt,
+                           DenseMap<int32_t, unsigned> &counts) {
+      unsigned numMfma = counts[MFMA];
+      if (numMfma == 0)
+        return;
+      OpBuilder builder(insertPt);
+      Location loc = insertPt->getLoc();
+      StringRef funcName = "llvm.amdgcn.sched.group.barrier";
+      auto funcOp = mod.lookupSymbol<LLVM::LLVMFuncOp>(funcName);
+      if (!funcOp) {
+        OpBuilder::InsertionGuard guard(builder);
+        builder.setInsertionPointToStart(mod.getBody());
+        auto i32Ty = builder.getI32Type();
+        funcOp = builder.create<LLVM::LLVMFuncOp>(
+            loc, funcName,
+            LLVM::LLVMFunctionType::get(
+                LLVM::LLVMVoidType::get(mod.getContext()),
+                {i32Ty, i32Ty, i32Ty}));
+      }
+      auto createGroup = [&](int32_t mask, unsigned size) {
+        if (size == 0)
+          return;
+        builder.create<LLVM::CallOp>(
+            loc, funcOp,
+            ValueRange{LLVM::createConstantI32(loc, builder, mask),
+                       LLVM::createConstantI32(loc, builder, size),
+                       LLVM::createConstantI32(loc, builder, 0)});
+      };
+      for (unsigned i = 0; i < numMfma; ++i) {
+        createGroup(MFMA, 1);
+        for (SchedGroupMask mask : interleaved) {
+          unsigned n = counts[mask];
+          createGroup(mask, n * (i + 1) / numMfma - n * i / numMfma);
+        }
+      }
+    };
+
+    SmallVector<Block *> blocks;
+    mod.walk([&](Block *block) { blocks.push_back(block); });
+    for (Block *block : blocks) {
+      DenseMap<int32_t, unsigned> counts;
+      for (Operation &op : *block) {
+        if (op.getNumRegions() > 0 || op.hasTrait<OpTrait::IsTerminator>()) {
+          insertHints(&op, counts);
+          counts.clear();
+          continue;
+        }
+        if (auto group = getSchedGroup(&op))
+          ++counts[*group];
+      }
+    }
+    return success();
+  }
+#endif
+
   static Value promoteOperand(OpBuilder &builder, Location loc, Value operand,
                               Type promotedType) {
     Type tensorPromotedType =
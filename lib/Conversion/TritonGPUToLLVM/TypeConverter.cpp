@@ -13,6 +13,7 @@ using ::mlir::triton::gpu::MfmaEncodingAttr;
 using ::mlir::triton::gpu::MmaEncodingAttr;
 using ::mlir::triton::gpu::SharedEncodingAttr;
 using ::mlir::triton::gpu::SliceEncodingAttr;
+using ::mlir::triton::gpu::WmmaEncodingAttr;
 
 TritonGPUToLLVMTypeConverter::TritonGPUToLLVMTypeConverter(
     MLIRContext *ctx, LowerToLLVMOptions &option,
@@ -164,17 +165,26 @@ Type TritonGPUToLLVMTypeConverter::getElementTypeForStruct(
     return elemTy;
 
 #ifdef USE_ROCM
+  // Each element holds the kWidth elements a lane loads for kPack
+  // instructions
   if (auto mfmaParent = dotOpLayout.getParent().dyn_cast<MfmaEncodingAttr>()) {
+    unsigned kWidth = dotOpLayout.getKWidth();
     if (elemTy.isF32())
-      return elemTy;
+      return kWidth > 1 ? vec_ty(elemTy, kWidth) : elemTy;
     if (elemTy.isInteger(16)) // aka BF16
-      return vec_ty(elemTy, dotOpLayout.getKWidth());
+      return vec_ty(elemTy, kWidth);
     if (elemTy.isF16())
-      return vec_ty(elemTy, 4);
-    if (elemTy.isInteger(8) && dotOpLayout.getKWidth() == 4)
-      return IntegerType::get(ctx, 32);
-    if (elemTy.isInteger(8) && dotOpLayout.getKWidth() == 8)
-      return IntegerType::get(ctx, 64);
+      return vec_ty(elemTy, kWidth);
+    if (elemTy.isInteger(8) && (kWidth == 4 || kWidth == 8))
+      return IntegerType::get(ctx, kWidth * 8);
+    if (elemTy.isInteger(8) && kWidth == 16)
+      return vec_ty(IntegerType::get(ctx, 64), 2);
+  }
+  // Each lane holds 16 elements along K per WMMA instruction
+  if (dotOpLayout.getParent().isa<WmmaEncodingAttr>()) {
+    if (elemTy.isInteger(8))
+      return vec_ty(IntegerType::get(ctx, 32), 4);
+    return vec_ty(elemTy, 16);
   }
 #endif
 
@@ -353,6 +353,121 @@ Value shflUpSync(Location loc, ConversionPatternRewriter &rewriter, Value val,
                  int i, Value laneId) {
   return commonShflSync(loc, rewriter, val, i, "up", "0x0", laneId);
 }
+Value readFirstLane(Location loc, ConversionPatternRewriter &rewriter,
+                    Value val) {
+  Type type = val.getType();
+  if (type.isa<LLVM::LLVMPointerType>())
+    return inttoptr(type, readFirstLane(loc, rewriter, ptrtoint(i64_ty, val)));
+
+  unsigned bits = type.getIntOrFloatBitWidth();
+  if (bits == 64) {
+    Type vecTy = vec_ty(i32_ty, 2);
+    Value vec = bitcast(val, vecTy);
+    Value val0 = extract_element(i32_ty, vec, i32_val(0));
+    Value val1 = extract_element(i32_ty, vec, i32_val(1));
+    val0 = readFirstLane(loc, rewriter, val0);
+    val1 = readFirstLane(loc, rewriter, val1);
+    vec = undef(vecTy);
+    vec = insert_element(vecTy, vec, val0, i32_val(0));
+    vec = insert_element(vecTy, vec, val1, i32_val(1));
+    return bitcast(vec, type);
+  }
+  assert(bits <= 32 && "readfirstlane operates on 32-bit values");
+
+  // The intrinsic operates on dwords.
+  Value i32Val = val;
+  if (!type.isInteger(bits))
+    i32Val = bitcast(i32Val, int_ty(bits));
+  if (bits < 32)
+    i32Val = zext(i32_ty, i32Val);
+
+  auto moduleOp =
+      rewriter.getInsertionBlock()->getParentOp()->getParentOfType<ModuleOp>();
+  StringRef funcName = "llvm.amdgcn.readfirstlane";
+  auto funcOp = moduleOp.lookupSymbol<LLVM::LLVMFuncOp>(funcName);
+  if (!funcOp) {
+    OpBuilder::InsertionGuard guard(rewriter);
+    rewriter.setInsertionPointToStart(moduleOp.getBody());
+    funcOp = rewriter.create<LLVM::LLVMFuncOp>(
+        loc, funcName, LLVM::LLVMFunctionType::get(i32_ty, {i32_ty}));
+  }
+  Value result = call(funcOp, ValueRange{i32Val}).getResult();
+
+  if (bits < 32)
+    result = trunc(int_ty(bits), result);
+  if (!type.isInteger(bits))
+    result = bitcast(result, type);
+  return result;
+}
+
+Value permuteLanes(Location loc, ConversionPatternRewriter &rewriter,
+                   Value val, Value srcLane) {
+  Type type = val.getType();
+  auto vecType = type.dyn_cast<VectorType>();
+  unsigned bits = vecType ? vecType.getNumElements() *
+                                vecType.getElementTypeBitWidth()
+                          : type.getIntOrFloatBitWidth();
+  if (bits > 32) {
+    assert(bits % 32 == 0 && "permuted values must be made of dwords");
+    Type vecTy = vec_ty(i32_ty, bits / 32);
+    Value vec = bitcast(val, vecTy);
+    Value result = undef(vecTy);
+    for (unsigned i = 0; i < bits / 32; ++i) {
+      Value dword = extract_element(i32_ty, vec, i32_val(i));
+      dword = permuteLanes(loc, rewriter, dword, srcLane);
+      result = insert_element(vecTy, result, dword, i32_val(i));
+    }
+    return bitcast(result, type);
+  }
+
+  // The intrinsic operates on dwords.
+  Value i32Val = val;
+  if (!type.isInteger(bits))
+    i32Val = bitcast(i32Val, int_ty(bits));
+  if (bits < 32)
+    i32Val = zext(i32_ty, i32Val);
+
+  auto moduleOp =
+      rewriter.getInsertionBlock()->getParentOp()->getParentOfType<ModuleOp>();
+  StringRef funcName = "llvm.amdgcn.ds.bpermute";
+  auto funcOp = moduleOp.lookupSymbol<LLVM::LLVMFuncOp>(funcName);
+  if (!funcOp) {
+    OpBuilder::InsertionGuard guard(rewriter);
+    rewriter.setInsertionPointToStart(moduleOp.getBody());
+    funcOp = rewriter.create<LLVM::LLVMFuncOp>(
+        loc, funcName, LLVM::LLVMFunctionType::get(i32_ty, {i32_ty, i32_ty}));
+  }
+  // ds_bpermute addresses the lanes in bytes
+  Value byteAddr = shl(srcLane, i32_val(2));
+  Value result = call(funcOp, ValueRange{byteAddr, i32Val}).getResult();
+
+  if (bits < 32)
+    result = trunc(int_ty(bits), result);
+  if (!type.isInteger(bits))
+    result = bitcast(result, type);
+  return result;
+}
+
+void globalLoadLDS(Location loc, ConversionPatternRewriter &rewriter,
+                   Value globalPtr, Value ldsBase) {
+  auto moduleOp =
+      rewriter.getInsertionBlock()->getParentOp()->getParentOfType<ModuleOp>();
+  StringRef funcName = "llvm.amdgcn.global.load.lds";
+  auto funcOp = moduleOp.lookupSymbol<LLVM::LLVMFuncOp>(funcName);
+  if (!funcOp) {
+    OpBuilder::InsertionGuard guard(rewriter);
+    rewriter.setInsertionPointToStart(moduleOp.getBody());
+    // (global ptr, lds base, size in bytes, imm offset, cache policy)
+    auto funcTy = LLVM::LLVMFunctionType::get(
+        void_ty(rewriter.getContext()),
+        {ptr_ty(i8_ty, 1), ptr_ty(i8_ty, 3), i32_ty, i32_ty, i32_ty});
+    funcOp = rewriter.create<LLVM::LLVMFuncOp>(loc, funcName, funcTy);
+  }
+  call(funcOp, ValueRange{bitcast(globalPtr, ptr_ty(i8_ty, 1)),
+                          bitcast(ldsBase, ptr_ty(i8_ty, 3)), i32_val(4),
+                          i32_val(0), i32_val(0)});
+}
+
 Value getSRegValue(OpBuilder &b, Location loc, const std::string &sRegStr) {
   PTXBuilder builder;
   auto &mov = builder.create("mov")->o("u32");
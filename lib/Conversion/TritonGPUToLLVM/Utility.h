@@ -333,6 +333,23 @@ Value shflSync(Location loc, ConversionPatternRewriter &rewriter, Value val,
 Value shflUpSync(Location loc, ConversionPatternRewriter &rewriter, Value val,
                  int i, Value laneId);
 
+// Broadcasts `val` from the first active lane to the whole wavefront. The
+// result is known to be wave-uniform, so the AMDGPU backend can keep it (and
+// values computed from it) in scalar registers.
+Value readFirstLane(Location loc, ConversionPatternRewriter &rewriter,
+                    Value val);
+
+// Returns the value `val` of lane `srcLane` with ds_bpermute. Values wider
+// than a dword are permuted one dword at a time.
+Value permuteLanes(Location loc, ConversionPatternRewriter &rewriter,
+                   Value val, Value srcLane);
+
+// Asynchronously copies one dword per lane from `globalPtr` to LDS. Lane i
+// writes to `ldsBase` + 4 * i, where `ldsBase` must be wave-uniform. The copy
+// is tracked by vmcnt.
+void globalLoadLDS(Location loc, ConversionPatternRewriter &rewriter,
+                   Value globalPtr, Value ldsBase);
+
 Value getSRegValue(OpBuilder &b, Location loc, const std::string &sRegStr);
 Value addStringToModule(Location loc, ConversionPatternRewriter &rewriter,
                         StringRef key, StringRef content);
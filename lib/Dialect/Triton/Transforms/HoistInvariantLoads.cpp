@@ -0,0 +1,99 @@
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/Pass/Pass.h"
+
+#include "triton/Analysis/Alias.h"
+#include "triton/Dialect/Triton/IR/Dialect.h"
+#include "triton/Dialect/Triton/Transforms/Passes.h"
+
+#include <memory>
+
+namespace mlir {
+#define GEN_PASS_DEF_TRITONHOISTINVARIANTLOADS
+#include "triton/Dialect/Triton/Transforms/Passes.h.inc"
+} // namespace mlir
+
+using namespace mlir;
+
+namespace {
+
+// Returns true if `forOp` is known to execute at least one iteration.
+bool hasPositiveTripCount(scf::ForOp forOp) {
+  auto lb = getConstantIntValue(forOp.getLowerBound());
+  auto ub = getConstantIntValue(forOp.getUpperBound());
+  return lb && ub && *lb < *ub;
+}
+
+class HoistInvariantLoadsPass
+    : public mlir::impl::TritonHoistInvariantLoadsBase<
+          HoistInvariantLoadsPass> {
+public:
+  void runOnOperation() override {
+    // Post-order: loads hoisted out of an inner loop become candidates for
+    // the enclosing loop.
+    getOperation().walk([&](scf::ForOp forOp) {
+      SmallVector<triton::LoadOp> loads;
+      for (Operation &op : forOp.getBody()->without_terminator())
+        if (auto loadOp = dyn_cast<triton::LoadOp>(&op))
+          if (isHoistable(forOp, loadOp))
+            loads.push_back(loadOp);
+      for (triton::LoadOp loadOp : loads)
+        hoist(forOp, loadOp);
+    });
+  }
+
+private:
+  bool isHoistable(scf::ForOp forOp, triton::LoadOp loadOp) {
+    if (loadOp.getIsVolatile())
+      return false;
+    // Block pointer loads cannot be predicated, so the loop must run.
+    if (triton::isTensorPointerType(loadOp.getPtr().getType()) &&
+        !hasPositiveTripCount(forOp))
+      return false;
+    if (!llvm::all_of(loadOp->getOperands(), [&](Value operand) {
+          return forOp.isDefinedOutsideOfLoop(operand);
+        }))
+      return false;
+    // The loaded value must not change across iterations.
+    WalkResult result = forOp.getBody()->walk([&](Operation *op) {
+      if (op != loadOp && aliasAnalysis.mayClobber(op, loadOp.getPtr()))
+        return WalkResult::interrupt();
+      return WalkResult::advance();
+    });
+    return !result.wasInterrupted();
+  }
+
+  void hoist(scf::ForOp forOp, triton::LoadOp loadOp) {
+    loadOp->moveBefore(forOp);
+    if (hasPositiveTripCount(forOp))
+      return;
+    // The loop may not execute at all, in which case the original program
+    // never dereferenced the pointer. Predicate the hoisted load on the loop
+    // being entered so that it cannot fault.
+    OpBuilder builder(loadOp);
+    Location loc = loadOp.getLoc();
+    Value entered =
+        builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::slt,
+                                      forOp.getLowerBound(),
+                                      forOp.getUpperBound());
+    Value mask = entered;
+    if (auto tensorTy = loadOp.getType().dyn_cast<RankedTensorType>()) {
+      auto maskTy = RankedTensorType::get(
+          tensorTy.getShape(), builder.getI1Type(), tensorTy.getEncoding());
+      mask = builder.create<triton::SplatOp>(loc, maskTy, entered);
+    }
+    if (Value oldMask = loadOp.getMask())
+      mask = builder.create<arith::AndIOp>(loc, oldMask, mask);
+    loadOp.getMaskMutable().assign(mask);
+  }
+
+  GlobalMemoryAliasAnalysis aliasAnalysis;
+};
+
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::createHoistInvariantLoadsPass() {
+  return std::make_unique<HoistInvariantLoadsPass>();
+}
@@ -0,0 +1,377 @@
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/TypeUtilities.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Pass/Pass.h"
+
+#include "triton/Dialect/Triton/IR/Dialect.h"
+#include "triton/Dialect/Triton/Transforms/Passes.h"
+
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/CheckedArithmetic.h"
+
+#include <memory>
+
+namespace mlir {
+#define GEN_PASS_DEF_TRITONNARROWINDICES
+#include "triton/Dialect/Triton/Transforms/Passes.h.inc"
+} // namespace mlir
+
+using namespace mlir;
+
+namespace {
+
+constexpr const char *kPointerRangeAttrName = "tt.pointer_range";
+
+// A conservative [min, max] bound of the values an integer may take.
+struct Range {
+  int64_t min;
+  int64_t max;
+
+  static Range full(unsigned bitWidth) {
+    if (bitWidth >= 64)
+      return {INT64_MIN, INT64_MAX};
+    if (bitWidth == 1)
+      return {0, 1};
+    return {-(int64_t(1) << (bitWidth - 1)), (int64_t(1) << (bitWidth - 1)) - 1};
+  }
+
+  bool fitsIn(unsigned bitWidth) const {
+    Range bound = full(bitWidth);
+    return min >= bound.min && max <= bound.max;
+  }
+
+  Range join(const Range &other) const {
+    return {std::min(min, other.min), std::max(max, other.max)};
+  }
+};
+
+unsigned getIntWidth(Value value) {
+  return getElementTypeOrSelf(value.getType()).getIntOrFloatBitWidth();
+}
+
+Type getI32Like(Type type) {
+  auto i32Ty = IntegerType::get(type.getContext(), 32);
+  if (auto tensorTy = type.dyn_cast<RankedTensorType>())
+    return RankedTensorType::get(tensorTy.getShape(), i32Ty,
+                                 tensorTy.getEncoding());
+  return i32Ty;
+}
+
+// Applies `fn` to every pair of bounds and returns the hull of the results,
+// or std::nullopt if one of them overflows.
+template <typename Fn>
+std::optional<Range> combineBounds(const Range &lhs, const Range &rhs, Fn fn) {
+  std::optional<Range> result;
+  for (int64_t a : {lhs.min, lhs.max})
+    for (int64_t b : {rhs.min, rhs.max}) {
+      std::optional<int64_t> value = fn(a, b);
+      if (!value)
+        return std::nullopt;
+      result = result ? result->join({*value, *value}) : Range{*value, *value};
+    }
+  return result;
+}
+
+class NarrowIndicesPass
+    : public mlir::impl::TritonNarrowIndicesBase<NarrowIndicesPass> {
+public:
+  void runOnOperation() override {
+    ranges.clear();
+    narrowed.clear();
+    replaced.clear();
+
+    SmallVector<triton::AddPtrOp> addPtrOps;
+    getOperation().walk([&](triton::AddPtrOp addPtrOp) {
+      if (getIntWidth(addPtrOp.getOffset()) == 64)
+        addPtrOps.push_back(addPtrOp);
+    });
+
+    for (triton::AddPtrOp addPtrOp : addPtrOps) {
+      Value offset = addPtrOp.getOffset();
+      if (!canNarrow(addPtrOp))
+        continue;
+      OpBuilder builder(addPtrOp);
+      Value newOffset = narrow(builder, offset);
+      // Truncating the offset itself saves nothing.
+      if (auto truncOp = newOffset.getDefiningOp<arith::TruncIOp>())
+        if (truncOp.getIn() == offset) {
+          narrowed.erase(offset);
+          truncOp->erase();
+          continue;
+        }
+      addPtrOp.getOffsetMutable().assign(newOffset);
+    }
+
+    // Drop the 64-bit computations that no longer have users.
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (Operation *op : llvm::reverse(replaced))
+        if (op && isOpTriviallyDead(op)) {
+          replaced.remove(op);
+          op->erase();
+          changed = true;
+          break;
+        }
+    }
+  }
+
+private:
+  // Offsets accumulate along chains of tt.addptr, so the offset of a single
+  // tt.addptr fitting in 32 bits is not enough: the total offset from the
+  // kernel argument must fit as well.
+  bool canNarrow(triton::AddPtrOp addPtrOp) {
+    Value base = stripShapeOps(addPtrOp.getPtr());
+    std::optional<Range> chain = getChainRange(base);
+    if (!chain)
+      return false;
+    Range offset = getRange(addPtrOp.getOffset());
+    std::optional<Range> total = addRanges(*chain, offset);
+    if (offset.fitsIn(32) && total && total->fitsIn(32))
+      return true;
+    // The hint only bounds the offsets of the pointers that are accessed. It
+    // covers this offset when it is the only one applied to the argument.
+    auto arg = base.dyn_cast<BlockArgument>();
+    return arg && hasPointerRangeHint(arg) &&
+           isOnlyDereferenced(addPtrOp.getResult());
+  }
+
+  static Value stripShapeOps(Value ptr) {
+    while (Operation *op = ptr.getDefiningOp()) {
+      if (!isa<triton::SplatOp, triton::BroadcastOp, triton::ExpandDimsOp,
+               triton::ViewOp, triton::TransOp>(op))
+        break;
+      ptr = op->getOperand(0);
+    }
+    return ptr;
+  }
+
+  static std::optional<Range> addRanges(const Range &lhs, const Range &rhs) {
+    return combineBounds(lhs, rhs, [](int64_t a, int64_t b) {
+      return llvm::checkedAdd(a, b);
+    });
+  }
+
+  // Returns the range of the total offset applied to the kernel argument
+  // `ptr` is derived from, or std::nullopt if `ptr` is not a chain of
+  // tt.addptr on a kernel argument (e.g. it is loop-carried).
+  std::optional<Range> getChainRange(Value ptr) {
+    ptr = stripShapeOps(ptr);
+    if (auto arg = ptr.dyn_cast<BlockArgument>()) {
+      if (isa<FunctionOpInterface>(arg.getOwner()->getParentOp()))
+        return Range{0, 0};
+      return std::nullopt;
+    }
+    auto addPtrOp = ptr.getDefiningOp<triton::AddPtrOp>();
+    if (!addPtrOp)
+      return std::nullopt;
+    std::optional<Range> chain = getChainRange(addPtrOp.getPtr());
+    if (!chain)
+      return std::nullopt;
+    return addRanges(*chain, getRange(addPtrOp.getOffset()));
+  }
+
+  // Returns true if `ptr` is only used as the address of memory accesses,
+  // so that no further offset is applied to it.
+  static bool isOnlyDereferenced(Value ptr) {
+    return llvm::all_of(ptr.getUsers(), [&](Operation *user) {
+      if (isa<triton::SplatOp, triton::BroadcastOp, triton::ExpandDimsOp,
+              triton::ViewOp, triton::TransOp>(user))
+        return isOnlyDereferenced(user->getResult(0));
+      return isa<triton::LoadOp, triton::StoreOp, triton::AtomicRMWOp,
+                 triton::AtomicCASOp>(user) &&
+             user->getOperand(0) == ptr;
+    });
+  }
+
+  // The argument promises that all the offsets applied to it fit in 32 bits.
+  static bool hasPointerRangeHint(BlockArgument arg) {
+    auto funcOp = dyn_cast<FunctionOpInterface>(arg.getOwner()->getParentOp());
+    if (!funcOp)
+      return false;
+    auto attr = funcOp.getArgAttrOfType<IntegerAttr>(arg.getArgNumber(),
+                                                     kPointerRangeAttrName);
+    return attr && attr.getInt() <= 32;
+  }
+
+  Range getRange(Value value) {
+    auto it = ranges.find(value);
+    if (it != ranges.end())
+      return it->second;
+    unsigned bitWidth = getIntWidth(value);
+    Range range = computeRange(value).value_or(Range::full(bitWidth));
+    // Values wrap around on overflow.
+    if (!range.fitsIn(bitWidth))
+      range = Range::full(bitWidth);
+    ranges[value] = range;
+    return range;
+  }
+
+  std::optional<Range> computeRange(Value value) {
+    if (auto arg = value.dyn_cast<BlockArgument>()) {
+      auto forOp = dyn_cast<scf::ForOp>(arg.getOwner()->getParentOp());
+      if (forOp && arg == forOp.getInductionVar())
+        return Range{getRange(forOp.getLowerBound()).min,
+                     getRange(forOp.getUpperBound()).max};
+      return std::nullopt;
+    }
+    Operation *op = value.getDefiningOp();
+    APInt intValue;
+    if (matchPattern(value, m_ConstantInt(&intValue))) {
+      int64_t c = intValue.getSExtValue();
+      return Range{c, c};
+    }
+    if (auto makeRangeOp = dyn_cast<triton::MakeRangeOp>(op))
+      return Range{makeRangeOp.getStart(), int64_t(makeRangeOp.getEnd()) - 1};
+    if (isa<triton::GetProgramIdOp>(op))
+      return Range{0, INT32_MAX};
+    if (isa<triton::GetNumProgramsOp>(op))
+      return Range{1, INT32_MAX};
+    if (isa<triton::SplatOp, triton::BroadcastOp, triton::ExpandDimsOp,
+            triton::ViewOp, triton::TransOp, arith::ExtSIOp, arith::TruncIOp>(
+            op))
+      return getRange(op->getOperand(0));
+    if (isa<arith::ExtUIOp>(op)) {
+      Range range = getRange(op->getOperand(0));
+      if (range.min >= 0)
+        return range;
+      return Range{0, (int64_t(1) << getIntWidth(op->getOperand(0))) - 1};
+    }
+    if (auto selectOp = dyn_cast<arith::SelectOp>(op))
+      return getRange(selectOp.getTrueValue())
+          .join(getRange(selectOp.getFalseValue()));
+    if (op->getNumOperands() != 2)
+      return std::nullopt;
+
+    Range lhs = getRange(op->getOperand(0));
+    Range rhs = getRange(op->getOperand(1));
+    if (isa<arith::AddIOp>(op))
+      return combineBounds(lhs, rhs, [](int64_t a, int64_t b) {
+        return llvm::checkedAdd(a, b);
+      });
+    if (isa<arith::SubIOp>(op))
+      return combineBounds(lhs, rhs, [](int64_t a, int64_t b) {
+        return llvm::checkedSub(a, b);
+      });
+    if (isa<arith::MulIOp>(op))
+      return combineBounds(lhs, rhs, [](int64_t a, int64_t b) {
+        return llvm::checkedMul(a, b);
+      });
+    if (isa<arith::DivSIOp>(op) && (rhs.min > 0 || rhs.max < 0))
+      return combineBounds(lhs, rhs, [](int64_t a, int64_t b) {
+        return std::optional<int64_t>(a / b);
+      });
+    // Only bound remainders by divisors known to be positive
+    if (isa<arith::RemSIOp>(op) && rhs.min > 0) {
+      int64_t bound = rhs.max - 1;
+      if (lhs.min >= 0)
+        return Range{0, std::min(bound, lhs.max)};
+      return Range{-bound, bound};
+    }
+    if (isa<arith::AndIOp>(op) && (lhs.min >= 0 || rhs.min >= 0))
+      return Range{0, lhs.min >= 0 ? lhs.max : rhs.max};
+    if (isa<arith::MaxSIOp>(op))
+      return Range{std::max(lhs.min, rhs.min), std::max(lhs.max, rhs.max)};
+    if (isa<arith::MinSIOp>(op))
+      return Range{std::min(lhs.min, rhs.min), std::min(lhs.max, rhs.max)};
+    if (isa<arith::ShLIOp>(op) && rhs.min >= 0 && rhs.max < 63)
+      return combineBounds(lhs, rhs, [](int64_t a, int64_t b) {
+        return llvm::checkedMul(a, int64_t(1) << b);
+      });
+    return std::nullopt;
+  }
+
+  // Returns an i32 value equal to `value` modulo 2^32. Additions,
+  // subtractions, multiplications and shifts commute with truncation, so they
+  // are recomputed in 32 bits; operations that do not (divisions,
+  // comparisons, ...) are only narrowed when their operands are known to fit
+  // in 32 bits. Anything else is truncated.
+  Value narrow(OpBuilder &builder, Value value) {
+    auto it = narrowed.find(value);
+    if (it != narrowed.end())
+      return it->second;
+    Value result = narrowImpl(builder, value);
+    narrowed[value] = result;
+    if (Operation *op = value.getDefiningOp())
+      replaced.insert(op);
+    return result;
+  }
+
+  Value narrowImpl(OpBuilder &builder, Value value) {
+    Type type = getI32Like(value.getType());
+    Location loc = value.getLoc();
+    Operation *op = value.getDefiningOp();
+    // Insert the narrowed op next to the original one so that it is defined
+    // wherever the original one is.
+    OpBuilder::InsertionGuard guard(builder);
+    if (op)
+      builder.setInsertionPoint(op);
+
+    auto truncate = [&]() -> Value {
+      if (auto arg = value.dyn_cast<BlockArgument>())
+        builder.setInsertionPointToStart(arg.getOwner());
+      else
+        builder.setInsertionPointAfter(op);
+      return builder.create<arith::TruncIOp>(loc, type, value);
+    };
+    if (!op)
+      return truncate();
+
+    if (isa<arith::ExtSIOp, arith::ExtUIOp>(op) &&
+        getIntWidth(op->getOperand(0)) == 32)
+      return op->getOperand(0);
+    DenseElementsAttr denseAttr;
+    if (matchPattern(value, m_Constant(&denseAttr)) && denseAttr.isSplat()) {
+      APInt splatValue = denseAttr.getSplatValue<APInt>().trunc(32);
+      return builder.create<arith::ConstantOp>(
+          loc, DenseElementsAttr::get(type.cast<RankedTensorType>(),
+                                      splatValue));
+    }
+    APInt intValue;
+    if (matchPattern(value, m_ConstantInt(&intValue)))
+      return builder.create<arith::ConstantOp>(
+          loc, builder.getIntegerAttr(type, intValue.trunc(32)));
+
+    bool isRingOp = isa<arith::AddIOp, arith::SubIOp, arith::MulIOp,
+                        triton::SplatOp, triton::BroadcastOp,
+                        triton::ExpandDimsOp, triton::ViewOp, triton::TransOp>(
+        op);
+    if (auto shlOp = dyn_cast<arith::ShLIOp>(op)) {
+      Range shift = getRange(shlOp.getRhs());
+      isRingOp = shift.min >= 0 && shift.max < 32;
+    }
+    bool isExactOp = isa<arith::DivSIOp, arith::RemSIOp, arith::MaxSIOp,
+                         arith::MinSIOp>(op) &&
+                     llvm::all_of(op->getOperands(), [&](Value operand) {
+                       return getRange(operand).fitsIn(32);
+                     });
+    if (auto selectOp = dyn_cast<arith::SelectOp>(op)) {
+      Value trueValue = narrow(builder, selectOp.getTrueValue());
+      Value falseValue = narrow(builder, selectOp.getFalseValue());
+      return builder.create<arith::SelectOp>(loc, selectOp.getCondition(),
+                                             trueValue, falseValue);
+    }
+    if (!isRingOp && !isExactOp)
+      return truncate();
+
+    SmallVector<Value> operands;
+    for (Value operand : op->getOperands())
+      operands.push_back(narrow(builder, operand));
+    OperationState state(loc, op->getName(), operands, {type},
+                         op->getAttrs());
+    return builder.create(state)->getResult(0);
+  }
+
+  DenseMap<Value, Range> ranges;
+  DenseMap<Value, Value> narrowed;
+  llvm::SetVector<Operation *> replaced;
+};
+
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::createNarrowIndicesPass() {
+  return std::make_unique<NarrowIndicesPass>();
+}
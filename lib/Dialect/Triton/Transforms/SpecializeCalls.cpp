@@ -0,0 +1,163 @@
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Pass/Pass.h"
+
+#include "triton/Analysis/AxisInfo.h"
+#include "triton/Dialect/Triton/IR/Dialect.h"
+#include "triton/Dialect/Triton/Transforms/Passes.h"
+
+#include "llvm/ADT/MapVector.h"
+#include "llvm/Support/Debug.h"
+
+#include <map>
+#include <memory>
+
+#define DEBUG_TYPE "triton-specialize-calls"
+
+namespace mlir {
+#define GEN_PASS_DEF_TRITONSPECIALIZECALLS
+#include "triton/Dialect/Triton/Transforms/Passes.h.inc"
+} // namespace mlir
+
+using namespace mlir;
+
+namespace {
+
+// Argument hints that ModuleAxisInfoAnalysis reads from and writes to callees.
+const char *const kAxisInfoArgAttrs[] = {"tt.contiguity", "tt.divisibility",
+                                         "tt.constancy"};
+
+// The call-site signature of a callee: (contiguity, divisibility, constancy)
+// of every integer or pointer operand, in operand order.
+using Signature = SmallVector<int64_t, 12>;
+
+Signature getSignature(ModuleAxisInfoAnalysis &axisInfoAnalysis,
+                       triton::CallOp callOp) {
+  Signature signature;
+  for (Value operand : callOp.getOperands()) {
+    if (!operand.getType().isa<IntegerType, triton::PointerType>())
+      continue;
+    AxisInfo *axisInfo = axisInfoAnalysis.getAxisInfo(operand);
+    if (!axisInfo) {
+      signature.append({1, 1, 1});
+      continue;
+    }
+    signature.push_back(axisInfo->getContiguity(0));
+    signature.push_back(axisInfo->getDivisibility(0));
+    signature.push_back(axisInfo->getConstancy(0));
+  }
+  return signature;
+}
+
+class SpecializeCallsPass
+    : public mlir::impl::TritonSpecializeCallsBase<SpecializeCallsPass> {
+public:
+  SpecializeCallsPass() = default;
+  SpecializeCallsPass(int maxClones) { this->maxClones = maxClones; }
+
+  void runOnOperation() override {
+    ModuleOp mod = getOperation();
+    origins.clear();
+    clonesPerOrigin.clear();
+    // Cloning a callee gives its own callees new, more precise call sites, so
+    // we iterate until no callee has diverging signatures left (or every
+    // callee has used up its clone budget).
+    while (specializeOnce(mod))
+      ;
+  }
+
+private:
+  // Drop the hints previously joined into non-root functions so that the
+  // analysis recomputes them from the current set of call sites instead of
+  // meeting with stale, coarser values.
+  void resetCalleeHints(ModuleOp mod) {
+    DenseSet<Operation *> callees;
+    SymbolTableCollection symbolTable;
+    mod.walk([&](triton::CallOp callOp) {
+      if (auto *callee = callOp.resolveCallable(&symbolTable))
+        callees.insert(callee);
+    });
+    for (Operation *op : callees) {
+      auto funcOp = cast<triton::FuncOp>(op);
+      for (unsigned i = 0; i < funcOp.getNumArguments(); ++i)
+        for (const char *attrName : kAxisInfoArgAttrs)
+          funcOp.removeArgAttr(i, StringAttr::get(&getContext(), attrName));
+    }
+  }
+
+  StringAttr getUniqueName(SymbolTable &symbolTable, triton::FuncOp funcOp) {
+    StringRef base = funcOp.getSymName();
+    unsigned suffix = 0;
+    std::string name;
+    do {
+      name = (base + "__spec" + Twine(suffix++)).str();
+    } while (symbolTable.lookup(name));
+    return StringAttr::get(&getContext(), name);
+  }
+
+  bool specializeOnce(ModuleOp mod) {
+    resetCalleeHints(mod);
+    ModuleAxisInfoAnalysis axisInfoAnalysis(mod);
+
+    // Group the call sites of every callee by signature, keeping the order in
+    // which signatures first appear so that the output is deterministic.
+    using SignatureGroups =
+        llvm::MapVector<Signature, SmallVector<Operation *>,
+                        std::map<Signature, unsigned>>;
+    llvm::MapVector<Operation *, SignatureGroups> callSites;
+    SymbolTableCollection symbolTableCollection;
+    mod.walk([&](triton::CallOp callOp) {
+      auto *callee = callOp.resolveCallable(&symbolTableCollection);
+      if (!isa_and_nonnull<triton::FuncOp>(callee))
+        return;
+      callSites[callee][getSignature(axisInfoAnalysis, callOp)].push_back(
+          callOp);
+    });
+
+    bool changed = false;
+    SymbolTable symbolTable(mod);
+    for (auto &[callee, groups] : callSites) {
+      if (groups.size() < 2)
+        continue;
+      auto funcOp = cast<triton::FuncOp>(callee);
+      StringAttr origin = getOrigin(funcOp);
+      // The first signature keeps the original function; each remaining one
+      // gets a clone while the budget lasts. Signatures beyond the budget
+      // share the original function and its joined hints.
+      for (auto &group : llvm::drop_begin(groups)) {
+        unsigned &numClones = clonesPerOrigin[origin];
+        if (numClones >= static_cast<unsigned>(maxClones))
+          break;
+        ++numClones;
+        auto clone = cast<triton::FuncOp>(funcOp->clone());
+        clone.setSymName(getUniqueName(symbolTable, funcOp));
+        symbolTable.insert(clone, std::next(funcOp->getIterator()));
+        origins[clone.getSymNameAttr()] = origin;
+        for (Operation *callOp : group.second)
+          callOp->setAttr("callee", SymbolRefAttr::get(clone));
+        LLVM_DEBUG(llvm::dbgs() << "specialized @" << funcOp.getSymName()
+                                << " as @" << clone.getSymName() << " for "
+                                << group.second.size() << " call site(s)\n");
+        changed = true;
+      }
+    }
+    return changed;
+  }
+
+  StringAttr getOrigin(triton::FuncOp funcOp) {
+    StringAttr name = funcOp.getSymNameAttr();
+    auto it = origins.find(name);
+    return it == origins.end() ? name : it->second;
+  }
+
+  // Maps every clone to the function it was (transitively) cloned from, so
+  // that the clone budget is shared by a function and all of its clones.
+  DenseMap<StringAttr, StringAttr> origins;
+  DenseMap<StringAttr, unsigned> clonesPerOrigin;
+};
+
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::createSpecializeCallsPass(int maxClones) {
+  return std::make_unique<SpecializeCallsPass>(maxClones);
+}
@@ -0,0 +1,208 @@
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Math/IR/Math.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/TypeUtilities.h"
+#include "mlir/Interfaces/LoopLikeInterface.h"
+#include "mlir/Pass/Pass.h"
+
+#include "triton/Analysis/AxisInfo.h"
+#include "triton/Dialect/Triton/IR/Dialect.h"
+#include "triton/Dialect/Triton/Transforms/Passes.h"
+
+#include <memory>
+
+namespace mlir {
+#define GEN_PASS_DEF_TRITONSTRENGTHREDUCEDIVREM
+#include "triton/Dialect/Triton/Transforms/Passes.h.inc"
+} // namespace mlir
+
+using namespace mlir;
+
+namespace {
+
+// Multiplier and shift such that, for every 0 <= n <= 2^31,
+//   n / |d| == (n * multiplier) >> shift
+// with shift = 31 + ceil(log2(|d|)) and multiplier = ceil(2^shift / |d|).
+// The multiplier fits in 32 bits, so the product fits in 64 bits.
+struct MagicNumbers {
+  Value multiplier; // i64
+  Value shift;      // i64
+};
+
+Value createConstant(OpBuilder &builder, Location loc, Type type,
+                     int64_t value) {
+  IntegerAttr attr = builder.getIntegerAttr(getElementTypeOrSelf(type), value);
+  if (auto tensorTy = type.dyn_cast<RankedTensorType>())
+    return builder.create<arith::ConstantOp>(
+        loc, DenseElementsAttr::get(tensorTy, attr.getValue()));
+  return builder.create<arith::ConstantOp>(loc, attr);
+}
+
+Type getI64Like(Type type) {
+  auto i64Ty = IntegerType::get(type.getContext(), 64);
+  if (auto tensorTy = type.dyn_cast<RankedTensorType>())
+    return RankedTensorType::get(tensorTy.getShape(), i64Ty,
+                                 tensorTy.getEncoding());
+  return i64Ty;
+}
+
+// Returns the scalar that is splatted into `value`, if any.
+Value getSplatSource(Value value) {
+  while (Operation *op = value.getDefiningOp()) {
+    if (auto splatOp = dyn_cast<triton::SplatOp>(op))
+      return splatOp.getSrc();
+    if (!isa<triton::BroadcastOp, triton::ExpandDimsOp>(op))
+      break;
+    value = op->getOperand(0);
+  }
+  return {};
+}
+
+class StrengthReduceDivRemPass
+    : public mlir::impl::TritonStrengthReduceDivRemBase<
+          StrengthReduceDivRemPass> {
+public:
+  void runOnOperation() override {
+    ModuleOp mod = getOperation();
+    ModuleAxisInfoAnalysis axisInfoAnalysis(mod);
+    SmallVector<std::pair<Operation *, Value>> candidates;
+    mod.walk([&](Operation *op) {
+      if (!isa<arith::DivSIOp, arith::RemSIOp>(op) ||
+          !getElementTypeOrSelf(op->getResult(0).getType()).isInteger(32))
+        return;
+      if (Value divisor = getUniformDivisor(axisInfoAnalysis, op))
+        candidates.emplace_back(op, divisor);
+    });
+    magicNumbers.clear();
+    for (auto [op, divisor] : candidates)
+      rewrite(op, getMagicNumbers(divisor));
+  }
+
+private:
+  // Returns the scalar the divisor of `op` is computed from if the magic
+  // numbers for it can be computed once, away from the division.
+  Value getUniformDivisor(ModuleAxisInfoAnalysis &axisInfoAnalysis,
+                          Operation *op) {
+    Value rhs = op->getOperand(1);
+    AxisInfo *axisInfo = axisInfoAnalysis.getAxisInfo(rhs);
+    // LLVM already strength-reduces divisions by constants.
+    if (!axisInfo || axisInfo->getConstantValue())
+      return {};
+    if (auto tensorTy = rhs.getType().dyn_cast<RankedTensorType>()) {
+      for (int d = 0; d < tensorTy.getRank(); ++d)
+        if (axisInfo->getConstancy(d) < tensorTy.getDimSize(d))
+          return {};
+      return getSplatSource(rhs);
+    }
+    // A single scalar division is cheaper than computing its magic numbers;
+    // it only pays off when they are hoisted out of a loop.
+    auto loopOp = op->getParentOfType<LoopLikeOpInterface>();
+    if (!loopOp || !loopOp.isDefinedOutsideOfLoop(rhs))
+      return {};
+    return rhs;
+  }
+
+  MagicNumbers getMagicNumbers(Value divisor) {
+    auto it = magicNumbers.find(divisor);
+    if (it != magicNumbers.end())
+      return it->second;
+
+    // Compute the magic numbers right after the divisor is defined, so that
+    // they are computed once per kernel for kernel arguments.
+    OpBuilder builder(divisor.getContext());
+    if (auto arg = divisor.dyn_cast<BlockArgument>())
+      builder.setInsertionPointToStart(arg.getOwner());
+    else
+      builder.setInsertionPointAfter(divisor.getDefiningOp());
+    Location loc = divisor.getLoc();
+    Type i32Ty = builder.getI32Type();
+    Type i64Ty = builder.getI64Type();
+
+    Value zero = createConstant(builder, loc, i32Ty, 0);
+    Value one = createConstant(builder, loc, i32Ty, 1);
+    Value isNeg = builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::slt,
+                                                divisor, zero);
+    Value neg = builder.create<arith::SubIOp>(loc, zero, divisor);
+    // |INT_MIN| wraps to 2^31, which is still correct when read as unsigned.
+    Value absDivisor =
+        builder.create<arith::SelectOp>(loc, isNeg, neg, divisor);
+    // ceil(log2(|d|)) = 32 - clz(|d| - 1)
+    Value clz = builder.create<math::CountLeadingZerosOp>(
+        loc, builder.create<arith::SubIOp>(loc, absDivisor, one));
+    Value log2 = builder.create<arith::SubIOp>(
+        loc, createConstant(builder, loc, i32Ty, 32), clz);
+    Value shift = builder.create<arith::ExtUIOp>(
+        loc, i64Ty,
+        builder.create<arith::AddIOp>(
+            loc, log2, createConstant(builder, loc, i32Ty, 31)));
+    // multiplier = (2^shift + |d| - 1) / |d|
+    // The magic numbers are computed ahead of the division they replace, which
+    // may be guarded against d == 0: divide by 1 then so that this is not UB.
+    // The result is unused in that case.
+    Value isZero = builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq,
+                                                 absDivisor, zero);
+    Value absDivisor64 = builder.create<arith::ExtUIOp>(
+        loc, i64Ty,
+        builder.create<arith::SelectOp>(loc, isZero, one, absDivisor));
+    Value one64 = createConstant(builder, loc, i64Ty, 1);
+    Value numerator = builder.create<arith::AddIOp>(
+        loc, builder.create<arith::ShLIOp>(loc, one64, shift),
+        builder.create<arith::SubIOp>(loc, absDivisor64, one64));
+    Value multiplier =
+        builder.create<arith::DivUIOp>(loc, numerator, absDivisor64);
+
+    MagicNumbers magic{multiplier, shift};
+    magicNumbers[divisor] = magic;
+    return magic;
+  }
+
+  // Rewrites n / d (or n % d) as
+  //   q = sign(n) * sign(d) * ((|n| * multiplier) >> shift)
+  //   r = n - q * d
+  // which rounds towards zero like arith.divsi/remsi.
+  void rewrite(Operation *op, MagicNumbers magic) {
+    OpBuilder builder(op);
+    Location loc = op->getLoc();
+    Value n = op->getOperand(0);
+    Value d = op->getOperand(1);
+    Type type = n.getType();
+    Type i64Type = getI64Like(type);
+    auto splat = [&](Value scalar) -> Value {
+      if (!i64Type.isa<RankedTensorType>())
+        return scalar;
+      return builder.create<triton::SplatOp>(loc, i64Type, scalar);
+    };
+
+    Value zero = createConstant(builder, loc, type, 0);
+    Value isNeg =
+        builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::slt, n, zero);
+    Value absN = builder.create<arith::SelectOp>(
+        loc, isNeg, builder.create<arith::SubIOp>(loc, zero, n), n);
+    Value product = builder.create<arith::MulIOp>(
+        loc, builder.create<arith::ExtUIOp>(loc, i64Type, absN),
+        splat(magic.multiplier));
+    Value absQ = builder.create<arith::TruncIOp>(
+        loc, type,
+        builder.create<arith::ShRUIOp>(loc, product, splat(magic.shift)));
+    Value signsDiffer = builder.create<arith::CmpIOp>(
+        loc, arith::CmpIPredicate::slt,
+        builder.create<arith::XOrIOp>(loc, n, d), zero);
+    Value q = builder.create<arith::SelectOp>(
+        loc, signsDiffer, builder.create<arith::SubIOp>(loc, zero, absQ),
+        absQ);
+    Value result = q;
+    if (isa<arith::RemSIOp>(op))
+      result = builder.create<arith::SubIOp>(
+          loc, n, builder.create<arith::MulIOp>(loc, q, d));
+    op->getResult(0).replaceAllUsesWith(result);
+    op->erase();
+  }
+
+  DenseMap<Value, MagicNumbers> magicNumbers;
+};
+
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::createStrengthReduceDivRemPass() {
+  return std::make_unique<StrengthReduceDivRemPass>();
+}
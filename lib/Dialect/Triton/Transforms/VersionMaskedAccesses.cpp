@@ -0,0 +1,384 @@
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Pass/Pass.h"
+
+#include "triton/Dialect/Triton/IR/Dialect.h"
+#include "triton/Dialect/Triton/Transforms/Passes.h"
+
+#include "llvm/ADT/SetVector.h"
+
+#include <memory>
+
+namespace mlir {
+#define GEN_PASS_DEF_TRITONVERSIONMASKEDACCESSES
+#include "triton/Dialect/Triton/Transforms/Passes.h.inc"
+} // namespace mlir
+
+using namespace mlir;
+
+namespace {
+
+// The elements of an i32 index tensor of the form
+//   splat(terms[0]) + splat(terms[1]) + ... + [lo, hi]
+// e.g. `pid * BLOCK + make_range(0, BLOCK)` has terms = {pid * BLOCK},
+// lo = 0 and hi = BLOCK - 1.
+struct IndexRange {
+  SmallVector<Value> terms;
+  int64_t lo = 0;
+  int64_t hi = 0;
+};
+
+std::optional<IndexRange> getIndexRange(Value value) {
+  if (auto makeRange = value.getDefiningOp<triton::MakeRangeOp>())
+    return IndexRange{{},
+                      static_cast<int64_t>(makeRange.getStart()),
+                      static_cast<int64_t>(makeRange.getEnd()) - 1};
+  if (auto splat = value.getDefiningOp<triton::SplatOp>()) {
+    if (auto cst = getConstantIntValue(splat.getSrc()))
+      return IndexRange{{}, *cst, *cst};
+    return IndexRange{{splat.getSrc()}, 0, 0};
+  }
+  DenseIntElementsAttr cstAttr;
+  if (matchPattern(value, m_Constant(&cstAttr)) && cstAttr.isSplat()) {
+    int64_t cst = cstAttr.getSplatValue<APInt>().getSExtValue();
+    return IndexRange{{}, cst, cst};
+  }
+  if (auto expandDims = value.getDefiningOp<triton::ExpandDimsOp>())
+    return getIndexRange(expandDims.getSrc());
+  if (auto broadcast = value.getDefiningOp<triton::BroadcastOp>())
+    return getIndexRange(broadcast.getSrc());
+  if (auto addOp = value.getDefiningOp<arith::AddIOp>()) {
+    auto lhs = getIndexRange(addOp.getLhs());
+    auto rhs = getIndexRange(addOp.getRhs());
+    if (!lhs || !rhs)
+      return std::nullopt;
+    lhs->terms.append(rhs->terms);
+    lhs->lo += rhs->lo;
+    lhs->hi += rhs->hi;
+    return lhs;
+  }
+  return std::nullopt;
+}
+
+// A mask of the form `index < bound` (or `<=`, signed or unsigned) where the
+// bound is the same for every element.
+struct BoundCheck {
+  arith::CmpIOp cmpOp;
+  IndexRange index;
+  IndexRange bound;
+  bool isUnsigned;
+  bool isInclusive;
+};
+
+std::optional<BoundCheck> matchBoundCheck(arith::CmpIOp cmpOp) {
+  auto tensorTy = cmpOp.getLhs().getType().dyn_cast<RankedTensorType>();
+  if (!tensorTy || !tensorTy.getElementType().isInteger(32))
+    return std::nullopt;
+  Value index = cmpOp.getLhs();
+  Value bound = cmpOp.getRhs();
+  bool isUnsigned, isInclusive;
+  switch (cmpOp.getPredicate()) {
+  case arith::CmpIPredicate::slt:
+    isUnsigned = false, isInclusive = false;
+    break;
+  case arith::CmpIPredicate::sle:
+    isUnsigned = false, isInclusive = true;
+    break;
+  case arith::CmpIPredicate::ult:
+    isUnsigned = true, isInclusive = false;
+    break;
+  case arith::CmpIPredicate::ule:
+    isUnsigned = true, isInclusive = true;
+    break;
+  // `bound > index` is `index < bound`
+  case arith::CmpIPredicate::sgt:
+    isUnsigned = false, isInclusive = false, std::swap(index, bound);
+    break;
+  case arith::CmpIPredicate::sge:
+    isUnsigned = false, isInclusive = true, std::swap(index, bound);
+    break;
+  case arith::CmpIPredicate::ugt:
+    isUnsigned = true, isInclusive = false, std::swap(index, bound);
+    break;
+  case arith::CmpIPredicate::uge:
+    isUnsigned = true, isInclusive = true, std::swap(index, bound);
+    break;
+  default:
+    return std::nullopt;
+  }
+  auto indexRange = getIndexRange(index);
+  auto boundRange = getIndexRange(bound);
+  if (!indexRange || !boundRange || boundRange->lo != boundRange->hi)
+    return std::nullopt;
+  return BoundCheck{cmpOp, *indexRange, *boundRange, isUnsigned, isInclusive};
+}
+
+// Collects the comparisons that `mask` is the conjunction of.
+void collectMaskComparisons(Value mask, SetVector<arith::CmpIOp> &cmpOps) {
+  Operation *def = mask.getDefiningOp();
+  if (!def)
+    return;
+  if (auto andOp = dyn_cast<arith::AndIOp>(def)) {
+    collectMaskComparisons(andOp.getLhs(), cmpOps);
+    collectMaskComparisons(andOp.getRhs(), cmpOps);
+  } else if (isa<triton::BroadcastOp, triton::ExpandDimsOp>(def)) {
+    collectMaskComparisons(def->getOperand(0), cmpOps);
+  } else if (auto cmpOp = dyn_cast<arith::CmpIOp>(def)) {
+    cmpOps.insert(cmpOp);
+  }
+}
+
+// Collects into `slice` the operations of `block` that compute `value`, and
+// returns false unless they are all side-effect free scalar operations that
+// can be moved to the beginning of the block.
+bool collectHoistableSlice(Value value, Block *block,
+                           SetVector<Operation *> &slice) {
+  Region *region = block->getParent();
+  if (auto arg = value.dyn_cast<BlockArgument>())
+    return arg.getOwner() == block ||
+           !region->isAncestor(arg.getParentRegion());
+  Operation *def = value.getDefiningOp();
+  if (def->getBlock() != block)
+    return !region->isAncestor(def->getParentRegion());
+  if (slice.contains(def))
+    return true;
+  if (def->getNumRegions() != 0 || !isMemoryEffectFree(def) ||
+      llvm::any_of(def->getResultTypes(),
+                   [](Type type) { return type.isa<ShapedType>(); }))
+    return false;
+  for (Value operand : def->getOperands())
+    if (!collectHoistableSlice(operand, block, slice))
+      return false;
+  slice.insert(def);
+  return true;
+}
+
+// Emits `terms[0] + terms[1] + ...` in i64.
+Value emitSum(OpBuilder &builder, Location loc, ArrayRef<Value> terms) {
+  Type i64Ty = builder.getI64Type();
+  Value sum = builder.create<arith::ConstantIntOp>(loc, 0, 64);
+  for (Value term : terms) {
+    Value ext = builder.create<arith::ExtSIOp>(loc, i64Ty, term);
+    sum = builder.create<arith::AddIOp>(loc, sum, ext);
+  }
+  return sum;
+}
+
+Value emitAddConstant(OpBuilder &builder, Location loc, Value value,
+                      int64_t cst) {
+  return builder.create<arith::AddIOp>(
+      loc, value, builder.create<arith::ConstantIntOp>(loc, cst, 64));
+}
+
+// Emits `lower <= sum(terms) + loOffset` and `sum(terms) + hiOffset <=
+// INT32_MAX`, leaving out the comparisons that hold for any value of the terms.
+Value emitFitsI32(OpBuilder &builder, Location loc, size_t numTerms,
+                  int64_t loOffset, Value lo, int64_t hiOffset, Value hi,
+                  int64_t lower, Value cond) {
+  int64_t n = numTerms;
+  if (n * INT32_MIN + loOffset < lower) {
+    Value lowerVal = builder.create<arith::ConstantIntOp>(loc, lower, 64);
+    cond = builder.create<arith::AndIOp>(
+        loc, cond,
+        builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::sge, lo,
+                                      lowerVal));
+  }
+  if (n * INT32_MAX + hiOffset > INT32_MAX) {
+    Value upperVal = builder.create<arith::ConstantIntOp>(loc, INT32_MAX, 64);
+    cond = builder.create<arith::AndIOp>(
+        loc, cond,
+        builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::sle, hi,
+                                      upperVal));
+  }
+  return cond;
+}
+
+// Emits a scalar condition that implies every element of `check` is true.
+// The sums are computed in i64 and required to fit in i32, so that they
+// match the (wrapping) i32 arithmetic of the mask. Unsigned checks also
+// require them to be non-negative.
+Value emitAllTrue(OpBuilder &builder, Location loc, const BoundCheck &check,
+                  Value cond) {
+  int64_t lower = check.isUnsigned ? 0 : INT32_MIN;
+  const IndexRange &index = check.index;
+  const IndexRange &bound = check.bound;
+  Value indexSum = emitSum(builder, loc, index.terms);
+  Value indexLo = emitAddConstant(builder, loc, indexSum, index.lo);
+  Value indexHi = emitAddConstant(builder, loc, indexSum, index.hi);
+  Value boundSum = emitSum(builder, loc, bound.terms);
+  Value boundVal = emitAddConstant(builder, loc, boundSum, bound.lo);
+  cond = emitFitsI32(builder, loc, index.terms.size(), index.lo, indexLo,
+                     index.hi, indexHi, lower, cond);
+  cond = emitFitsI32(builder, loc, bound.terms.size(), bound.lo, boundVal,
+                     bound.lo, boundVal, lower, cond);
+  auto pred = check.isInclusive ? arith::CmpIPredicate::sle
+                                : arith::CmpIPredicate::slt;
+  return builder.create<arith::AndIOp>(
+      loc, cond, builder.create<arith::CmpIOp>(loc, pred, indexHi, boundVal));
+}
+
+class VersionMaskedAccessesPass
+    : public mlir::impl::TritonVersionMaskedAccessesBase<
+          VersionMaskedAccessesPass> {
+public:
+  VersionMaskedAccessesPass() = default;
+  VersionMaskedAccessesPass(int maxVersionedOps) {
+    this->maxVersionedOps = maxVersionedOps;
+  }
+
+  void runOnOperation() override {
+    // Loop bodies first, so that a kernel that is too large to be versioned
+    // as a whole can still get mask-free inner loops. Loops with a dot or
+    // with a load at the top level of their body are left to the software
+    // pipeliners, which only handle loads at the top level of the loop body
+    // and would no longer see them once they are moved into an scf.if.
+    SmallVector<scf::ForOp> loops;
+    getOperation().walk([&](scf::ForOp forOp) {
+      if (!forOp.getBody()->getOps<triton::LoadOp>().empty())
+        return;
+      WalkResult hasDot = forOp.walk([](triton::DotOp) {
+        return WalkResult::interrupt();
+      });
+      if (!hasDot.wasInterrupted())
+        loops.push_back(forOp);
+    });
+    for (scf::ForOp forOp : loops)
+      versionBlock(forOp.getBody());
+
+    SmallVector<triton::FuncOp> funcs;
+    getOperation().walk([&](triton::FuncOp funcOp) {
+      if (funcOp.getBody().hasOneBlock())
+        funcs.push_back(funcOp);
+    });
+    for (triton::FuncOp funcOp : funcs)
+      versionBlock(&funcOp.getBody().front());
+  }
+
+private:
+  // Rewrites
+  //   <ops>
+  //   terminator
+  // into
+  //   <scalar ops computing the mask bounds>
+  //   %r = scf.if <every bound check is true> {
+  //     <ops with the bound checks replaced by true>
+  //   } else {
+  //     <ops>
+  //   }
+  //   terminator(%r)
+  void versionBlock(Block *block) {
+    Operation *parentOp = block->getParentOp();
+    Operation *terminator = block->getTerminator();
+
+    SetVector<arith::CmpIOp> cmpOps;
+    int64_t numOps = 0;
+    for (Operation &op : block->without_terminator())
+      op.walk([&](Operation *nested) {
+        ++numOps;
+        if (auto loadOp = dyn_cast<triton::LoadOp>(nested)) {
+          if (loadOp.getMask())
+            collectMaskComparisons(loadOp.getMask(), cmpOps);
+        } else if (auto storeOp = dyn_cast<triton::StoreOp>(nested)) {
+          if (storeOp.getMask())
+            collectMaskComparisons(storeOp.getMask(), cmpOps);
+        }
+      });
+    if (numOps > maxVersionedOps)
+      return;
+
+    // Keep the checks that are computed inside the block from values that
+    // are available at its beginning.
+    SmallVector<BoundCheck> checks;
+    SetVector<Operation *> slice;
+    for (arith::CmpIOp cmpOp : cmpOps) {
+      if (!parentOp->isProperAncestor(cmpOp))
+        continue;
+      auto check = matchBoundCheck(cmpOp);
+      if (!check)
+        continue;
+      SetVector<Operation *> checkSlice = slice;
+      bool hoistable = true;
+      for (Value term : check->index.terms)
+        hoistable &= collectHoistableSlice(term, block, checkSlice);
+      for (Value term : check->bound.terms)
+        hoistable &= collectHoistableSlice(term, block, checkSlice);
+      if (!hoistable)
+        continue;
+      slice = std::move(checkSlice);
+      checks.push_back(*check);
+    }
+    if (checks.empty())
+      return;
+
+    // Move the scalar computations of the bounds to the top of the block
+    SmallVector<Operation *> hoisted(slice.begin(), slice.end());
+    llvm::sort(hoisted, [](Operation *lhs, Operation *rhs) {
+      return lhs->isBeforeInBlock(rhs);
+    });
+    Operation *lastHoisted = nullptr;
+    for (Operation *op : hoisted) {
+      if (lastHoisted)
+        op->moveAfter(lastHoisted);
+      else if (op != &block->front())
+        op->moveBefore(&block->front());
+      lastHoisted = op;
+    }
+
+    OpBuilder builder(block, block->begin());
+    if (lastHoisted)
+      builder.setInsertionPointAfter(lastHoisted);
+    Location loc = parentOp->getLoc();
+    Value cond = builder.create<arith::ConstantIntOp>(loc, 1, 1);
+    for (const BoundCheck &check : checks)
+      cond = emitAllTrue(builder, loc, check, cond);
+    auto ifOp = builder.create<scf::IfOp>(
+        loc, terminator->getOperandTypes(), cond, /*withElseRegion=*/true);
+
+    // The original operations become the masked (else) version
+    Block *thenBlock = ifOp.thenBlock();
+    Block *elseBlock = ifOp.elseBlock();
+    if (thenBlock->mightHaveTerminator())
+      thenBlock->getTerminator()->erase();
+    if (elseBlock->mightHaveTerminator())
+      elseBlock->getTerminator()->erase();
+    elseBlock->getOperations().splice(elseBlock->end(), block->getOperations(),
+                                      std::next(ifOp->getIterator()),
+                                      terminator->getIterator());
+    builder.setInsertionPointToEnd(elseBlock);
+    builder.create<scf::YieldOp>(loc, terminator->getOperands());
+
+    // Clone them into the mask-free (then) version
+    IRMapping mapping;
+    builder.setInsertionPointToStart(thenBlock);
+    for (Operation &op : elseBlock->without_terminator())
+      builder.clone(op, mapping);
+    SmallVector<Value> thenResults;
+    for (Value operand : terminator->getOperands())
+      thenResults.push_back(mapping.lookupOrDefault(operand));
+    builder.create<scf::YieldOp>(loc, thenResults);
+    for (const BoundCheck &check : checks) {
+      Operation *cmpOp =
+          mapping.lookup(check.cmpOp.getResult()).getDefiningOp();
+      builder.setInsertionPoint(cmpOp);
+      auto maskTy = cmpOp->getResult(0).getType().cast<RankedTensorType>();
+      Value allTrue = builder.create<arith::ConstantOp>(
+          cmpOp->getLoc(), DenseElementsAttr::get(maskTy, true));
+      cmpOp->getResult(0).replaceAllUsesWith(allTrue);
+      cmpOp->erase();
+    }
+
+    terminator->setOperands(ifOp.getResults());
+  }
+};
+
+} // anonymous namespace
+
+std::unique_ptr<Pass>
+mlir::triton::createVersionMaskedAccessesPass(int maxVersionedOps) {
+  return std::make_unique<VersionMaskedAccessesPass>(maxVersionedOps);
+}
@@ -47,6 +47,8 @@ unsigned getTotalElemsPerThread(Attribute layout, ArrayRef<int64_t> shape,
     return mmaLayout.getTotalElemsPerThread(shape, eltTy);
   } else if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>()) {
     return mfmaLayout.getTotalElemsPerThread(shape, eltTy);
+  } else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+    return wmmaLayout.getTotalElemsPerThread(shape, eltTy);
   } else if (auto sharedLayout = layout.dyn_cast<SharedEncodingAttr>()) {
     return sharedLayout.getTotalElemsPerThread(shape, eltTy);
   } else if (auto dotLayout = layout.dyn_cast<DotOperandEncodingAttr>()) {
@@ -67,6 +69,8 @@ SmallVector<unsigned> getElemsPerThread(Attribute layout,
     return mmaLayout.getElemsPerThread(shape, eltTy);
   } else if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>()) {
     return mfmaLayout.getElemsPerThread(shape, eltTy);
+  } else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+    return wmmaLayout.getElemsPerThread(shape, eltTy);
   } else {
     assert(0 && "getElemsPerThread not implemented");
     return SmallVector<unsigned>();
@@ -107,9 +111,12 @@ SmallVector<unsigned> getThreadsPerWarp(Attribute layout) {
     if (mfmaLayout.getNonKDim() == 32) {
       cols = 2;
       rows = 32;
-    } else {
+    } else if (mfmaLayout.getNonKDim() == 16) {
       cols = 4;
       rows = 16;
+    } else {
+      cols = 16;
+      rows = 4;
     }
 
     if (mfmaLayout.getIsTransposed()) {
@@ -118,6 +125,9 @@ SmallVector<unsigned> getThreadsPerWarp(Attribute layout) {
       return {cols, rows};
     }
   }
+  if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+    return {wmmaLayout.getWarpSize() / 16, 16};
+  }
   if (auto sliceLayout = layout.dyn_cast<SliceEncodingAttr>()) {
     auto parent = sliceLayout.getParent();
     auto parentThreadsPerWarp = getThreadsPerWarp(parent);
@@ -177,6 +187,10 @@ SmallVector<unsigned> getWarpsPerCTA(Attribute layout) {
     return SmallVector<unsigned>(mfmaLayout.getWarpsPerCTA().begin(),
                                  mfmaLayout.getWarpsPerCTA().end());
   }
+  if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+    return SmallVector<unsigned>(wmmaLayout.getWarpsPerCTA().begin(),
+                                 wmmaLayout.getWarpsPerCTA().end());
+  }
   if (auto sliceLayout = layout.dyn_cast<SliceEncodingAttr>()) {
     auto parent = sliceLayout.getParent();
     auto parentWarpsPerCTA = getWarpsPerCTA(parent);
@@ -241,7 +255,8 @@ SmallVector<unsigned> getSizePerThread(Attribute layout) {
     if (mfmaLayout.getNonKDim() == 32) {
       rows = 16;
       cols = 1;
-    } else if (mfmaLayout.getNonKDim() == 16) {
+    } else if (mfmaLayout.getNonKDim() == 16 ||
+               mfmaLayout.getNonKDim() == 4) {
       rows = 4;
       cols = 1;
     } else
@@ -252,6 +267,8 @@ SmallVector<unsigned> getSizePerThread(Attribute layout) {
     } else {
       return {rows, cols};
     }
+  } else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+    return {256 / wmmaLayout.getWarpSize(), 1};
   } else if (auto dotLayout = layout.dyn_cast<DotOperandEncodingAttr>()) {
     auto parentLayout = dotLayout.getParent();
     assert(parentLayout && "DotOperandEncodingAttr must have a parent");
@@ -277,6 +294,16 @@ SmallVector<unsigned> getSizePerThread(Attribute layout) {
         assert(0 && "DotOperandEncodingAttr opIdx must be 0 or 1");
         return {};
       }
+    } else if (parentLayout.isa<WmmaEncodingAttr>()) {
+      auto opIdx = dotLayout.getOpIdx();
+      if (opIdx == 0) {
+        return {1, 16};
+      } else if (opIdx == 1) {
+        return {16, 1};
+      } else {
+        assert(0 && "DotOperandEncodingAttr opIdx must be 0 or 1");
+        return {};
+      }
     } else {
       assert(0 && "DotOperandEncodingAttr non-MmaEncodingAttr parent not "
                   "supported yet");
@@ -292,7 +319,8 @@ SmallVector<unsigned> getContigPerThread(Attribute layout) {
   if (auto mmaLayout = layout.dyn_cast<MmaEncodingAttr>()) {
     assert(mmaLayout.isVolta() || mmaLayout.isAmpere() || mmaLayout.isHopper());
     return {1, 2};
-  } else if (layout.isa<MfmaEncodingAttr>()) {
+  } else if (layout.isa<MfmaEncodingAttr>() ||
+             layout.isa<WmmaEncodingAttr>()) {
     return {1, 1};
   } else if (auto sliceLayout = layout.dyn_cast<SliceEncodingAttr>()) {
     auto parentLayout = sliceLayout.getParent();
@@ -342,10 +370,16 @@ SmallVector<unsigned> getThreadsPerCTA(Attribute layout) {
     if (mfmaLayout.getNonKDim() == 32) {
       threads = {32 * mfmaLayout.getWarpsPerCTA()[0],
                  2 * mfmaLayout.getWarpsPerCTA()[1]};
-    } else {
+    } else if (mfmaLayout.getNonKDim() == 16) {
       threads = {16 * mfmaLayout.getWarpsPerCTA()[0],
                  4 * mfmaLayout.getWarpsPerCTA()[1]};
+    } else {
+      threads = {4 * mfmaLayout.getWarpsPerCTA()[0],
+                 16 * mfmaLayout.getWarpsPerCTA()[1]};
     }
+  } else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+    threads = {wmmaLayout.getWarpSize() / 16 * wmmaLayout.getWarpsPerCTA()[0],
+               16 * wmmaLayout.getWarpsPerCTA()[1]};
   } else {
     assert(0 && "Unimplemented usage of getThreadsPerCTA");
   }
@@ -383,9 +417,12 @@ SmallVector<unsigned> getShapePerCTATile(Attribute layout,
     }
     assert(0 && "Unexpected MMA layout version found");
   } else if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>()) {
-    auto nonKDim = mfmaLayout.getNonKDim();
-    return {nonKDim * mfmaLayout.getWarpsPerCTA()[0],
-            nonKDim * mfmaLayout.getWarpsPerCTA()[1]};
+    auto instrShape = mfmaLayout.getMFMAInstrShape();
+    return {instrShape[0] * mfmaLayout.getWarpsPerCTA()[0],
+            instrShape[1] * mfmaLayout.getWarpsPerCTA()[1]};
+  } else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+    return {16 * wmmaLayout.getWarpsPerCTA()[0],
+            16 * wmmaLayout.getWarpsPerCTA()[1]};
   } else if (auto dotLayout = layout.dyn_cast<DotOperandEncodingAttr>()) {
     auto parentLayout = dotLayout.getParent();
     assert(parentLayout && "DotOperandEncodingAttr must have a parent");
@@ -415,6 +452,17 @@ SmallVector<unsigned> getShapePerCTATile(Attribute layout,
       } else {
         assert(0 && "DotOperandEncodingAttr opIdx must be 0 or 1");
       }
+    } else if (parentLayout.isa<WmmaEncodingAttr>()) {
+      auto parentShapePerCTA = getShapePerCTATile(parentLayout, tensorShape);
+      auto opIdx = dotLayout.getOpIdx();
+
+      if (opIdx == 0) {
+        return {parentShapePerCTA[0], 16};
+      } else if (opIdx == 1) {
+        return {16, parentShapePerCTA[1]};
+      } else {
+        assert(0 && "DotOperandEncodingAttr opIdx must be 0 or 1");
+      }
     } else {
       assert(0 && "DotOperandEncodingAttr non-MmaEncodingAttr parent not "
                   "supported yet");
@@ -454,6 +502,8 @@ SmallVector<unsigned> getOrder(Attribute layout) {
     return {1, 0};
   } else if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>()) {
     return {1, 0};
+  } else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+    return {1, 0};
   } else if (auto dotLayout = layout.dyn_cast<DotOperandEncodingAttr>()) {
     return {1, 0};
   } else if (auto sliceLayout = layout.dyn_cast<SliceEncodingAttr>()) {
@@ -487,6 +537,10 @@ CTALayoutAttr getCTALayout(Attribute layout) {
                               getCTAOrder(sliceLayout));
   else if (auto mmaLayout = layout.dyn_cast<MmaEncodingAttr>())
     return mmaLayout.getCTALayout();
+#ifdef USE_ROCM
+  else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>())
+    return wmmaLayout.getCTALayout();
+#endif
   else if (auto dotLayout = layout.dyn_cast<DotOperandEncodingAttr>())
     return CTALayoutAttr::get(layout.getContext(), getCTAsPerCGA(dotLayout),
                               getCTASplitNum(dotLayout),
@@ -528,6 +582,8 @@ SmallVector<unsigned> getCTAsPerCGA(Attribute layout) {
 #ifdef USE_ROCM
   else if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>())
     ref = mfmaLayout.getCTALayout().getCTAsPerCGA();
+  else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>())
+    ref = wmmaLayout.getCTALayout().getCTAsPerCGA();
 #endif
   else if (auto dotLayout = layout.dyn_cast<DotOperandEncodingAttr>())
     return getCTAsPerCGA(dotLayout.getParent());
@@ -554,6 +610,9 @@ SmallVector<unsigned> getCTASplitNum(Attribute layout) {
   } else if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>()) {
     res.assign(mfmaLayout.getCTALayout().getCTASplitNum().begin(),
                mfmaLayout.getCTALayout().getCTASplitNum().end());
+  } else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+    res.assign(wmmaLayout.getCTALayout().getCTASplitNum().begin(),
+               wmmaLayout.getCTALayout().getCTASplitNum().end());
 #endif
   } else if (auto dotLayout = layout.dyn_cast<DotOperandEncodingAttr>()) {
     res = getCTASplitNum(dotLayout.getParent());
@@ -583,6 +642,8 @@ SmallVector<unsigned> getCTAOrder(Attribute layout) {
 #ifdef USE_ROCM
   } else if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>()) {
     ref = mfmaLayout.getCTALayout().getCTAOrder();
+  } else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>()) {
+    ref = wmmaLayout.getCTALayout().getCTAOrder();
 #endif
   } else if (auto dotLayout = layout.dyn_cast<DotOperandEncodingAttr>()) {
     return getCTAOrder(dotLayout.getParent());
@@ -638,6 +699,8 @@ unsigned getNumWarpsPerCTA(Attribute layout) {
 #ifdef USE_ROCM
   else if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>())
     warpsPerCTA = mfmaLayout.getWarpsPerCTA();
+  else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>())
+    warpsPerCTA = wmmaLayout.getWarpsPerCTA();
 #endif
   else if (auto dotLayout = layout.dyn_cast<DotOperandEncodingAttr>())
     return getNumWarpsPerCTA(dotLayout.getParent());
@@ -659,6 +722,8 @@ unsigned getNumCTAs(Attribute layout) {
 #ifdef USE_ROCM
   else if (auto mfmaLayout = layout.dyn_cast<MfmaEncodingAttr>())
     CTAsPerCGA = mfmaLayout.getCTALayout().getCTAsPerCGA();
+  else if (auto wmmaLayout = layout.dyn_cast<WmmaEncodingAttr>())
+    CTAsPerCGA = wmmaLayout.getCTALayout().getCTAsPerCGA();
 #endif
   else if (auto dotLayout = layout.dyn_cast<DotOperandEncodingAttr>())
     return getNumCTAs(dotLayout.getParent());
@@ -671,7 +736,8 @@ unsigned getNumCTAs(Attribute layout) {
 
 bool isaDistributedLayout(Attribute layout) {
   return layout.isa<BlockedEncodingAttr>() || layout.isa<MmaEncodingAttr>() ||
-         layout.isa<MfmaEncodingAttr>() || layout.isa<SliceEncodingAttr>();
+         layout.isa<MfmaEncodingAttr>() || layout.isa<WmmaEncodingAttr>() ||
+         layout.isa<SliceEncodingAttr>();
 }
 
 bool isSharedEncoding(Value value) {
@@ -837,6 +903,17 @@ unsigned SliceEncodingAttr::getTotalElemsPerThread(ArrayRef<int64_t> shape,
   return product<unsigned>(getElemsPerThread(shape, eltTy));
 }
 
+SmallVector<unsigned> MfmaEncodingAttr::getMFMAInstrShape() const {
+  unsigned nonKDim = getNonKDim();
+  if (nonKDim != 4)
+    return {nonKDim, nonKDim};
+  // The 16 blocks of the 4x4 instructions are stacked along the dimension
+  // held by the lanes
+  if (getIsTransposed())
+    return {4, 64};
+  return {64, 4};
+}
+
 SmallVector<unsigned>
 MfmaEncodingAttr::getElemsPerThread(ArrayRef<int64_t> shape, Type eltTy) const {
   size_t rank = shape.size();
@@ -844,18 +921,21 @@ MfmaEncodingAttr::getElemsPerThread(ArrayRef<int64_t> shape, Type eltTy) const {
 
   SmallVector<unsigned> elemsPerThread(rank);
   auto nonKDim = getNonKDim();
-  auto elemsPerThreadPerTile = (nonKDim == 16 ? 4 : 16);
+  auto instrShape = getMFMAInstrShape();
+  auto elemsPerThreadPerTile = (nonKDim == 32 ? 16 : 4);
   if (getIsTransposed()) {
     unsigned elemsCol =
-        ceil<unsigned>(shape[1], nonKDim * getWarpsPerCTA()[1]) *
+        ceil<unsigned>(shape[1], instrShape[1] * getWarpsPerCTA()[1]) *
         elemsPerThreadPerTile;
-    unsigned elemsRow = ceil<unsigned>(shape[0], nonKDim * getWarpsPerCTA()[0]);
+    unsigned elemsRow =
+        ceil<unsigned>(shape[0], instrShape[0] * getWarpsPerCTA()[0]);
     elemsPerThread[0] = elemsRow;
     elemsPerThread[1] = elemsCol;
   } else {
-    unsigned elemsCol = ceil<unsigned>(shape[1], nonKDim * getWarpsPerCTA()[1]);
+    unsigned elemsCol =
+        ceil<unsigned>(shape[1], instrShape[1] * getWarpsPerCTA()[1]);
     unsigned elemsRow =
-        ceil<unsigned>(shape[0], nonKDim * getWarpsPerCTA()[0]) *
+        ceil<unsigned>(shape[0], instrShape[0] * getWarpsPerCTA()[0]) *
         elemsPerThreadPerTile;
     elemsPerThread[0] = elemsRow;
     elemsPerThread[1] = elemsCol;
@@ -914,6 +994,25 @@ unsigned MfmaEncodingAttr::getTotalElemsPerThread(ArrayRef<int64_t> shape,
   return product<unsigned>(getElemsPerThread(shape, eltTy));
 }
 
+SmallVector<unsigned>
+WmmaEncodingAttr::getElemsPerThread(ArrayRef<int64_t> shape, Type eltTy) const {
+  size_t rank = shape.size();
+  assert(rank == 2 && "Unexpected rank of wmma layout");
+
+  auto shapePerCTA = getShapePerCTA(getCTALayout().getCTASplitNum(), shape);
+  unsigned elemsPerThreadPerTile = 256 / getWarpSize();
+  SmallVector<unsigned> elemsPerThread(rank);
+  elemsPerThread[0] = ceil<unsigned>(shapePerCTA[0], 16 * getWarpsPerCTA()[0]) *
+                      elemsPerThreadPerTile;
+  elemsPerThread[1] = ceil<unsigned>(shapePerCTA[1], 16 * getWarpsPerCTA()[1]);
+  return elemsPerThread;
+}
+
+unsigned WmmaEncodingAttr::getTotalElemsPerThread(ArrayRef<int64_t> shape,
+                                                  Type eltTy) const {
+  return product<unsigned>(getElemsPerThread(shape, eltTy));
+}
+
 unsigned
 MmaEncodingAttr::getElemsPerThreadOfOperand(int opIdx,
                                             ArrayRef<int64_t> shape) const {
@@ -984,13 +1083,17 @@ SmallVector<int64_t>
 DotOperandEncodingAttr::getMFMAElemsPerInstr() const {
   auto mfmaEncoding = getParent().cast<MfmaEncodingAttr>();
   int64_t nonKDim = mfmaEncoding.getNonKDim();
-  assert(nonKDim == 32 || nonKDim == 16);
+  assert(nonKDim == 32 || nonKDim == 16 || nonKDim == 4);
+  auto instrShape = mfmaEncoding.getMFMAInstrShape();
+  // kWidth covers the kPack instructions that read the elements of a thread
+  // at once, the K size is the one of all of them together
   int64_t kWidth = getKWidth();
-  int64_t kDim = kWidth * (nonKDim == 32 ? 2 : 4);
+  // Lanes of a 4x4 instruction hold all the elements along K
+  int64_t kDim = kWidth * (nonKDim == 32 ? 2 : nonKDim == 16 ? 4 : 1);
   if (getOpIdx() == 0)
-    return {nonKDim, kDim};
+    return {instrShape[0], kDim};
   else
-    return {kDim, nonKDim};
+    return {kDim, instrShape[1]};
 }
 
 SmallVector<int64_t>
@@ -1010,6 +1113,28 @@ DotOperandEncodingAttr::getMFMARep(ArrayRef<int64_t> operandShape,
   }
 }
 
+SmallVector<int64_t> DotOperandEncodingAttr::getWMMAElemsPerInstr() const {
+  assert(getParent().isa<WmmaEncodingAttr>());
+  // All WMMA instructions are 16x16x16, for both operands
+  return {16, 16};
+}
+
+SmallVector<int64_t>
+DotOperandEncodingAttr::getWMMARep(ArrayRef<int64_t> operandShape) const {
+  auto operandTileShape = getWMMAElemsPerInstr();
+  auto warpsPerCTA = getParent().cast<WmmaEncodingAttr>().getWarpsPerCTA();
+  if (getOpIdx() == 0)
+    return {std::max<int64_t>(1, operandShape[0] /
+                                     (operandTileShape[0] * warpsPerCTA[0])),
+            std::max<int64_t>(1, operandShape[1] / operandTileShape[1])};
+  else {
+    assert(getOpIdx() == 1);
+    return {std::max<int64_t>(1, operandShape[0] / operandTileShape[0]),
+            std::max<int64_t>(1, operandShape[1] /
+                                     (operandTileShape[1] * warpsPerCTA[1]))};
+  }
+}
+
 SmallVector<unsigned>
 DotOperandEncodingAttr::getElemsPerThread(ArrayRef<int64_t> shape,
                                           Type eltTy) const {
@@ -1027,6 +1152,11 @@ unsigned DotOperandEncodingAttr::getTotalElemsPerThread(ArrayRef<int64_t> shape,
     auto rep = getMFMARep(shape, eltTy);
     return rep[0] * rep[1];
   }
+  // Like for MFMA, each element holds the operand of one instruction
+  if (getParent().isa<WmmaEncodingAttr>()) {
+    auto rep = getWMMARep(getShapePerCTA(*this, shape));
+    return rep[0] * rep[1];
+  }
   auto shapePerCTA = getShapePerCTA(*this, shape);
   if (auto mmaParent = getParent().dyn_cast<MmaEncodingAttr>()) {
     int warpsPerCTAM = mmaParent.getWarpsPerCTA()[0];
@@ -1341,6 +1471,69 @@ void MfmaEncodingAttr::print(AsmPrinter &printer) const {
           << "CTAOrder = [" << getCTALayout().getCTAOrder() << "]}>";
 }
 
+//===----------------------------------------------------------------------===//
+// WMMA encoding
+//===----------------------------------------------------------------------===//
+
+Attribute WmmaEncodingAttr::parse(AsmParser &parser, Type type) {
+  if (parser.parseLess().failed())
+    return {};
+  DictionaryAttr dict;
+  if (parser.parseAttribute(dict).failed())
+    return {};
+  if (parser.parseGreater().failed())
+    return {};
+
+  unsigned warpSize = 0;
+  SmallVector<unsigned> warpsPerCTA;
+  SmallVector<unsigned> CTAsPerCGA;
+  SmallVector<unsigned> CTASplitNum;
+  SmallVector<unsigned> CTAOrder;
+
+  for (const NamedAttribute &attr : dict) {
+    if (attr.getName() == "warpSize") {
+      if (parseUInt(parser, attr, warpSize, "warpSize").failed())
+        return {};
+    } else if (attr.getName() == "warpsPerCTA") {
+      if (parseIntArrayAttr(parser, attr, warpsPerCTA, "warpsPerCTA").failed())
+        return {};
+    } else if (attr.getName() == "CTAsPerCGA") {
+      if (parseIntArrayAttr(parser, attr, CTAsPerCGA, "CTAsPerCGA").failed())
+        return {};
+    } else if (attr.getName() == "CTASplitNum") {
+      if (parseIntArrayAttr(parser, attr, CTASplitNum, "CTASplitNum").failed())
+        return {};
+    } else if (attr.getName() == "CTAOrder") {
+      if (parseIntArrayAttr(parser, attr, CTAOrder, "CTAOrder").failed())
+        return {};
+    } else {
+      parser.emitError(parser.getNameLoc(), "unexpected key: ")
+          << attr.getName().strref();
+      return {};
+    }
+  }
+
+  if (warpSize != 32 && warpSize != 64) {
+    parser.emitError(parser.getNameLoc(), "expected warpSize to be 32 or 64");
+    return {};
+  }
+
+  auto CTALayout = CTALayoutAttr::get(parser.getContext(), CTAsPerCGA,
+                                      CTASplitNum, CTAOrder);
+
+  return parser.getChecked<WmmaEncodingAttr>(parser.getContext(), warpSize,
+                                             warpsPerCTA, CTALayout);
+}
+
+void WmmaEncodingAttr::print(AsmPrinter &printer) const {
+  printer << "<{"
+          << "warpSize = " << getWarpSize() << ", "
+          << "warpsPerCTA = [" << getWarpsPerCTA() << "], "
+          << "CTAsPerCGA = [" << getCTALayout().getCTAsPerCGA() << "], "
+          << "CTASplitNum = [" << getCTALayout().getCTASplitNum() << "], "
+          << "CTAOrder = [" << getCTALayout().getCTAOrder() << "]}>";
+}
+
 //===----------------------------------------------------------------------===//
 // Sliced Encoding
 //===----------------------------------------------------------------------===//
@@ -1496,16 +1689,29 @@ Attribute DotOperandEncodingAttr::parse(AsmParser &parser, Type type) {
 #endif
     kWidth = _kWidth.cast<IntegerAttr>().getInt();
   }
+  unsigned kPack = 1;
+  if (Attribute _kPack = attrs.get("kPack")) {
+    if (!parent.isa<MfmaEncodingAttr>()) {
+      parser.emitError(parser.getNameLoc(),
+                       "kPack only supported for MFMA parent");
+      return Attribute();
+    }
+    kPack = _kPack.cast<IntegerAttr>().getInt();
+  }
   return parser.getChecked<DotOperandEncodingAttr>(parser.getContext(), opIdx,
-                                                   parent, kWidth);
+                                                   parent, kWidth, kPack);
 }
 
 void DotOperandEncodingAttr::print(mlir::AsmPrinter &printer) const {
   auto mmaParent = getParent().dyn_cast<MmaEncodingAttr>();
   printer << "<{"
           << "opIdx = " << getOpIdx() << ", parent = " << getParent();
-  if ((mmaParent && mmaParent.isAmpere()) || getParent().isa<MfmaEncodingAttr>())
+  if ((mmaParent && mmaParent.isAmpere()) ||
+      getParent().isa<MfmaEncodingAttr>() ||
+      getParent().isa<WmmaEncodingAttr>())
     printer << ", kWidth = " << getKWidth();
+  if (getKPack() != 1)
+    printer << ", kPack = " << getKPack();
   printer << "}>";
 }
 
@@ -1653,6 +1859,9 @@ public:
     } else if (attr.isa<MfmaEncodingAttr>()) {
       os << "mfma";
       return AliasResult::FinalAlias;
+    } else if (attr.isa<WmmaEncodingAttr>()) {
+      os << "wmma";
+      return AliasResult::FinalAlias;
     } else if (auto sharedAttr = attr.dyn_cast<SharedEncodingAttr>()) {
       os << "shared";
       return AliasResult::FinalAlias;
@@ -1748,6 +1957,8 @@ struct TritonGPUInferLayoutInterface
       return op->emitError("mismatching encoding between A and B operands");
     if (aEncoding.getKWidth() != bEncoding.getKWidth())
       return op->emitError("mismatching kWidth between A and B operands");
+    if (aEncoding.getKPack() != bEncoding.getKPack())
+      return op->emitError("mismatching kPack between A and B operands");
     return success();
   }
 };
@@ -1764,7 +1975,8 @@ LogicalResult ConvertLayoutOp::canonicalize(ConvertLayoutOp op,
   auto dstType = op.getType().cast<RankedTensorType>();
   if (dstType.getEncoding().isa<triton::gpu::DotOperandEncodingAttr>() &&
       (srcType.getEncoding().isa<triton::gpu::MmaEncodingAttr>() ||
-       srcType.getEncoding().isa<triton::gpu::MfmaEncodingAttr>()))
+       srcType.getEncoding().isa<triton::gpu::MfmaEncodingAttr>() ||
+       srcType.getEncoding().isa<triton::gpu::WmmaEncodingAttr>()))
     return mlir::failure();
   // for hopper MMAv3
   if (!op.use_empty()) {
@@ -1,6 +1,7 @@
 #include "mlir/IR/TypeUtilities.h"
 #include "mlir/Support/LogicalResult.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "triton/Analysis/RegisterPressure.h"
 #include "triton/Analysis/Utility.h"
 #include "triton/Dialect/TritonGPU/IR/Dialect.h"
 #include "triton/Dialect/TritonGPU/Transforms/Passes.h"
@@ -9,6 +10,8 @@
 #include "llvm/Support/Debug.h"
 #include <memory>
 
+#define DEBUG_TYPE "tritonamdgpu-accelerate-matmul"
+
 using namespace mlir;
 namespace tt = mlir::triton;
 namespace ttg = mlir::triton::gpu;
@@ -21,8 +24,8 @@ using ttg::MfmaEncodingAttr;
 using ttg::SliceEncodingAttr;
 
 SmallVector<unsigned, 2>
-warpsPerTileMFMA(tt::DotOp dotOp, const ArrayRef<int64_t> shape, int numWarps) {
-  // TODO: needs to be updated with appropriate shapePerWarp etc.
+warpsPerTileMFMA(tt::DotOp dotOp, const ArrayRef<int64_t> shape, int numWarps,
+                 SmallVector<int64_t, 2> shapePerWarp = {32, 32}) {
   auto filter = [&dotOp](Operation *op) {
     return op->getParentRegion() == dotOp->getParentRegion();
   };
@@ -33,7 +36,6 @@ warpsPerTileMFMA(tt::DotOp dotOp, const ArrayRef<int64_t> shape, int numWarps) {
 
   SmallVector<int64_t, 2> tensorShape = {shape[0], shape[1]};
   SmallVector<unsigned, 2> ret = {1, 1};
-  SmallVector<int64_t, 2> shapePerWarp = {32, 32};
   bool changed = false;
 
   do {
@@ -61,11 +63,17 @@ warpsPerTileMFMA(tt::DotOp dotOp, const ArrayRef<int64_t> shape, int numWarps) {
 class BlockedToMFMA : public mlir::RewritePattern {
   int mfmaVersion;
   int enforcedNonKDim;
+  const RegisterPressureAnalysis &regPressure;
+  unsigned regBudget;
+  int kPack;
 
 public:
-  BlockedToMFMA(mlir::MLIRContext *context, int mfmaVersion, int nonKDim)
+  BlockedToMFMA(mlir::MLIRContext *context, int mfmaVersion, int nonKDim,
+                const RegisterPressureAnalysis &regPressure,
+                unsigned regBudget, int kPack)
       : mlir::RewritePattern(tt::DotOp::getOperationName(), 2, context),
-        mfmaVersion(mfmaVersion), enforcedNonKDim(nonKDim) {}
+        mfmaVersion(mfmaVersion), enforcedNonKDim(nonKDim),
+        regPressure(regPressure), regBudget(regBudget), kPack(kPack) {}
 
   bool isChainDot(tt::DotOp &dotOp) const {
     auto filter = [&dotOp](Operation *op) {
@@ -79,27 +87,50 @@ public:
     return false;
   }
 
-  /// @brief Choose MFMA instruction parameters
+  /// @brief Check if the accumulator of a dot fits in the register budget
   /// @param dot target dot operation
-  /// @return pair {nonKDim, kDim} sizes of one MFMA instruction arguments
-  std::pair<int64_t, int64_t> chooseMfmaDimensions(tt::DotOp dot) const {
-    // number of matrix elements along k dim per one MFMA intruction
-    int64_t kDim = -1;
-    auto opType = dot.getA().getType().cast<RankedTensorType>();
-    auto elemType = opType.getElementType();
+  /// @param nonKDim MN size of the MFMA instructions
+  /// @param warpsPerTile warps layout of the MFMA encoding
+  /// @param isTransposed whether the MFMA layout is transposed
+  /// @return true if the values live at `dot` fit in the budget with the
+  /// accumulator in the given MFMA layout
+  bool fitsInRegisters(tt::DotOp dot, int64_t nonKDim,
+                       ArrayRef<unsigned> warpsPerTile,
+                       bool isTransposed) const {
+    auto retType = dot.getD().getType().cast<RankedTensorType>();
+    auto mfmaEnc = ttg::MfmaEncodingAttr::get(
+        dot.getContext(), nonKDim, warpsPerTile, isTransposed,
+        ttg::getCTALayout(retType.getEncoding()));
+    auto accType = RankedTensorType::get(retType.getShape(),
+                                         retType.getElementType(), mfmaEnc);
+    unsigned accRegs = RegisterPressureAnalysis::getNumRegs(accType);
+    unsigned oldAccRegs = RegisterPressureAnalysis::getNumRegs(retType);
+    unsigned liveRegs = regPressure.getPressure(dot);
+    liveRegs = liveRegs > oldAccRegs ? liveRegs - oldAccRegs : 0;
+    return liveRegs + accRegs <= regBudget;
+  }
 
-    auto resType = dot.getD().getType().cast<RankedTensorType>();
-    auto resShape = resType.getShape();
+  /// @brief Check if an fp32 dot may use the xf32 instructions of CDNA3
+  /// @param dot target dot operation
+  /// @return true if the dot allows tf32 precision and the target has xf32
+  /// instructions
+  bool useXF32(tt::DotOp dot) const {
+    auto elemType =
+        dot.getA().getType().cast<RankedTensorType>().getElementType();
+    return mfmaVersion == 3 && elemType.isF32() && dot.getAllowTF32();
+  }
 
-    int64_t nonKDim = -1;
-    if (enforcedNonKDim != 0) {
-      nonKDim = enforcedNonKDim;
-    } else {
-      nonKDim = (resShape[0] < 32 || resShape[1] < 32) ? 16 : 32;
-    }
+  /// @brief Get the K size of one MFMA instruction
+  /// @param elemType element type of the dot operands
+  /// @param nonKDim MN size of the MFMA instruction
+  /// @param xf32 whether fp32 operands use the xf32 instructions
+  /// @return number of matrix elements along k dim per one MFMA instruction,
+  /// or -1 if there is no such instruction
+  int64_t getMfmaKDim(Type elemType, int64_t nonKDim, bool xf32) const {
+    int64_t kDim = -1;
     if (nonKDim == 32) {
       if (elemType.isF32())
-        kDim = 2;
+        kDim = xf32 ? 4 : 2;
       if (elemType.isF16())
         kDim = 8;
       if (elemType.isBF16()) {
@@ -120,9 +151,9 @@ public:
           kDim = 8;
         }
       }
-    } else {
+    } else if (nonKDim == 16) {
       if (elemType.isF32())
-        kDim = 4;
+        kDim = xf32 ? 8 : 4;
       if (elemType.isF16())
         kDim = 16;
       if (elemType.isBF16()) {
@@ -142,13 +173,146 @@ public:
         else {
           kDim = 16;
         }
-      }      
+      }
+    } else {
+      // 4x4 instructions are 16 independent blocks, each lane holds all the
+      // K elements of its row or column. There are no fp8 or xf32 ones.
+      assert(nonKDim == 4);
+      if (elemType.isF32())
+        kDim = 1;
+      if (elemType.isF16() || elemType.isInteger(8))
+        kDim = 4;
+      if (elemType.isBF16())
+        kDim = mfmaVersion == 1 ? 2 : 4;
     }
-    assert(kDim != -1);
-    assert(nonKDim != -1);
-    assert(resShape[0] % nonKDim == 0 && resShape[1] % nonKDim == 0);
-    assert(opType.getShape()[1] % kDim == 0);
-    return {nonKDim, kDim};
+    return kDim;
+  }
+
+  /// @brief Estimate the number of cycles a CTA spends in a dot
+  /// @param dot target dot operation
+  /// @param nonKDim MN size of the MFMA instructions
+  /// @param kDim K size of the MFMA instructions
+  /// @param instrShape shape of the result tile of one MFMA instruction
+  /// @param warpsPerTile warps layout of the MFMA encoding
+  /// @return the larger of the MFMA issue time and the LDS read time of the
+  /// operands
+  int64_t estimateCycles(tt::DotOp dot, int64_t nonKDim, int64_t kDim,
+                         ArrayRef<int64_t> instrShape,
+                         ArrayRef<unsigned> warpsPerTile) const {
+    auto aType = dot.getA().getType().cast<RankedTensorType>();
+    auto resShape = dot.getD().getType().cast<RankedTensorType>().getShape();
+    int64_t K = aType.getShape()[1];
+    int64_t elemBytes = std::max<int64_t>(
+        1, aType.getElementType().getIntOrFloatBitWidth() / 8);
+    int64_t numWarps = warpsPerTile[0] * warpsPerTile[1];
+
+    // Tiles a warp computes. Warps holding the same tile because the result
+    // is smaller than the warp grid do redundant work.
+    int64_t repM =
+        ceil<int64_t>(resShape[0], instrShape[0] * warpsPerTile[0]);
+    int64_t repN =
+        ceil<int64_t>(resShape[1], instrShape[1] * warpsPerTile[1]);
+    int64_t repK = K / kDim;
+
+    // Dense MFMA instructions take 2 * nonKDim cycles for all the types, the
+    // throughput per type comes from kDim. The warps of a CTA share the
+    // SIMDs of one CU.
+    constexpr int64_t numSIMDs = 4;
+    int64_t computeCycles = repM * repN * repK * 2 * nonKDim *
+                            ceil<int64_t>(numWarps, numSIMDs);
+
+    // Every warp reads its rows of A and its columns of B from LDS, so the
+    // operands are read once per warp sharing them.
+    constexpr int64_t ldsBytesPerCycle = 128;
+    int64_t ldsBytes = numWarps * (repM * instrShape[0] +
+                                   repN * instrShape[1]) * K * elemBytes;
+    int64_t ldsCycles = ceil<int64_t>(ldsBytes, ldsBytesPerCycle);
+
+    return std::max(computeCycles, ldsCycles);
+  }
+
+  struct MfmaTiling {
+    int64_t nonKDim;
+    int64_t kDim;
+    SmallVector<unsigned, 2> warpsPerTile;
+    bool isTransposed;
+    int64_t cycles;
+  };
+
+  /// @brief Choose MFMA instruction parameters and warps layout
+  /// @param dot target dot operation
+  /// @param numWarps number of warps in the CTA
+  /// @return the tiling with the lowest estimated cost among the ones that
+  /// keep the values live at `dot` in the register budget, or the cheapest
+  /// tiling if none does. Ties go to the shapes the previous heuristics
+  /// picked.
+  std::optional<MfmaTiling> chooseMfmaTiling(tt::DotOp dot,
+                                             int numWarps) const {
+    auto opType = dot.getA().getType().cast<RankedTensorType>();
+    auto elemType = opType.getElementType();
+    int64_t K = opType.getShape()[1];
+    auto resShape = dot.getD().getType().cast<RankedTensorType>().getShape();
+
+    SmallVector<int64_t, 2> nonKDims;
+    if (enforcedNonKDim != 0)
+      nonKDims = {enforcedNonKDim};
+    else if (resShape[0] < 32 || resShape[1] < 32)
+      nonKDims = {16, 32};
+    else
+      nonKDims = {32, 16};
+    // 4x4 instructions cover the results too thin for the other ones: the
+    // 16 blocks of an instruction are stacked into a 64x4 or 4x64 tile
+    bool chainDot = isChainDot(dot);
+    if (enforcedNonKDim == 0 && !chainDot &&
+        std::min(resShape[0], resShape[1]) < 16)
+      nonKDims.push_back(4);
+
+    std::optional<MfmaTiling> best;
+    bool bestFits = false;
+    for (int64_t nonKDim : nonKDims) {
+      // xf32 instructions read twice the K elements of the fp32 ones, fall
+      // back to those when K is too short
+      int64_t kDim = getMfmaKDim(elemType, nonKDim, useXF32(dot));
+      if (kDim != -1 && K % kDim != 0)
+        kDim = getMfmaKDim(elemType, nonKDim, /*xf32*/ false);
+      // The 4x4 tile is 64 wide along the larger dimension of the result
+      bool isTransposed = chainDot;
+      SmallVector<int64_t, 2> instrShape = {nonKDim, nonKDim};
+      if (nonKDim == 4) {
+        if (chainDot)
+          continue;
+        isTransposed = resShape[0] < resShape[1];
+        instrShape = isTransposed ? SmallVector<int64_t, 2>{4, 64}
+                                  : SmallVector<int64_t, 2>{64, 4};
+      }
+      if (kDim == -1 || resShape[0] % instrShape[0] != 0 ||
+          resShape[1] % instrShape[1] != 0 || K % kDim != 0)
+        continue;
+      // Chained dots keep all the warps along M, see warpsPerTileMFMA
+      SmallVector<SmallVector<unsigned, 2>> warpsCandidates = {
+          warpsPerTileMFMA(dot, resShape, numWarps, instrShape)};
+      if (!chainDot)
+        for (unsigned warpsM = 1; warpsM <= (unsigned)numWarps; warpsM *= 2)
+          warpsCandidates.push_back({warpsM, numWarps / warpsM});
+      for (auto &warpsPerTile : warpsCandidates) {
+        int64_t cycles =
+            estimateCycles(dot, nonKDim, kDim, instrShape, warpsPerTile);
+        bool fits =
+            fitsInRegisters(dot, nonKDim, warpsPerTile, isTransposed);
+        LLVM_DEBUG(llvm::dbgs()
+                   << "mfma " << nonKDim << "x" << nonKDim << "x" << kDim
+                   << ", warps [" << warpsPerTile[0] << ", " << warpsPerTile[1]
+                   << "]: " << cycles << " cycles"
+                   << (fits ? "" : ", exceeds the register budget") << "\n");
+        if (best && (bestFits > fits ||
+                     (bestFits == fits && best->cycles <= cycles)))
+          continue;
+        best =
+            MfmaTiling{nonKDim, kDim, warpsPerTile, isTransposed, cycles};
+        bestFits = fits;
+      }
+    }
+    return best;
   }
 
   mlir::LogicalResult
@@ -180,13 +344,15 @@ public:
 
     ttg::MfmaEncodingAttr mfmaEnc;
 
-    auto [nonKDim, kDim] = chooseMfmaDimensions(dotOp);
-
-    auto warpsPerTile = warpsPerTileMFMA(dotOp, retShape, numWarps);
+    auto tiling = chooseMfmaTiling(dotOp, numWarps);
+    if (!tiling)
+      return failure();
+    int64_t nonKDim = tiling->nonKDim;
+    int64_t kDim = tiling->kDim;
 
-    bool isTransposed = isChainDot(dotOp);
     mfmaEnc = ttg::MfmaEncodingAttr::get(oldRetType.getContext(), nonKDim,
-                                         warpsPerTile, isTransposed, CTALayout);
+                                         tiling->warpsPerTile,
+                                         tiling->isTransposed, CTALayout);
 
     auto newRetType =
         RankedTensorType::get(retShape, oldRetType.getElementType(), mfmaEnc);
@@ -211,18 +377,93 @@ public:
     auto kWidth = kDim;
     // in mfma 32x32 case argument matrix groups elements in 2 groups
     // in mfma 16x16 case argument matrix groups elements in 4 groups
+    // in mfma 4x4 case every thread holds all the elements along K
     if (nonKDim == 32) {
       kWidth /= 2;
-    } else {
-      assert(nonKDim == 16);
+    } else if (nonKDim == 16) {
       kWidth /= 4;
+    } else {
+      assert(nonKDim == 4);
     }
+    // each thread loads the elements of kPack instructions along K at once
+    int64_t K = oldAType.getShape()[1];
+    unsigned dotKPack = kPack > 1 && K % (kDim * kPack) == 0 ? kPack : 1;
+    kWidth *= dotKPack;
+    auto newAType = RankedTensorType::get(
+        oldAType.getShape(), oldAType.getElementType(),
+        ttg::DotOperandEncodingAttr::get(ctx, 0, mfmaEnc, kWidth, dotKPack));
+    auto newBType = RankedTensorType::get(
+        oldBType.getShape(), oldBType.getElementType(),
+        ttg::DotOperandEncodingAttr::get(ctx, 1, mfmaEnc, kWidth, dotKPack));
+    a = rewriter.create<ttg::ConvertLayoutOp>(a.getLoc(), newAType, a);
+    b = rewriter.create<ttg::ConvertLayoutOp>(b.getLoc(), newBType, b);
+    auto newDot = rewriter.create<tt::DotOp>(dotOp.getLoc(), newRetType, a, b,
+                                             newAcc, dotOp.getAllowTF32());
+    newDot->setAttr("triton_gpu.estimated_cycles",
+                    rewriter.getI64IntegerAttr(tiling->cycles));
+
+    rewriter.replaceOpWithNewOp<ttg::ConvertLayoutOp>(op, oldRetType,
+                                                      newDot.getResult());
+    return success();
+  }
+};
+
+class BlockedToWMMA : public mlir::RewritePattern {
+public:
+  BlockedToWMMA(mlir::MLIRContext *context)
+      : mlir::RewritePattern(tt::DotOp::getOperationName(), 2, context) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::Operation *op,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto dotOp = cast<tt::DotOp>(op);
+
+    auto oldRetType = dotOp.getResult().getType().cast<RankedTensorType>();
+    if (!oldRetType.getEncoding() ||
+        !oldRetType.getEncoding().isa<ttg::BlockedEncodingAttr>())
+      return failure();
+
+    if (!supportWMMA(dotOp))
+      return failure();
+
+    auto CTALayout = ttg::getCTALayout(oldRetType.getEncoding());
+
+    // get WMMA encoding for the given number of warps
+    auto retShape = oldRetType.getShape();
+    auto mod = op->getParentOfType<mlir::ModuleOp>();
+    int numWarps = ttg::TritonGPUDialect::getNumWarps(mod);
+    int warpSize = ttg::TritonGPUDialect::getThreadsPerWarp(mod);
+
+    // operands
+    Value a = dotOp.getA();
+    Value b = dotOp.getB();
+    auto oldAType = a.getType().cast<RankedTensorType>();
+    auto oldBType = b.getType().cast<RankedTensorType>();
+    auto ctx = oldAType.getContext();
+
+    // Each warp computes 16x16 tiles of the result
+    auto warpsPerTile =
+        warpsPerTileMFMA(dotOp, retShape, numWarps, {16, 16});
+    auto wmmaEnc = ttg::WmmaEncodingAttr::get(oldRetType.getContext(),
+                                              warpSize, warpsPerTile,
+                                              CTALayout);
+
+    auto newRetType =
+        RankedTensorType::get(retShape, oldRetType.getElementType(), wmmaEnc);
+
+    // convert accumulator
+    auto oldAcc = dotOp.getOperand(2);
+    auto newAcc = rewriter.create<ttg::ConvertLayoutOp>(oldAcc.getLoc(),
+                                                        newRetType, oldAcc);
+
+    // Every lane holds all the 16 elements along K of a WMMA instruction
+    unsigned kWidth = 16;
     auto newAType = RankedTensorType::get(
         oldAType.getShape(), oldAType.getElementType(),
-        ttg::DotOperandEncodingAttr::get(ctx, 0, mfmaEnc, kWidth));
+        ttg::DotOperandEncodingAttr::get(ctx, 0, wmmaEnc, kWidth));
     auto newBType = RankedTensorType::get(
         oldBType.getShape(), oldBType.getElementType(),
-        ttg::DotOperandEncodingAttr::get(ctx, 1, mfmaEnc, kWidth));
+        ttg::DotOperandEncodingAttr::get(ctx, 1, wmmaEnc, kWidth));
     a = rewriter.create<ttg::ConvertLayoutOp>(a.getLoc(), newAType, a);
     b = rewriter.create<ttg::ConvertLayoutOp>(b.getLoc(), newBType, b);
     auto newDot = rewriter.create<tt::DotOp>(dotOp.getLoc(), newRetType, a, b,
@@ -245,19 +486,28 @@ class TritonAMDGPUAccelerateMatmulPass
 public:
   TritonAMDGPUAccelerateMatmulPass() = default;
   TritonAMDGPUAccelerateMatmulPass(int matrixCoreVersion,
-                                   int matrixInstructionSize) {
+                                   int matrixInstructionSize, int wavesPerEU,
+                                   int kPack) {
     this->matrixCoreVersion = matrixCoreVersion;
     this->matrixInstructionSize = matrixInstructionSize;
+    this->wavesPerEU = wavesPerEU;
+    this->kPack = kPack;
   }
   void runOnOperation() override {
     MLIRContext *context = &getContext();
     ModuleOp m = getOperation();
+    RegisterPressureAnalysis regPressure(m);
 
     mlir::RewritePatternSet patterns(context);
     if (matrixCoreVersion == 1 || matrixCoreVersion == 2 ||
         matrixCoreVersion == 3)
-      patterns.add<::BlockedToMFMA>(context, matrixCoreVersion,
-                                    matrixInstructionSize);
+      patterns.add<::BlockedToMFMA>(
+          context, matrixCoreVersion, matrixInstructionSize, regPressure,
+          RegisterPressureAnalysis::getRegisterBudget(wavesPerEU,
+                                                      matrixCoreVersion),
+          kPack);
+    else if (matrixCoreVersion == 4)
+      patterns.add<::BlockedToWMMA>(context);
     if (applyPatternsAndFoldGreedily(m, std::move(patterns)).failed()) {
       signalPassFailure();
     }
@@ -266,7 +516,8 @@ public:
 
 std::unique_ptr<Pass>
 mlir::createTritonAMDGPUAccelerateMatmulPass(int matrixCoreVersion,
-                                             int matrixInstructionSize) {
+                                             int matrixInstructionSize,
+                                             int wavesPerEU, int kPack) {
   return std::make_unique<TritonAMDGPUAccelerateMatmulPass>(
-      matrixCoreVersion, matrixInstructionSize);
+      matrixCoreVersion, matrixInstructionSize, wavesPerEU, kPack);
 }
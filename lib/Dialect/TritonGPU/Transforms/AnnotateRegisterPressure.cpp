@@ -0,0 +1,34 @@
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "triton/Analysis/RegisterPressure.h"
+#include "triton/Dialect/Triton/IR/Dialect.h"
+#include "triton/Dialect/TritonGPU/IR/Dialect.h"
+#include "triton/Dialect/TritonGPU/Transforms/Passes.h"
+
+using namespace mlir;
+
+#define GEN_PASS_CLASSES
+#include "triton/Dialect/TritonGPU/Transforms/Passes.h.inc"
+
+namespace {
+
+struct AnnotateRegisterPressurePass
+    : public TritonGPUAnnotateRegisterPressureBase<
+          AnnotateRegisterPressurePass> {
+  void runOnOperation() override {
+    ModuleOp m = getOperation();
+    RegisterPressureAnalysis regPressure(m);
+    Builder builder(m.getContext());
+    m.walk([&](Operation *op) {
+      if (!isa<triton::FuncOp, scf::ForOp, scf::WhileOp>(op))
+        return;
+      op->setAttr("triton_gpu.estimated_vgprs",
+                  builder.getI32IntegerAttr(regPressure.getPressure(op)));
+    });
+  }
+};
+
+} // anonymous namespace
+
+std::unique_ptr<Pass> mlir::createTritonGPUAnnotateRegisterPressurePass() {
+  return std::make_unique<AnnotateRegisterPressurePass>();
+}
@@ -107,10 +107,12 @@ struct CoalescePass : public TritonGPUCoalesceBase<CoalescePass> {
                                 .getPointeeType()
                           : refTensorType.getElementType();
 
-    // Thread tile size depends on memory alignment
+    // Thread tile size depends on memory alignment and on the widest global
+    // access of the target (128 bits, i.e. ld.v4.b32 or global_load_dwordx4)
     SmallVector<unsigned, 4> sizePerThread(refTensorType.getRank(), 1);
     unsigned elemNumBits = typeForMem.getIntOrFloatBitWidth();
     unsigned elemNumBytes = std::max(elemNumBits / 8, 1u);
+    unsigned maxVecElems = std::max<unsigned>(maxVectorBits / elemNumBits, 1);
     unsigned perThread = 1;
     for (Value val : withSameOrder) {
       auto valInfo = queryAxisInfo(val);
@@ -119,7 +121,7 @@ struct CoalescePass : public TritonGPUCoalesceBase<CoalescePass> {
       unsigned maxContig =
           std::min(valInfo.getContiguity(order[0]), shapePerCTA[order[0]]);
       unsigned alignment = std::min(maxMultiple, maxContig);
-      unsigned currPerThread = std::min(alignment, 128 / elemNumBits);
+      unsigned currPerThread = std::min(alignment, maxVecElems);
       perThread = std::max(perThread, currPerThread);
     }
     sizePerThread[order[0]] = std::min<int>(perThread, numElemsPerThread);
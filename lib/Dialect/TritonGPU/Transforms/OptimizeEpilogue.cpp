@@ -5,6 +5,8 @@
 #include "mlir/Support/LogicalResult.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "mlir/Transforms/Passes.h"
+#include "triton/Analysis/AxisInfo.h"
+#include "triton/Analysis/Utility.h"
 #include "triton/Dialect/TritonGPU/IR/Dialect.h"
 #include "triton/Dialect/TritonGPU/Transforms/Passes.h"
 #include "triton/Dialect/TritonGPU/Transforms/Utility.h"
@@ -13,6 +15,55 @@ using namespace mlir;
 
 namespace {
 
+#ifdef USE_ROCM
+// Estimated per-thread cost of storing `type` with `vec` elements per store, in
+// the unit of ConvertLayoutCost::total(). A global store costs about as much
+// as moving 16 bytes through shared memory.
+static int64_t getStoreCost(RankedTensorType type, unsigned vec) {
+  constexpr int64_t storeCost = 16;
+  return ceil<int64_t>(triton::gpu::getTotalElemsPerThread(type), vec) *
+         storeCost;
+}
+
+// Whether storing `mfmaTy` directly, with vectors gathered between lanes, is
+// cheaper than converting it to the layout of `stOp` through shared memory.
+// The pointers and masks are expected to be rematerialized in the MFMA layout.
+static bool isDirectStoreCheaper(triton::StoreOp stOp,
+                                 RankedTensorType mfmaTy,
+                                 ModuleAxisInfoAnalysis &axisInfoAnalysis) {
+  Value ptr = stOp.getPtr();
+  Value mask = stOp.getMask();
+  auto ptrType = ptr.getType().cast<RankedTensorType>();
+  auto valType = stOp.getValue().getType().cast<RankedTensorType>();
+  unsigned maxVec = 128 / triton::getPointeeBitWidth(ptrType);
+  unsigned maskAlign =
+      mask ? axisInfoAnalysis.getMaskAlignment(mask) : maxVec;
+  unsigned blockedVec = std::min(
+      {maxVec, axisInfoAnalysis.getPtrContiguity(ptr), maskAlign});
+  // The MFMA layout gathers vectors along dimension 1 only
+  unsigned mfmaMaxVec = 1;
+  if (triton::gpu::getOrder(ptrType.getEncoding())[0] == 1)
+    mfmaMaxVec = std::min(
+        {maxVec, axisInfoAnalysis.getPtrAlignment(ptr), maskAlign});
+
+  int64_t directCost = getStoreCost(valType, 1);
+  if (auto vectorization = getMfmaStoreVectorization(mfmaTy, mfmaMaxVec)) {
+    ConvertLayoutCost shuffleCost;
+    shuffleCost.numShuffles =
+        vectorization->getNumPermutedUnits() *
+        ceil<int64_t>(vectorization->unitSize *
+                          mfmaTy.getElementTypeBitWidth(),
+                      32);
+    directCost = shuffleCost.total() +
+                 getStoreCost(valType, vectorization->getVectorSize());
+  }
+  int64_t sharedCost =
+      getConvertLayoutCost(mfmaTy, valType.getEncoding()).total() +
+      getStoreCost(valType, blockedVec);
+  return directCost <= sharedCost;
+}
+#endif
+
 // convert(val) : mma -> blocked
 // tt.store(ptr, val, mask, ...) : blocked
 // ==>
@@ -24,8 +75,10 @@ namespace {
 class BypassEpilogueSMEM : public mlir::RewritePattern {
 
 public:
-  explicit BypassEpilogueSMEM(mlir::MLIRContext *context)
-      : mlir::RewritePattern(triton::StoreOp::getOperationName(), 1, context) {}
+  explicit BypassEpilogueSMEM(mlir::MLIRContext *context,
+                              ModuleAxisInfoAnalysis &axisInfoAnalysis)
+      : mlir::RewritePattern(triton::StoreOp::getOperationName(), 1, context),
+        axisInfoAnalysis(axisInfoAnalysis) {}
   mlir::LogicalResult
   matchAndRewrite(mlir::Operation *op,
                   mlir::PatternRewriter &rewriter) const override {
@@ -51,7 +104,8 @@ public:
         cvtOp.getSrc().getType().cast<RankedTensorType>().getEncoding();
 
 #ifdef USE_ROCM
-    if (!encoding.isa<triton::gpu::MfmaEncodingAttr>())
+    if (!encoding.isa<triton::gpu::MfmaEncodingAttr,
+                      triton::gpu::WmmaEncodingAttr>())
       return mlir::failure();
 #else
     if (!encoding.isa<triton::gpu::MmaEncodingAttr>())
@@ -61,6 +115,14 @@ public:
     if (!cvtOp.getResult().hasOneUse())
       return mlir::failure();
 
+#ifdef USE_ROCM
+    if (encoding.isa<triton::gpu::MfmaEncodingAttr>() &&
+        !isDirectStoreCheaper(
+            stOp, cvtOp.getSrc().getType().cast<RankedTensorType>(),
+            axisInfoAnalysis))
+      return mlir::failure();
+#endif
+
     auto newEncoding =
         cvtOp.getOperand().getType().cast<RankedTensorType>().getEncoding();
 
@@ -84,6 +146,9 @@ public:
         stOp, newPtr, newVal, newMask, stOp.getCache(), stOp.getEvict());
     return mlir::success();
   }
+
+private:
+  ModuleAxisInfoAnalysis &axisInfoAnalysis;
 };
 
 } // namespace
@@ -102,8 +167,9 @@ public:
     ModuleOp m = getOperation();
 
     mlir::RewritePatternSet patterns(context);
+    ModuleAxisInfoAnalysis axisInfoAnalysis(m);
 
-    patterns.add<BypassEpilogueSMEM>(context);
+    patterns.add<BypassEpilogueSMEM>(context, axisInfoAnalysis);
 
     if (applyPatternsAndFoldGreedily(m, std::move(patterns)).failed()) {
       signalPassFailure();
@@ -0,0 +1,126 @@
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "triton/Dialect/Triton/IR/Dialect.h"
+#include "triton/Dialect/TritonGPU/IR/Dialect.h"
+#include "triton/Dialect/TritonGPU/Transforms/Passes.h"
+
+//===----------------------------------------------------------------------===//
+// This file turns a tile-parallel kernel into a persistent one.
+//
+// The kernel takes the number of tiles along x as a new, last i32 argument,
+// and the launcher shrinks the grid along x to at most `num-programs`
+// programs. Each program loops over the tiles
+//
+//   pid, pid + num_programs, pid + 2 * num_programs, ...
+//
+// and runs the original kernel body with `get_program_id x` replaced by the
+// tile index and `get_num_programs x` by the number of tiles. With
+// num-programs set to the number of programs that fit on the device at once,
+// the work is spread over a single wave of programs.
+//===----------------------------------------------------------------------===//
+
+using namespace mlir;
+
+#define GEN_PASS_CLASSES
+#include "triton/Dialect/TritonGPU/Transforms/Passes.h.inc"
+
+namespace {
+
+// A kernel can be made persistent when its body is a single block, it only
+// depends on the program id along x, and it does not call other functions
+// that could read the program id themselves.
+bool canMakePersistent(triton::FuncOp funcOp) {
+  if (!funcOp.isPublic() || !funcOp.getBody().hasOneBlock())
+    return false;
+  if (funcOp.getBody().front().getTerminator()->getNumOperands() != 0)
+    return false;
+  bool hasProgramId = false;
+  WalkResult result = funcOp.walk([&](Operation *op) {
+    if (auto pidOp = dyn_cast<triton::GetProgramIdOp>(op)) {
+      if (pidOp.getAxis() != triton::ProgramIDDim::X)
+        return WalkResult::interrupt();
+      hasProgramId = true;
+    }
+    if (isa<triton::CallOp>(op))
+      return WalkResult::interrupt();
+    return WalkResult::advance();
+  });
+  return hasProgramId && !result.wasInterrupted();
+}
+
+void makePersistent(triton::FuncOp funcOp) {
+  Location loc = funcOp.getLoc();
+  OpBuilder builder(funcOp.getContext());
+  Type i32Ty = builder.getI32Type();
+
+  // The number of tiles, which is the grid size along x the kernel was
+  // written for.
+  funcOp.insertArgument(funcOp.getNumArguments(), i32Ty, {}, loc);
+  Value numTiles = funcOp.getArguments().back();
+  SmallVector<triton::GetNumProgramsOp> numProgramsOps;
+  funcOp.walk([&](triton::GetNumProgramsOp op) {
+    if (op.getAxis() == 0)
+      numProgramsOps.push_back(op);
+  });
+  for (triton::GetNumProgramsOp op : numProgramsOps) {
+    op.getResult().replaceAllUsesWith(numTiles);
+    op.erase();
+  }
+
+  Block &body = funcOp.getBody().front();
+  Operation *returnOp = body.getTerminator();
+  builder.setInsertionPointToStart(&body);
+  Value pid = builder.create<triton::GetProgramIdOp>(
+      loc, i32Ty,
+      triton::ProgramIDDimAttr::get(builder.getContext(),
+                                    triton::ProgramIDDim::X));
+  // The step is the grid size the kernel is actually launched with, so that
+  // every grid covers all the tiles.
+  Value step = builder.create<triton::GetNumProgramsOp>(
+      loc, i32Ty, builder.getI32IntegerAttr(0));
+  auto forOp = builder.create<scf::ForOp>(loc, pid, numTiles, step);
+
+  // Move the original kernel body into the loop
+  Block *loopBody = forOp.getBody();
+  loopBody->getOperations().splice(loopBody->getTerminator()->getIterator(),
+                                   body.getOperations(),
+                                   std::next(forOp->getIterator()),
+                                   returnOp->getIterator());
+
+  // The tile index takes the place of the program id
+  SmallVector<triton::GetProgramIdOp> pidOps;
+  forOp.walk([&](triton::GetProgramIdOp op) { pidOps.push_back(op); });
+  for (triton::GetProgramIdOp op : pidOps) {
+    op.getResult().replaceAllUsesWith(forOp.getInductionVar());
+    op.erase();
+  }
+}
+
+} // anonymous namespace
+
+struct PersistentTilesPass
+    : public TritonGPUPersistentTilesBase<PersistentTilesPass> {
+  PersistentTilesPass() = default;
+  PersistentTilesPass(int numPrograms) { this->numPrograms = numPrograms; }
+
+  void runOnOperation() override {
+    if (numPrograms <= 0)
+      return;
+    SmallVector<triton::FuncOp> kernels;
+    getOperation().walk([&](triton::FuncOp funcOp) {
+      if (canMakePersistent(funcOp))
+        kernels.push_back(funcOp);
+    });
+    for (triton::FuncOp funcOp : kernels)
+      makePersistent(funcOp);
+    if (!kernels.empty())
+      getOperation()->setAttr(
+          triton::gpu::TritonGPUDialect::getPersistentTilesAttrName(),
+          UnitAttr::get(&getContext()));
+  }
+};
+
+std::unique_ptr<Pass>
+mlir::createTritonGPUPersistentTilesPass(int numPrograms) {
+  return std::make_unique<PersistentTilesPass>(numPrograms);
+}
@@ -27,8 +27,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir/IR/IRMapping.h"
+#include "triton/Analysis/RegisterPressure.h"
 #include "triton/Dialect/TritonGPU/IR/Dialect.h"
 #include "triton/Dialect/TritonGPU/Transforms/Passes.h"
+#include <limits>
 
 using namespace mlir;
 
@@ -45,6 +47,10 @@ class Prefetcher {
   ///
   // TODO: add a hook to infer prefetchWidth
   unsigned prefetchWidth = 32;
+  /// kPack of the dot operands, kept by the prefetched slices
+  unsigned kPack = 1;
+  /// regs per thread left free by the loop body within the register budget
+  unsigned numFreeRegs;
 
   /// dots to be prefetched
   SetVector<Value> dots;
@@ -70,10 +76,15 @@ class Prefetcher {
   void cloneElementwiseOps(Value &bRem, const SmallVector<Value> &vals,
                            OpBuilder &builder);
 
+  /// Return the number of regs per thread taken by the operand slices of
+  /// `dot` carried from one iteration to the next
+  unsigned getNumPrefetchedRegs(triton::DotOp dot) const;
+
 public:
   Prefetcher() = delete;
 
-  Prefetcher(scf::ForOp forOp) : forOp(forOp) {
+  Prefetcher(scf::ForOp forOp, unsigned numFreeRegs)
+      : forOp(forOp), numFreeRegs(numFreeRegs) {
     yieldOp = cast<scf::YieldOp>(forOp.getBody()->getTerminator());
   }
 
@@ -132,7 +143,7 @@ Value Prefetcher::generatePrefetch(Value v, unsigned opIdx, bool isPrologue,
       SmallVector<OpFoldResult>{intAttr(1), intAttr(1)});
 
   auto dotOperandEnc = triton::gpu::DotOperandEncodingAttr::get(
-      builder.getContext(), opIdx, dotEncoding, prefetchWidth / 8);
+      builder.getContext(), opIdx, dotEncoding, prefetchWidth / 8, kPack);
   Value prefetchSlice = builder.create<triton::gpu::ConvertLayoutOp>(
       v.getLoc(), RankedTensorType::get(shape, elementType, dotOperandEnc),
       newSmem);
@@ -140,6 +151,21 @@ Value Prefetcher::generatePrefetch(Value v, unsigned opIdx, bool isPrologue,
   return prefetchSlice;
 }
 
+unsigned Prefetcher::getNumPrefetchedRegs(triton::DotOp dot) const {
+  Attribute dotEncoding = dot.getType().cast<RankedTensorType>().getEncoding();
+  unsigned numRegs = 0;
+  for (unsigned opIdx : {0, 1}) {
+    auto type = dot->getOperand(opIdx).getType().cast<RankedTensorType>();
+    SmallVector<int64_t> shape{type.getShape().begin(), type.getShape().end()};
+    shape[opIdx == 0 ? 1 : 0] = prefetchWidth;
+    auto dotOperandEnc = triton::gpu::DotOperandEncodingAttr::get(
+        type.getContext(), opIdx, dotEncoding, prefetchWidth / 8, kPack);
+    numRegs += RegisterPressureAnalysis::getNumRegs(
+        RankedTensorType::get(shape, type.getElementType(), dotOperandEnc));
+  }
+  return numRegs;
+}
+
 LogicalResult Prefetcher::initialize() {
   Block *loop = forOp.getBody();
 
@@ -215,10 +241,14 @@ LogicalResult Prefetcher::initialize() {
       prefetchWidth = 256 / elementWidth;
     else
       prefetchWidth = 8 * aKWidth;
+    kPack = aEnc.getKPack();
 
     // Skip prefetching if kSize is less than prefetchWidth
     if (kSize < prefetchWidth)
       continue;
+    // Skip prefetching if the prefetched slices would not fit in regs
+    if (getNumPrefetchedRegs(dot) > numFreeRegs)
+      continue;
     auto aVals = getPrefetchSrc(dot.getA());
     auto bVals = getPrefetchSrc(dot.getB());
 
@@ -361,9 +391,26 @@ scf::ForOp Prefetcher::createNewForOp() {
 }
 
 struct PrefetchPass : public TritonGPUPrefetchBase<PrefetchPass> {
+  PrefetchPass() = default;
+  PrefetchPass(int wavesPerEU, int matrixCoreVersion) {
+    this->wavesPerEU = wavesPerEU;
+    this->matrixCoreVersion = matrixCoreVersion;
+  }
+
   void runOnOperation() override {
+    std::optional<RegisterPressureAnalysis> regPressure;
+    if (wavesPerEU >= 0)
+      regPressure.emplace(getOperation());
+    unsigned budget = RegisterPressureAnalysis::getRegisterBudget(
+        wavesPerEU, matrixCoreVersion);
     getOperation()->walk([&](scf::ForOp forOp) {
-      Prefetcher prefetcher(forOp);
+      // Without a budget every prefetch fits.
+      unsigned numFreeRegs = std::numeric_limits<unsigned>::max();
+      if (regPressure) {
+        unsigned loopRegs = regPressure->getPressure(forOp);
+        numFreeRegs = budget > loopRegs ? budget - loopRegs : 0;
+      }
+      Prefetcher prefetcher(forOp, numFreeRegs);
 
       if (prefetcher.initialize().failed())
         return;
@@ -382,6 +429,7 @@ struct PrefetchPass : public TritonGPUPrefetchBase<PrefetchPass> {
 
 } // anonymous namespace
 
-std::unique_ptr<Pass> mlir::createTritonGPUPrefetchPass() {
-  return std::make_unique<PrefetchPass>();
+std::unique_ptr<Pass> mlir::createTritonGPUPrefetchPass(int wavesPerEU,
+                                                       int matrixCoreVersion) {
+  return std::make_unique<PrefetchPass>(wavesPerEU, matrixCoreVersion);
 }
@@ -17,8 +17,11 @@
 #include "triton/Dialect/TritonGPU/Transforms/Passes.h"
 #include "triton/Dialect/TritonGPU/Transforms/TritonGPUConversion.h"
 #include "triton/Dialect/TritonGPU/Transforms/Utility.h"
+#include "llvm/Support/Debug.h"
 #include <memory>
 
+#define DEBUG_TYPE "tritongpu-remove-layout-conversions"
+
 using namespace mlir;
 namespace {
 using triton::DotOp;
@@ -214,6 +217,8 @@ private:
   llvm::MapVector<Value, LayoutInfo> layouts;
   // map of the values rewrite based on their encoding.
   DenseMap<std::pair<Value, Attribute>, Value> rewriteMapping;
+  // conversions of rewritten values inserted by getValueAs.
+  DenseMap<std::pair<Value, Attribute>, Value> convertMapping;
   std::vector<Operation *> opToDelete;
   triton::FuncOp funcOp;
 };
@@ -257,7 +262,8 @@ static bool hasConvertToMMATransisitiveUse(Operation *op, Attribute encoding) {
 
 #ifdef USE_ROCM
 // Look ahead to at the transitive uses and see if there is a convert to mfma
-// operations.
+// operations, either as an accumulator or as an operand of a chained dot, or a
+// reduction that can be lowered in the mfma layout.
 // TODO: unify with hasConvertToMMATransisitiveUse?
 static bool hasConvertToMFMATransisitiveUse(Operation *op, Attribute encoding) {
   SmallVector<Value> queue = {op->getResult(0)};
@@ -269,12 +275,18 @@ static bool hasConvertToMFMATransisitiveUse(Operation *op, Attribute encoding) {
     getForwardSlice(currentValue, &forwardSlice);
     for (Operation *op : forwardSlice) {
       if (auto convertOp = dyn_cast<triton::gpu::ConvertLayoutOp>(op)) {
-        if (convertOp.getResult()
-                .getType()
-                .cast<RankedTensorType>()
-                .getEncoding() == encoding)
+        Attribute dstEncoding =
+            convertOp.getType().cast<RankedTensorType>().getEncoding();
+        if (dstEncoding == encoding)
           return true;
+        if (auto dotOperand =
+                dstEncoding.dyn_cast<triton::gpu::DotOperandEncodingAttr>())
+          if (dotOperand.getParent() == encoding)
+            return true;
       }
+      if (isa<triton::ReduceOp>(op) &&
+          encoding.isa<triton::gpu::MfmaEncodingAttr>())
+        return true;
       auto yield = dyn_cast<scf::YieldOp>(op);
       if (!yield)
         continue;
@@ -304,6 +316,21 @@ static bool isLayoutAnchor(Operation *op) {
 }
 
 void LayoutPropagation::initAnchorLayout() {
+  // The look-ahead for conversions back to MMA layouts walks the forward
+  // slice of every dot, so skip it when the function has no such conversion.
+  DenseSet<Attribute> convertEncodings;
+  funcOp.walk([&](triton::gpu::ConvertLayoutOp convertOp) {
+    Attribute encoding =
+        convertOp.getResult().getType().cast<RankedTensorType>().getEncoding();
+    convertEncodings.insert(encoding);
+    if (auto dotOperand =
+            encoding.dyn_cast<triton::gpu::DotOperandEncodingAttr>())
+      convertEncodings.insert(dotOperand.getParent());
+  });
+#ifdef USE_ROCM
+  bool hasReduce = false;
+  funcOp.walk([&](triton::ReduceOp) { hasReduce = true; });
+#endif
   funcOp.walk([&](Operation *op) {
     if (isLayoutAnchor(op)) {
       for (auto result : op->getResults()) {
@@ -313,18 +340,23 @@ void LayoutPropagation::initAnchorLayout() {
           // layout that may have lower performance.
           // This can be improved with more aggressive backward propagation.
           if (tensorType.getEncoding().isa<triton::gpu::MmaEncodingAttr>() &&
-              !hasConvertToMMATransisitiveUse(op, tensorType.getEncoding()))
+              (!convertEncodings.count(tensorType.getEncoding()) ||
+               !hasConvertToMMATransisitiveUse(op, tensorType.getEncoding())))
             continue;
 #ifdef USE_ROCM
           // Workaround to not propagate MFMA layout in case there are
-          // no chained dots MFMA layout is expensive to convert, so we want
-          // to convert it to something else as soon as possible.
-          // It saves LDS space in some cases.
+          // no chained dots or reductions. MFMA layout is expensive to
+          // convert, so we want to convert it to something else as soon as
+          // possible. It saves LDS space in some cases.
           //
           // TODO: rework this heuristic if we can store MFMA layout directly
           // into global memory.
-          if (tensorType.getEncoding().isa<triton::gpu::MfmaEncodingAttr>() &&
-              !hasConvertToMFMATransisitiveUse(op, tensorType.getEncoding()))
+          if (tensorType.getEncoding()
+                  .isa<triton::gpu::MfmaEncodingAttr,
+                       triton::gpu::WmmaEncodingAttr>() &&
+              ((!hasReduce &&
+                !convertEncodings.count(tensorType.getEncoding())) ||
+               !hasConvertToMFMATransisitiveUse(op, tensorType.getEncoding())))
             continue;
 #endif
           layouts.insert({result, tensorType.getEncoding()});
@@ -434,8 +466,34 @@ void LayoutPropagation::resolveConflicts() {
     LayoutInfo &info = it.second;
     if (info.encodings.size() <= 1)
       continue;
-    // Hacky resolve, prefer block encoding.
-    // TODO: add a proper heuristic.
+#ifdef USE_ROCM
+    // Each candidate layout was propagated from a producer, so picking one
+    // means converting the values coming in the other layouts. Users the
+    // propagation did not reach keep the original layout and need a
+    // conversion back. Ties go to the first blocked encoding.
+    Value value = it.first;
+    auto tensorType = value.getType().cast<RankedTensorType>();
+    auto getCost = [&](Attribute encoding) {
+      auto type = RankedTensorType::get(tensorType.getShape(),
+                                        tensorType.getElementType(), encoding);
+      int64_t cost = 4 * getNumRegsPerThread(type);
+      for (Attribute other : info.encodings) {
+        auto otherType = RankedTensorType::get(
+            tensorType.getShape(), tensorType.getElementType(), other);
+        cost += getConvertLayoutCost(otherType, encoding).total();
+      }
+      for (Operation *user : value.getUsers()) {
+        if (isa<scf::YieldOp, scf::ForOp, scf::WhileOp, scf::ConditionOp>(
+                user) ||
+            llvm::any_of(user->getResults(),
+                         [&](Value result) { return layouts.count(result); }))
+          continue;
+        cost += getConvertLayoutCost(type, tensorType.getEncoding()).total();
+      }
+      return cost;
+    };
+#endif
+    // Without a cost model (and on ties) prefer the blocked encoding.
     Attribute encoding = *info.encodings.begin();
     for (Attribute e : info.encodings) {
       if (e.isa<triton::gpu::BlockedEncodingAttr>()) {
@@ -443,6 +501,21 @@ void LayoutPropagation::resolveConflicts() {
         break;
       }
     }
+#ifdef USE_ROCM
+    int64_t bestCost = getCost(encoding);
+    for (Attribute e : info.encodings) {
+      int64_t cost = getCost(e);
+      LLVM_DEBUG({
+        llvm::dbgs() << "resolve ";
+        value.printAsOperand(llvm::dbgs(), OpPrintingFlags());
+        llvm::dbgs() << ": cost " << cost << " for " << e << "\n";
+      });
+      if (cost < bestCost) {
+        encoding = e;
+        bestCost = cost;
+      }
+    }
+#endif
     info.encodings.clear();
     info.encodings.insert(encoding);
   }
@@ -549,13 +622,17 @@ Value LayoutPropagation::getValueAs(Value value, Attribute encoding) {
     if (rewrittenValue.getType().cast<RankedTensorType>().getEncoding() ==
         encoding)
       return rewrittenValue;
+    // The conversion is inserted right after the definition, so it can be
+    // reused by all the other users.
+    Value &converted = convertMapping[{rewrittenValue, encoding}];
+    if (converted)
+      return converted;
     OpBuilder rewriter(value.getContext());
     rewriter.setInsertionPointAfterValue(rewrittenValue);
     auto tmpType = RankedTensorType::get(tensorType.getShape(),
                                          tensorType.getElementType(), encoding);
-    Value converted = rewriter.create<triton::gpu::ConvertLayoutOp>(
+    converted = rewriter.create<triton::gpu::ConvertLayoutOp>(
         value.getLoc(), tmpType, rewrittenValue);
-    // TODO: we could cache the conversion.
     return converted;
   }
   return value;
@@ -958,33 +1035,165 @@ static LogicalResult getRematerializableSlice(
   return success();
 }
 
-static void backwardRematerialization(ConvertLayoutOp convertOp) {
+namespace {
+// Rematerializes or hoists the conversions left after layout propagation.
+//
+// The conversions are collected once into a worklist. Each of them is first
+// rematerialized when possible, and the ones left are then hoisted above
+// type extensions. Rematerialization plans are memoized per (value, target
+// encoding) across the whole worklist. The backward slices are cached per
+// (root, encoding) until the next rewrite, so conversions that cannot be
+// rewritten share their slice computations.
+class ConvertLayoutRewriter {
+public:
+  explicit ConvertLayoutRewriter(ModuleOp module) {
+    module.walk(
+        [&](ConvertLayoutOp convertOp) { worklist.push_back(convertOp); });
+  }
+
+  void run() {
+    SmallVector<ConvertLayoutOp> remaining;
+    for (ConvertLayoutOp convertOp : worklist)
+      if (!backwardRematerialization(convertOp))
+        remaining.push_back(convertOp);
+    for (ConvertLayoutOp convertOp : remaining)
+      hoistConvertOnTopOfExt(convertOp);
+  }
+
+private:
+  struct CachedSlice {
+    bool succeeded;
+    SetVector<Value> slice;
+    DenseMap<Value, Attribute> layout;
+  };
+
+  // getRematerializableSlice, cached until the next rewrite. `stopAtExt`
+  // selects the propagation that stops at type extensions.
+  LogicalResult getSlice(Value root, Attribute rootEncoding, bool stopAtExt,
+                         SetVector<Value> &slice,
+                         DenseMap<Value, Attribute> &layout) {
+    auto key = std::make_tuple(root, rootEncoding, unsigned(stopAtExt));
+    auto it = sliceCache.find(key);
+    if (it == sliceCache.end()) {
+      CachedSlice cached;
+      cached.succeeded =
+          getRematerializableSlice(root, rootEncoding, cached.slice,
+                                   cached.layout,
+                                   stopAtExt ? isExtOp : nullptr)
+              .succeeded();
+      it = sliceCache.insert({key, std::move(cached)}).first;
+    }
+    if (!it->second.succeeded)
+      return failure();
+    slice = it->second.slice;
+    layout = it->second.layout;
+    return success();
+  }
+
+  // Rewrites erase the conversion and may erase loops, so none of the cached
+  // slices can be trusted afterwards. Every other IR change clears the cache
+  // as well.
+  void rewrite(SetVector<Value> &slice, DenseMap<Value, Attribute> &layout,
+               ConvertLayoutOp convertOp, IRMapping &mapping) {
+    sliceCache.clear();
+    rewriteSlice(slice, layout, convertOp, mapping);
+  }
+
+  static bool isExtOp(Operation *op) {
+#ifndef USE_ROCM
+    return isa<arith::ExtSIOp, arith::ExtUIOp, arith::ExtFOp>(op);
+#else
+    return isa<arith::ExtSIOp, arith::ExtUIOp, arith::ExtFOp,
+               triton::BroadcastOp, triton::ExpandDimsOp>(op);
+#endif
+  }
+
+  bool backwardRematerialization(ConvertLayoutOp convertOp);
+
+  void hoistConvertOnTopOfExt(ConvertLayoutOp convertOp);
+
+  SmallVector<ConvertLayoutOp> worklist;
+  // Outcome of rematerializing a value in a given encoding: the
+  // rematerialized value, or null if the value cannot or should not be
+  // rematerialized.
+  DenseMap<std::pair<Value, Attribute>, Value> rematMapping;
+  DenseMap<std::tuple<Value, Attribute, unsigned>, CachedSlice> sliceCache;
+};
+} // namespace
+
+// Returns true if `convertOp` was rewritten (and erased).
+bool ConvertLayoutRewriter::backwardRematerialization(
+    ConvertLayoutOp convertOp) {
   // we don't want to rematerialize any conversion to/from shared
   if (triton::gpu::isSharedEncoding(convertOp.getResult()) ||
       triton::gpu::isSharedEncoding(convertOp.getOperand()))
-    return;
+    return false;
   // we don't handle conversions to DotOperandEncodingAttr
   // this is a heuristics to accommodate fused attention
   auto targetType = convertOp->getResultTypes()[0].cast<RankedTensorType>();
   if (targetType.getEncoding().isa<triton::gpu::DotOperandEncodingAttr>())
-    return;
+    return false;
+
+  // Values defined by conversions or loops may be erased by the rewrites of
+  // other conversions, so only the others can be memoized. The slice of a
+  // value does not change when other slices are rematerialized: those are
+  // cloned, and only the uses of their conversion are replaced.
+  Value operand = convertOp.getOperand();
+  bool memoize = !operand.getDefiningOp<ConvertLayoutOp>() &&
+                 !operand.getDefiningOp<scf::ForOp>();
+  std::pair<Value, Attribute> key = {operand, targetType.getEncoding()};
+  if (memoize) {
+    auto it = rematMapping.find(key);
+    if (it != rematMapping.end()) {
+      // The rematerialized value is defined next to the original one.
+      if (!it->second)
+        return false;
+      sliceCache.clear();
+      convertOp.replaceAllUsesWith(it->second);
+      convertOp.erase();
+      return true;
+    }
+    rematMapping[key] = Value();
+  }
 
   // 1. Take a backward slice of all the tensor dependencies that can be
   // rematerialized.
   SetVector<Value> slice;
   DenseMap<Value, Attribute> layout;
-  LogicalResult result = getRematerializableSlice(
-      convertOp.getOperand(), targetType.getEncoding(), slice, layout);
+  LogicalResult result = getSlice(operand, targetType.getEncoding(),
+                                  /*stopAtExt=*/false, slice, layout);
   if (result.failed())
-    return;
+    return false;
+
+#ifdef USE_ROCM
+  // 2. Only rematerialize when it is cheaper than the conversion.
+  int64_t rematCost = 0;
+  for (Value v : slice)
+    if (Operation *op = v.getDefiningOp())
+      rematCost += getRematerializationCost(op, layout[v]);
+  int64_t convertCost =
+      getConvertLayoutCost(
+          convertOp.getOperand().getType().cast<RankedTensorType>(),
+          targetType.getEncoding())
+          .total();
+  LLVM_DEBUG(llvm::dbgs() << "rematerialize " << convertOp << ": cost "
+                          << rematCost << " vs convert cost " << convertCost
+                          << "\n");
+  if (rematCost > convertCost)
+    return false;
+#endif
 
-  // 2. Rewrite the slice.
-  rewriteSlice(slice, layout, convertOp);
+  // 3. Rewrite the slice.
+  IRMapping mapping;
+  rewrite(slice, layout, convertOp, mapping);
+  if (memoize)
+    rematMapping[key] = mapping.lookup(operand);
+  return true;
 }
 
 // For convert left we try to hoist them above type extension to reduce the cost
 // of the convert.
-static void hoistConvertOnTopOfExt(ConvertLayoutOp convertOp) {
+void ConvertLayoutRewriter::hoistConvertOnTopOfExt(ConvertLayoutOp convertOp) {
   // we don't want to rematerialize any conversion to/from shared
   if (triton::gpu::isSharedEncoding(convertOp.getResult()) ||
       triton::gpu::isSharedEncoding(convertOp.getOperand()))
@@ -995,21 +1204,12 @@ static void hoistConvertOnTopOfExt(ConvertLayoutOp convertOp) {
   if (targetType.getEncoding().isa<triton::gpu::DotOperandEncodingAttr>())
     return;
 
-#ifndef USE_ROCM
-  auto isExtOp = [](Operation *op) {
-    return isa<arith::ExtSIOp, arith::ExtUIOp, arith::ExtFOp>(op);
-  };
-#else
-  auto isExtOp = [](Operation *op) {
-    return isa<arith::ExtSIOp, arith::ExtUIOp, arith::ExtFOp,
-              triton::BroadcastOp, triton::ExpandDimsOp>(op);
-  };
-#endif
   // 1. Take a backward slice of all the tensor dependencies.
   SetVector<Value> slice;
   DenseMap<Value, Attribute> layout;
-  LogicalResult result = getRematerializableSlice(
-      convertOp.getOperand(), targetType.getEncoding(), slice, layout, isExtOp);
+  LogicalResult result = getSlice(convertOp.getOperand(),
+                                  targetType.getEncoding(),
+                                  /*stopAtExt=*/true, slice, layout);
   if (result.failed())
     return;
 
@@ -1026,8 +1226,9 @@ static void hoistConvertOnTopOfExt(ConvertLayoutOp convertOp) {
       std::optional<Attribute> srcEncoding = inferSrcEncoding(op, layout[v]);
       if (!srcEncoding)
         return;
-      LogicalResult result = getRematerializableSlice(
-          op->getOperand(0), *srcEncoding, tempSlice, tempLayout);
+      LogicalResult result = getSlice(op->getOperand(0), *srcEncoding,
+                                      /*stopAtExt=*/false, tempSlice,
+                                      tempLayout);
       // If we can rematerialize the rest of the ext slice we can ignore this
       // ext as it won't need a convert.
       if (result.succeeded()) {
@@ -1048,6 +1249,7 @@ static void hoistConvertOnTopOfExt(ConvertLayoutOp convertOp) {
   std::optional<Attribute> srcEncoding =
        inferSrcEncoding(extOp, layout[extOp->getResult(0)]);
   // Move the convert before the ext op and rewrite the slice.
+  sliceCache.clear();
   OpBuilder builder(extOp);
   auto tensorType = extOp->getOperand(0).getType().cast<RankedTensorType>();
   auto newType =
@@ -1058,25 +1260,7 @@ static void hoistConvertOnTopOfExt(ConvertLayoutOp convertOp) {
   IRMapping mapping;
   mapping.map(extOp->getOperand(0), newConvertOp.getResult());
   // 3. Rewrite the slice.
-  rewriteSlice(slice, layout, convertOp, mapping);
-}
-
-static void backwardRematerialization(ModuleOp module) {
-  SmallVector<ConvertLayoutOp> convertOps;
-  module.walk(
-      [&](ConvertLayoutOp convertOp) { convertOps.push_back(convertOp); });
-  for (ConvertLayoutOp convertOp : convertOps) {
-    backwardRematerialization(convertOp);
-  }
-}
-
-static void hoistConvert(ModuleOp module) {
-  SmallVector<ConvertLayoutOp> convertOps;
-  module.walk(
-      [&](ConvertLayoutOp convertOp) { convertOps.push_back(convertOp); });
-  for (ConvertLayoutOp convertOp : convertOps) {
-    hoistConvertOnTopOfExt(convertOp);
-  }
+  rewrite(slice, layout, convertOp, mapping);
 }
 
 #define GEN_PASS_CLASSES
@@ -1109,11 +1293,10 @@ public:
     }
 
     // 2. For convert ops left try to rematerialize the slice of producer
-    // operation to avoid having to convert.
-    backwardRematerialization(m);
-    // 3. For converts left try to hoist them above cast generating larger size
-    // types in order to reduce the cost of the convert op.
-    hoistConvert(m);
+    // operation to avoid having to convert, and hoist the ones that remain
+    // above cast generating larger size types in order to reduce the cost of
+    // the convert op.
+    ConvertLayoutRewriter(m).run();
 
     mlir::RewritePatternSet decomposePatterns(context);
     decomposePatterns.add<DecomposeDotOperand>(context);
@@ -1133,6 +1316,26 @@ public:
             .failed()) {
       signalPassFailure();
     }
+
+    LLVM_DEBUG({
+      m.walk([](triton::FuncOp funcOp) {
+        int64_t totalCost = 0;
+        funcOp.walk([&](ConvertLayoutOp convertOp) {
+          ConvertLayoutCost cost = getConvertLayoutCost(
+              convertOp.getOperand().getType().cast<RankedTensorType>(),
+              convertOp.getType().cast<RankedTensorType>().getEncoding());
+          llvm::dbgs() << convertOp << "\n  shared bytes: "
+                       << cost.sharedBytes
+                       << ", barriers: " << cost.numBarriers
+                       << ", shuffles: " << cost.numShuffles
+                       << ", duplicated registers: " << cost.regDuplication
+                       << ", total: " << cost.total() << "\n";
+          totalCost += cost.total();
+        });
+        llvm::dbgs() << "@" << funcOp.getName()
+                     << ": total conversion cost " << totalCost << "\n";
+      });
+    });
   }
 };
 
@@ -13,6 +13,7 @@
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "mlir/Transforms/Passes.h"
 #include "mlir/Transforms/RegionUtils.h"
+#include "triton/Analysis/Alias.h"
 #include "triton/Analysis/Utility.h"
 #include "triton/Dialect/TritonGPU/IR/Dialect.h"
 #include "triton/Dialect/TritonGPU/Transforms/Passes.h"
@@ -98,6 +99,30 @@ public:
         return;
       moveAfter(op, argOp);
     });
+    // Move loads above preceding stores that provably write other buffers, so
+    // that their latency overlaps with the stores.
+    GlobalMemoryAliasAnalysis aliasAnalysis;
+    m.walk([&](triton::LoadOp op) {
+      if (op.getIsVolatile())
+        return;
+      Operation *insertPt = nullptr;
+      for (Operation *prev = op->getPrevNode(); prev;
+           prev = prev->getPrevNode()) {
+        if (getWSRoleId(prev) != getWSRoleId(op))
+          break;
+        if (llvm::any_of(op->getOperands(), [&](Value operand) {
+              return operand.getDefiningOp() == prev;
+            }))
+          break;
+        if (aliasAnalysis.mayClobber(prev, op.getPtr()))
+          break;
+        if (isa<triton::StoreOp, triton::AtomicRMWOp, triton::AtomicCASOp>(
+                prev))
+          insertPt = prev;
+      }
+      if (insertPt)
+        op->moveBefore(insertPt);
+    });
     // Move `dot` operand so that conversions to opIdx=1 happens after
     // conversions to opIdx=0
 #ifdef USE_ROCM
@@ -1,9 +1,12 @@
+#include "mlir/Analysis/SliceAnalysis.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/IR/IRMapping.h"
 #include "mlir/IR/TypeUtilities.h"
 #include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "triton/Analysis/Alias.h"
 #include "triton/Analysis/AxisInfo.h"
+#include "triton/Analysis/RegisterPressure.h"
 #include "triton/Analysis/Utility.h"
 #include "triton/Dialect/TritonGPU/IR/Dialect.h"
 #include "triton/Dialect/TritonGPU/Transforms/Passes.h"
@@ -30,6 +33,25 @@
 //   - Store next tile into shared mem
 // - Epilogue: Peeled non-load loop body for last iteration
 //
+// With more than two stages, the tile used at iteration i is loaded from
+// global memory at iteration i - (numStages - 1), so that the latency of
+// the load is covered by numStages - 1 iterations of compute:
+// - Prologue: Load the tiles of the first numStages - 1 iterations. The first
+// one is stored to shared memory, the others are kept in registers.
+// - Pipelined Loop: Assemble the whole loop body
+//   - Prefetch the tile of iteration i + numStages - 1 into regs, masked off
+//   past the end of the loop
+//   - Non-load loop body, reading the current tile from a ring of shared
+//   memory buffers indexed by iteration
+//   - Store the oldest tile held in regs (the one of iteration i + 1) into the
+//   next buffer of the ring, so that it never overwrites the tile being read
+//
+// Loads whose results do not reach a dot are pipelined the same way, with
+// the tile of the current iteration handed to their users in its original
+// layout. Depending on an estimate of the registers it costs, the current
+// tile is either kept in regs or staged through shared mem like dot operands
+// and converted back before its first use.
+//
 //===----------------------------------------------------------------------===//
 
 using llvm::MapVector;
@@ -55,6 +77,8 @@ class LoopPipeliner {
   SetVector<Operation *> validLoads;
   /// The value that each load will be mapped to (after layout conversion)
   DenseMap<Value, Value> convertMapping;
+  /// Loads without dot uses whose current tile is kept in regs
+  DenseSet<Operation *> regLoads;
   /// load => buffer
   DenseMap<Value, Value> loadsBuffer;
   /// load => buffer type (with shared layout after swizzling)
@@ -67,13 +91,40 @@ class LoopPipeliner {
   SmallVector<Value> nextBuffers;
   SmallVector<Value> yieldValues;
 
-  /// The number of stages in the pipeline is fixed to '2' for
-  /// analysis since there will be a current buffer stored in
-  /// shared mem and a next buffer stored in regs.
+  /// The number of stages in the pipeline. With two stages there is a
+  /// current buffer stored in shared mem and a next buffer stored in regs.
+  /// Each additional stage keeps one more tile in flight in regs.
   int numStages = 2;
 
+  /// The number of shared mem buffers in the ring used with more than two
+  /// stages: one being read and one being written.
+  static constexpr int numRingBuffers = 2;
+
+  /// The number of regs per thread that tiles of loads without dot uses may
+  /// occupy before the remaining ones are staged through shared mem.
+  static constexpr unsigned maxPrefetchRegs = 64;
+
+  /// The number of regs per thread left free by the loop body within the
+  /// register budget, which the tiles in flight should fit in.
+  unsigned numFreeRegs;
+
+  /// load => tiles of iterations [1, numStages - 1) loaded by the prologue
+  DenseMap<Value, SmallVector<Value>> loadsPrefetched;
+
+  /// Index of the ring buffer holding the tile of the first iteration
+  Value ringIdxInit;
+
+  /// Index of the ring buffer holding the tile of the current iteration
+  Value curRingIdx;
+
+  /// Index of the ring buffer holding the tile of the next iteration
+  Value nextRingIdx;
+
+  /// Tiles kept in regs for the next iteration
+  SmallVector<Value> nextPrefetched;
+
   /// Arg indicies
-  size_t bufferIdx, depArgsBeginIdx;
+  size_t bufferIdx, prefetchedIdx, ringIdx, depArgsBeginIdx;
   DenseMap<BlockArgument, size_t> depArgsIdx;
 
   /// value (in loop) => value at stage N
@@ -113,6 +164,9 @@ class LoopPipeliner {
   /// Check if none of the for-ops has valid uses
   LogicalResult checkOpUses();
 
+  /// Check if `loadOp` can be pipelined although it does not feed a dot
+  bool isPrefetchCandidate(triton::LoadOp loadOp);
+
   /// Check if ops have dependencies that are not pipelinable
   LogicalResult checkOpDeps();
 
@@ -148,6 +202,21 @@ class LoopPipeliner {
   scf::ForOp cloneForOp(ArrayRef<Value> newLoopArgs, OpBuilder &builder);
 
   void updateLoadMask(triton::LoadOp loadOp, Value newMask);
+
+  /// Return the loop carried tiles of `loadOp` kept in regs
+  ArrayRef<BlockArgument> getPrefetchedArgs(Operation *loadOp);
+
+  /// Store `tile` into the ring buffer `ring` at `idx`
+  Value insertIntoRing(OpBuilder &builder, Operation *loadOp, Value ring,
+                       Value tile, OpFoldResult idx);
+
+  /// Return a view of the ring buffer `ring` at `idx`
+  Value extractFromRing(OpBuilder &builder, Operation *loadOp, Value ring,
+                        Value idx);
+
+  /// Return the tile of `loadOp` held by `buffer` as seen by its users
+  Value getCurrentTile(OpBuilder &builder, Operation *loadOp, Value buffer);
+
   /// Prefetch the next iteration for `pplForOp`
   void prefetchNextBuffer(OpBuilder &builder);
   void cloneCurrentBody(OpBuilder &builder);
@@ -159,14 +228,21 @@ class LoopPipeliner {
   void finalizeYield(OpBuilder &builder);
 
 public:
-  LoopPipeliner(scf::ForOp forOp)
-      : forOp(forOp) {
+  LoopPipeliner(scf::ForOp forOp, int numStages, unsigned numFreeRegs)
+      : forOp(forOp), numStages(numStages), numFreeRegs(numFreeRegs) {
     yieldOp = cast<scf::YieldOp>(forOp.getBody()->getTerminator());
+    // With more stages, the loads past the end of the loop are masked off
+    // instead of peeling iterations.
+    peelLastIter = numStages == 2;
   }
 
   /// Collect loads to pipeline. Return success if we can pipeline this loop
   LogicalResult initialize();
 
+  /// Return the number of regs per thread taken by the tiles in flight, on
+  /// top of the ones the loop body already holds
+  unsigned getNumPipelinedRegs() const;
+
   /// Emit pipelined loads (before loop body)
   void emitPrologue();
 
@@ -232,6 +308,7 @@ LogicalResult LoopPipeliner::checkOpUses() {
   MapVector<Operation *, SetVector<Operation*>> opDeps;
   collectDeps(ops, opDeps);
 
+  unsigned numPrefetchRegs = 0;
   for (Operation *op : ops) {
     auto loadOp = dyn_cast<triton::LoadOp>(op);
     // Don't pipeline valid loads that depend on other valid loads
@@ -245,6 +322,7 @@ LogicalResult LoopPipeliner::checkOpUses() {
           isCandidate = false;
           break;
         }
+    bool dependsOnLoad = !isCandidate;
     // We only pipeline loads that have one covert_layout (to dot_op) use
     // TODO: lift this constraint in the future
     if (isCandidate && loadOp.getResult().hasOneUse()) {
@@ -276,6 +354,20 @@ LogicalResult LoopPipeliner::checkOpUses() {
     } else
       isCandidate = false;
 
+    // Loads that do not feed a dot keep their tile in regs while it fits in
+    // the budget, the rest go through shared mem. The current tile and the
+    // ones in flight are all live in regs at the same time.
+    if (!isCandidate && !dependsOnLoad && isPrefetchCandidate(loadOp)) {
+      isCandidate = true;
+      auto ty = loadOp.getType().cast<RankedTensorType>();
+      unsigned numRegs =
+          numStages * RegisterPressureAnalysis::getNumRegs(ty);
+      if (numPrefetchRegs + numRegs <= std::min(maxPrefetchRegs, numFreeRegs)) {
+        numPrefetchRegs += numRegs;
+        regLoads.insert(op);
+      }
+    }
+
     if (isCandidate)
       validLoads.insert(op);
   }
@@ -283,6 +375,30 @@ LogicalResult LoopPipeliner::checkOpUses() {
   return validLoads.empty() ? failure() : success();
 }
 
+bool LoopPipeliner::isPrefetchCandidate(triton::LoadOp loadOp) {
+  auto ty = loadOp.getType().dyn_cast<RankedTensorType>();
+  if (!ty || !ty.getEncoding().isa<ttg::BlockedEncodingAttr>())
+    return false;
+  // The users are cloned with the tile of the current iteration, so the
+  // tile itself must not escape the loop body
+  for (Operation *user : loadOp->getUsers())
+    if (user->getBlock() != forOp.getBody() || user == yieldOp)
+      return false;
+  SetVector<Operation *> slice;
+  getForwardSlice(loadOp.getResult(), &slice);
+  if (llvm::any_of(slice, [](Operation *op) { return isa<triton::DotOp>(op); }))
+    return false;
+  // The load is issued numStages - 1 iterations ahead, before the writes of
+  // the iterations in between, so it must not read memory they may write
+  GlobalMemoryAliasAnalysis aliasAnalysis;
+  WalkResult result = forOp.getBody()->walk([&](Operation *op) {
+    if (aliasAnalysis.mayClobber(op, loadOp.getPtr()))
+      return WalkResult::interrupt();
+    return WalkResult::advance();
+  });
+  return !result.wasInterrupted();
+}
+
 LogicalResult LoopPipeliner::checkOpDeps() {
   /// arg => source operand defined stages
   DenseMap<BlockArgument, DenseSet<int>> immediateArgStages;
@@ -410,6 +526,23 @@ void LoopPipeliner::createBufferTypes() {
                                      ttg::getOrder(ty.getEncoding()), CTALayout, eType);
     loadsBufferType[loadOp] = RankedTensorType::get(bufferShape, eType, sharedEnc);
   }
+  // Loads without dot uses either stay in their layout or use a plain shared
+  // layout, as they are converted back to their layout before being used
+  for (Operation *op : validLoads) {
+    Value loadOp = op->getResult(0);
+    if (convertMapping.contains(loadOp))
+      continue;
+    auto ty = loadOp.getType().cast<RankedTensorType>();
+    if (regLoads.contains(op)) {
+      loadsBufferType[loadOp] = ty;
+      continue;
+    }
+    auto sharedEnc = ttg::SharedEncodingAttr::get(
+        ty.getContext(), 1, 1, 1, ttg::getOrder(ty.getEncoding()),
+        ttg::getCTALayout(ty.getEncoding()));
+    loadsBufferType[loadOp] =
+        RankedTensorType::get(ty.getShape(), ty.getElementType(), sharedEnc);
+  }
 }
 
 void LoopPipeliner::createOrderedDeps() {
@@ -460,6 +593,21 @@ LogicalResult LoopPipeliner::initialize() {
   if (checkOpDeps().failed())
     return failure();
 
+  // With more than two stages, the prologue computes the loop carried values
+  // the loads depend on for each of its stages, so they must be computed by
+  // the dependencies. Values forwarded from one iteration to the next are not
+  // supported there. Two stages only need the values of the first iteration.
+  if (numStages > 2) {
+    for (BlockArgument arg : depArgs) {
+      Value yielded = yieldOp->getOperand(arg.getArgNumber() - 1);
+      if (forOp.isDefinedOutsideOfLoop(yielded))
+        continue;
+      Operation *def = yielded.getDefiningOp();
+      if (!def || !depOps.contains(def))
+        return failure();
+    }
+  }
+
   createBufferTypes();
 
   createOrderedDeps();
@@ -469,6 +617,14 @@ LogicalResult LoopPipeliner::initialize() {
   return success();
 }
 
+unsigned LoopPipeliner::getNumPipelinedRegs() const {
+  unsigned numRegs = 0;
+  for (Operation *loadOp : validLoads)
+    numRegs += (numStages - 1) * RegisterPressureAnalysis::getNumRegs(
+                                     loadOp->getResult(0).getType());
+  return numRegs;
+}
+
 Value LoopPipeliner::getLoadMask(triton::LoadOp loadOp, Value mappedMask,
                                  Value loopCond, OpBuilder &builder) {
   if (!peelLastIter) {
@@ -524,30 +680,84 @@ void LoopPipeliner::emitPrologue() {
 
   // Emit prologue
   // Map IV to lower bound
-  prologueMap.map(forOp.getInductionVar(), forOp.getLowerBound());
+  Value iv = forOp.getLowerBound();
+  if (numStages > 2)
+    ringIdxInit = builder.create<arith::ConstantIntOp>(iv.getLoc(), 0, 32);
+
+  // Emit Iteration 0 to numStages - 2 loads, etc
+  for (int stage = 0; stage < numStages - 1; ++stage) {
+    // The loop may run fewer than numStages - 1 iterations
+    Value loopCond;
+    if (stage != 0) {
+      iv = builder.create<arith::AddIOp>(iv.getLoc(), iv, forOp.getStep());
+      loopCond = builder.create<arith::CmpIOp>(
+          iv.getLoc(), arith::CmpIPredicate::slt, iv, forOp.getUpperBound());
+      for (BlockArgument arg : depArgs)
+        prologueMap.map(arg, valueMapping[arg][stage]);
+    }
+    prologueMap.map(forOp.getInductionVar(), iv);
+
+    for (Operation *op : orderedDeps) {
+      Value newMask;
+      if (auto loadOp = dyn_cast<triton::LoadOp>(op))
+        if (loopCond)
+          newMask = getLoadMask(
+              loadOp, prologueMap.lookupOrDefault(loadOp.getMask()), loopCond,
+              builder);
+      Operation *newOp = cloneWithInferType(builder, op, prologueMap);
+      if (newMask)
+        updateLoadMask(cast<triton::LoadOp>(newOp), newMask);
+      if (!validLoads.contains(op)) {
+        // Capture loop carried results for pipelined for input
+        if (numStages == 2)
+          for (unsigned idx : llvm::seq(unsigned(0), op->getNumResults()))
+            setValueMappingYield(op->getResult(idx), newOp->getResult(idx), 1);
+        continue;
+      }
 
-  // Emit Iteration 0 loads, etc
-  for (Operation *op : orderedDeps) {
-    Operation *newOp = nullptr;
-    if (validLoads.contains(op)) {
       auto loadOp = cast<triton::LoadOp>(op);
       // Load from global -> regs
-      auto newLoadOp = cloneWithInferType(builder, op, prologueMap);
-      Value loadVal = newLoadOp->getResult(0);
+      Value loadVal = newOp->getResult(0);
+      if (stage != 0) {
+        // Keep later tiles in regs
+        loadsPrefetched[loadOp].push_back(loadVal);
+        continue;
+      }
       // Convert from regs to shared mem
-      newOp = builder.create<ttg::ConvertLayoutOp>(loadOp.getLoc(),
-                                                   loadsBufferType[loadOp],
-                                                   loadVal);
-      Value cvtVal = newOp->getResult(0);
-      prologueMap.map(loadOp->getResult(0), cvtVal);
-      loadsBuffer[loadOp] = cvtVal;
-    } else {
-      newOp = cloneWithInferType(builder, op, prologueMap);
+      Value bufferVal;
+      if (regLoads.contains(op)) {
+        bufferVal = loadVal;
+      } else if (numStages > 2) {
+        auto bufferTy = loadsBufferType[loadOp];
+        SmallVector<int64_t> ringShape(bufferTy.getShape());
+        ringShape.insert(ringShape.begin(), numRingBuffers);
+        Value ring = builder.create<ttg::AllocTensorOp>(
+            loadOp.getLoc(),
+            RankedTensorType::get(ringShape, bufferTy.getElementType(),
+                                  bufferTy.getEncoding()));
+        bufferVal = insertIntoRing(builder, loadOp, ring, loadVal,
+                                   builder.getI64IntegerAttr(0));
+      } else {
+        bufferVal = builder.create<ttg::ConvertLayoutOp>(
+            loadOp.getLoc(), loadsBufferType[loadOp], loadVal);
+      }
+      prologueMap.map(loadOp->getResult(0), bufferVal);
+      loadsBuffer[loadOp] = bufferVal;
+      if (numStages == 2)
+        setValueMappingYield(loadOp->getResult(0), bufferVal, 1);
+    } // for (Operation *op : orderedDeps)
+
+    // Capture loop carried values for the next stage. With two stages the
+    // ones yielded by the dependencies were captured above, and the others
+    // (iter_args forwarded from the previous iteration, loop invariants) take
+    // their value in the first iteration.
+    for (BlockArgument arg : depArgs) {
+      if (numStages == 2 && lookupOrDefault(arg, 1) != arg)
+        continue;
+      Value yielded = yieldOp->getOperand(arg.getArgNumber() - 1);
+      setValueMapping(arg, prologueMap.lookupOrDefault(yielded), stage + 1);
     }
-    // Capture loop carried results for pipelined for input
-    for (unsigned idx : llvm::seq(unsigned(0), op->getNumResults()))
-      setValueMappingYield(op->getResult(idx), newOp->getResult(idx), 1);
-  } // for (Operation *op : orderedDeps)
+  } // for (int stage = 0; stage < numStages - 1; ++stage)
 }
 
 void LoopPipeliner::emitEpilogue(DenseMap<Value, Value> &newResults) {
@@ -562,7 +772,9 @@ void LoopPipeliner::emitEpilogue(DenseMap<Value, Value> &newResults) {
   for (uint32_t i = 0; i < args.size(); ++i)
     epilogueMap.map(args[i], pplForOp.getResult(i));
   for (auto load : llvm::enumerate(validLoads))
-    epilogueMap.map(load.value()->getResult(0), pplForOp.getResult(bufferIdx + load.index()));
+    epilogueMap.map(load.value()->getResult(0),
+                    getCurrentTile(builder, load.value(),
+                                   pplForOp.getResult(bufferIdx + load.index())));
   // Map IV to original upper bound (ie. last iteration)
   epilogueMap.map(forOp.getInductionVar(), forOp.getUpperBound());
 
@@ -593,6 +805,8 @@ SmallVector<Value> LoopPipeliner::collectNewLoopArgs() {
   // Order of new args:
   //   (original args)
   //   (shared mem buffers for each load)
+  //   (tiles in regs for each load, numStages > 2 only)
+  //   (ring buffer index, numStages > 2 only)
   //   (depArgs at stage numStages - 1)
 
   // We need this to update operands for yield
@@ -607,6 +821,17 @@ SmallVector<Value> LoopPipeliner::collectNewLoopArgs() {
   for (auto *loadOp : validLoads)
     newLoopArgs.push_back(loadsBuffer[loadOp->getResult(0)]);
 
+  // Tiles of iterations [1, numStages - 1) kept in regs
+  prefetchedIdx = newLoopArgs.size();
+  for (auto *loadOp : validLoads)
+    for (Value tile : loadsPrefetched[loadOp->getResult(0)])
+      newLoopArgs.push_back(tile);
+
+  // Ring buffer holding the tile of iteration 0
+  ringIdx = newLoopArgs.size();
+  if (numStages > 2)
+    newLoopArgs.push_back(ringIdxInit);
+
   // Loop carried vals
   depArgsBeginIdx = newLoopArgs.size();
   for (auto depArg : depArgs) {
@@ -636,8 +861,16 @@ scf::ForOp LoopPipeliner::cloneForOp(ArrayRef<Value> newLoopArgs,
   for (const auto &arg : llvm::enumerate(forOp.getRegionIterArgs()))
     curMapping.map(arg.value(), pplForOp.getRegionIterArgs()[arg.index()]);
   uint32_t bufIdx = bufferIdx;
-  for (auto *loadOp : validLoads)
-    curMapping.map(loadOp->getResult(0), pplForOp.getRegionIterArgs()[bufIdx++]);
+  if (numStages > 2)
+    curRingIdx = pplForOp.getRegionIterArgs()[ringIdx];
+  for (auto *loadOp : validLoads) {
+    Value buffer = pplForOp.getRegionIterArgs()[bufIdx++];
+    // Read the current tile from its slot of the ring
+    if (numStages > 2 && !regLoads.contains(loadOp))
+      buffer = extractFromRing(builder, loadOp, buffer, curRingIdx);
+    curMapping.map(loadOp->getResult(0),
+                   getCurrentTile(builder, loadOp, buffer));
+  }
   curMapping.map(forOp.getInductionVar(), pplForOp.getInductionVar());
 
   nextMapping = curMapping;
@@ -653,7 +886,14 @@ scf::ForOp LoopPipeliner::cloneForOp(ArrayRef<Value> newLoopArgs,
   // Compute next IV for pre-loads
   Value iv = pplForOp.getInductionVar();
   curMapping.map(forOp.getInductionVar(), iv);
-  Value nextIV = builder.create<arith::AddIOp>(iv.getLoc(), iv, pplForOp.getStep());
+  Value prefetchStep = pplForOp.getStep();
+  if (numStages > 2)
+    prefetchStep = builder.create<arith::MulIOp>(
+        iv.getLoc(), prefetchStep,
+        builder.create<arith::ConstantOp>(
+            iv.getLoc(),
+            builder.getIntegerAttr(prefetchStep.getType(), numStages - 1)));
+  Value nextIV = builder.create<arith::AddIOp>(iv.getLoc(), iv, prefetchStep);
   nextMapping.map(forOp.getInductionVar(), nextIV);
   nextLoopCond =
       builder.create<arith::CmpIOp>(nextIV.getLoc(), arith::CmpIPredicate::slt,
@@ -673,6 +913,54 @@ void LoopPipeliner::updateLoadMask(triton::LoadOp loadOp, Value newMask) {
   }
 }
 
+ArrayRef<BlockArgument> LoopPipeliner::getPrefetchedArgs(Operation *loadOp) {
+  size_t numPrefetched = numStages - 2;
+  size_t loadIdx =
+      std::distance(validLoads.begin(), llvm::find(validLoads, loadOp));
+  return pplForOp.getRegionIterArgs().slice(
+      prefetchedIdx + loadIdx * numPrefetched, numPrefetched);
+}
+
+Value LoopPipeliner::insertIntoRing(OpBuilder &builder, Operation *loadOp,
+                                    Value ring, Value tile, OpFoldResult idx) {
+  auto ringShape = ring.getType().cast<RankedTensorType>().getShape();
+  SmallVector<OpFoldResult> offsets(ringShape.size(),
+                                    builder.getI64IntegerAttr(0));
+  SmallVector<OpFoldResult> sizes(ringShape.size(),
+                                  builder.getI64IntegerAttr(1));
+  SmallVector<OpFoldResult> strides(ringShape.size(),
+                                    builder.getI64IntegerAttr(1));
+  offsets[0] = idx;
+  for (size_t d = 1; d < ringShape.size(); ++d)
+    sizes[d] = builder.getI64IntegerAttr(ringShape[d]);
+  return builder.create<tensor::InsertSliceOp>(loadOp->getLoc(), tile, ring,
+                                               offsets, sizes, strides);
+}
+
+Value LoopPipeliner::extractFromRing(OpBuilder &builder, Operation *loadOp,
+                                     Value ring, Value idx) {
+  auto sliceType = loadsBufferType[loadOp->getResult(0)];
+  size_t rank = sliceType.getRank() + 1;
+  SmallVector<OpFoldResult> offsets(rank, builder.getI64IntegerAttr(0));
+  SmallVector<OpFoldResult> sizes(rank, builder.getI64IntegerAttr(1));
+  SmallVector<OpFoldResult> strides(rank, builder.getI64IntegerAttr(1));
+  offsets[0] = idx;
+  for (size_t d = 1; d < rank; ++d)
+    sizes[d] = builder.getI64IntegerAttr(sliceType.getShape()[d - 1]);
+  return builder.create<ttg::ExtractSliceOp>(loadOp->getLoc(), sliceType, ring,
+                                             offsets, sizes, strides);
+}
+
+Value LoopPipeliner::getCurrentTile(OpBuilder &builder, Operation *loadOp,
+                                    Value buffer) {
+  // Dot operands are read from shared mem by their layout conversions
+  Value loadVal = loadOp->getResult(0);
+  if (convertMapping.contains(loadVal) || regLoads.contains(loadOp))
+    return buffer;
+  return builder.create<ttg::ConvertLayoutOp>(loadOp->getLoc(),
+                                              loadVal.getType(), buffer);
+}
+
 void LoopPipeliner::prefetchNextBuffer(OpBuilder &builder) {
   // Emit prefetch loads of next buffer before compute of current buffer
   for (Operation *op : orderedDeps) {
@@ -746,14 +1034,47 @@ void LoopPipeliner::storeNextBuffer(OpBuilder &builder) {
     }
   }
   
+  // The tile of the next iteration goes to the other slot of the ring
+  if (numStages > 2) {
+    Location loc = forOp.getLoc();
+    Value one = builder.create<arith::ConstantIntOp>(loc, 1, 32);
+    Value zero = builder.create<arith::ConstantIntOp>(loc, 0, 32);
+    Value numBuffers =
+        builder.create<arith::ConstantIntOp>(loc, numRingBuffers, 32);
+    nextRingIdx = builder.create<arith::AddIOp>(loc, curRingIdx, one);
+    Value wrap = builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::sge,
+                                               nextRingIdx, numBuffers);
+    nextRingIdx = builder.create<arith::SelectOp>(loc, wrap, zero, nextRingIdx);
+  }
+
   // PL loads -> store next to shared
   for (auto *loadOp : validLoads) {
     Value loadVal = nextMapping.lookup(loadOp->getResult(0));
     // then store regs -> shared
     Value storeBuf = pplForOp.getRegionIterArgs()[bufferIdx + nextBuffers.size()];
-    auto cvt = builder.create<ttg::ConvertLayoutOp>(
-          loadOp->getLoc(), storeBuf.getType(), loadVal);
-    nextBuffers.push_back(cvt);
+    if (numStages == 2 && regLoads.contains(loadOp)) {
+      nextBuffers.push_back(loadVal);
+      continue;
+    }
+    if (numStages == 2) {
+      auto cvt = builder.create<ttg::ConvertLayoutOp>(
+            loadOp->getLoc(), storeBuf.getType(), loadVal);
+      nextBuffers.push_back(cvt);
+      continue;
+    }
+    // Store the oldest tile in regs and queue the one just loaded
+    ArrayRef<BlockArgument> prefetched = getPrefetchedArgs(loadOp);
+    if (regLoads.contains(loadOp)) {
+      nextBuffers.push_back(prefetched.front());
+    } else {
+      Value idx = builder.create<arith::IndexCastOp>(
+          loadOp->getLoc(), builder.getIndexType(), nextRingIdx);
+      nextBuffers.push_back(
+          insertIntoRing(builder, loadOp, storeBuf, prefetched.front(), idx));
+    }
+    for (BlockArgument tile : prefetched.drop_front())
+      nextPrefetched.push_back(tile);
+    nextPrefetched.push_back(loadVal);
   }
 
   // Some values have not been used by any ops in the loop body
@@ -773,6 +1094,10 @@ void LoopPipeliner::finalizeYield(OpBuilder &builder) {
   }
   for (Value nextBuffer : nextBuffers)
     yieldValues.push_back(nextBuffer);
+  for (Value tile : nextPrefetched)
+    yieldValues.push_back(tile);
+  if (numStages > 2)
+    yieldValues.push_back(nextRingIdx);
 
   for (size_t i = 0; i < depArgsMapping.size(); ++i) {
     auto arg = pplForOp.getRegionIterArgs()[depArgsBeginIdx + i];
@@ -798,6 +1123,11 @@ scf::ForOp LoopPipeliner::createNewForOp() {
 // Stream Pipeline
 struct PipelinePass : public TritonGPUStreamPipelineBase<PipelinePass> {
   PipelinePass() = default;
+  PipelinePass(int numStages, int wavesPerEU, int matrixCoreVersion) {
+    this->numStages = numStages;
+    this->wavesPerEU = wavesPerEU;
+    this->matrixCoreVersion = matrixCoreVersion;
+  }
 
   void runOnOperation() override {
     // Pre-processing
@@ -810,12 +1140,25 @@ struct PipelinePass : public TritonGPUStreamPipelineBase<PipelinePass> {
     // auto didPreprocess =
     //     applyPatternsAndFoldGreedily(getOperation(), std::move(patterns));
 
+    RegisterPressureAnalysis regPressure(getOperation());
+    unsigned budget = RegisterPressureAnalysis::getRegisterBudget(
+        wavesPerEU, matrixCoreVersion);
+
     // Do the pipelining
     getOperation()->walk([&](scf::ForOp forOp) -> void {
-      LoopPipeliner pipeliner(forOp);
-
-      if (pipeliner.initialize().failed())
-        return;
+      unsigned loopRegs = regPressure.getPressure(forOp);
+      unsigned numFreeRegs = budget > loopRegs ? budget - loopRegs : 0;
+
+      // Use the deepest pipeline whose tiles in flight fit in the budget
+      std::optional<LoopPipeliner> optPipeliner;
+      for (int stages = numStages; stages >= 2; --stages) {
+        optPipeliner.emplace(forOp, stages, numFreeRegs);
+        if (optPipeliner->initialize().failed())
+          return;
+        if (optPipeliner->getNumPipelinedRegs() <= numFreeRegs)
+          break;
+      }
+      LoopPipeliner &pipeliner = *optPipeliner;
 
       pipeliner.emitPrologue();
       scf::ForOp pplForOp = pipeliner.createNewForOp();
@@ -833,6 +1176,9 @@ struct PipelinePass : public TritonGPUStreamPipelineBase<PipelinePass> {
 };
 } // anonymous namespace
 
-std::unique_ptr<Pass> mlir::createTritonGPUStreamPipelinePass() {
-  return std::make_unique<PipelinePass>();
+std::unique_ptr<Pass>
+mlir::createTritonGPUStreamPipelinePass(int numStages, int wavesPerEU,
+                                        int matrixCoreVersion) {
+  return std::make_unique<PipelinePass>(numStages, wavesPerEU,
+                                        matrixCoreVersion);
 }
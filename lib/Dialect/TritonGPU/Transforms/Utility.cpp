@@ -346,6 +346,98 @@ bool canFoldIntoConversion(Operation *op, Attribute targetEncoding) {
              triton::MakeRangeOp, triton::SplatOp, triton::ViewOp>(op);
 }
 
+int64_t ConvertLayoutCost::total() const {
+  // A barrier stalls the whole CTA, which costs about as much as moving a
+  // few dwords per thread through shared memory.
+  constexpr int64_t barrierCost = 64;
+  return sharedBytes + barrierCost * numBarriers + 4 * numShuffles +
+         4 * regDuplication;
+}
+
+// Pointers are held in 64-bit registers, as in the shared memory allocation.
+static unsigned getElementBitWidth(RankedTensorType type) {
+  if (type.getElementType().isa<triton::PointerType>())
+    return 64;
+  return type.getElementTypeBitWidth();
+}
+
+int64_t getNumRegsPerThread(RankedTensorType type) {
+  int64_t bits =
+      triton::gpu::getTotalElemsPerThread(type) * getElementBitWidth(type);
+  return ceil<int64_t>(bits, 32);
+}
+
+ConvertLayoutCost getConvertLayoutCost(RankedTensorType srcTy,
+                                       Attribute dstEncoding) {
+  ConvertLayoutCost cost;
+  Attribute srcEncoding = srcTy.getEncoding();
+  if (srcEncoding == dstEncoding)
+    return cost;
+  auto dstTy = RankedTensorType::get(srcTy.getShape(), srcTy.getElementType(),
+                                     dstEncoding);
+  bool srcShared = srcEncoding.isa<triton::gpu::SharedEncodingAttr>();
+  bool dstShared = dstEncoding.isa<triton::gpu::SharedEncodingAttr>();
+  if (srcShared && dstShared)
+    return cost;
+  int64_t elemBytes = ceil<int64_t>(getElementBitWidth(srcTy), 8);
+  // Loads from or stores to shared memory, with the barrier separating them
+  // from the accesses of the other side.
+  if (srcShared || dstShared) {
+    auto distTy = srcShared ? dstTy : srcTy;
+    cost.sharedBytes =
+        triton::gpu::getTotalElemsPerThread(distTy) * elemBytes;
+    cost.numBarriers = 1;
+    return cost;
+  }
+  int64_t srcRegs = getNumRegsPerThread(srcTy);
+  int64_t dstRegs = getNumRegsPerThread(dstTy);
+  cost.regDuplication = std::max<int64_t>(dstRegs - srcRegs, 0);
+  // Conversions that only rename or permute registers.
+  if (isMmaToDotShortcut(srcTy, dstTy))
+    return cost;
+#ifdef USE_ROCM
+  // Chunks of 4 elements that change lanes take one ds_bpermute per dword
+  if (auto shortcut = getMfmaToDotShortcut(srcTy, dstTy)) {
+    int64_t chunkDwords =
+        ceil<int64_t>(4 * getElementBitWidth(srcTy), 32);
+    cost.numShuffles = shortcut->getNumPermutedChunks() * chunkDwords;
+    return cost;
+  }
+#endif
+  if (isMmaToMmaShortcut(srcTy, dstTy)) {
+    cost.numShuffles = srcRegs;
+    return cost;
+  }
+  // Generic conversions store the source and load the destination through
+  // shared memory, with barriers before and after the stores.
+  cost.sharedBytes = (triton::gpu::getTotalElemsPerThread(srcTy) +
+                      triton::gpu::getTotalElemsPerThread(dstTy)) *
+                     elemBytes;
+  cost.numBarriers = 2;
+  return cost;
+}
+
+int64_t getRematerializationCost(Operation *op, Attribute encoding) {
+  // Folded into the conversion that replaces the rematerialized value
+  if (canFoldIntoConversion(op, encoding))
+    return 0;
+  // Only move registers around
+  if (isa<triton::ExpandDimsOp, triton::BroadcastOp>(op))
+    return 0;
+  int64_t cost = 0;
+  for (Value result : op->getResults()) {
+    auto tensorType = result.getType().dyn_cast<RankedTensorType>();
+    if (!tensorType)
+      continue;
+    auto newType = RankedTensorType::get(
+        tensorType.getShape(), tensorType.getElementType(), encoding);
+    // One instruction per register, and loads are issued again
+    int64_t numRegs = getNumRegsPerThread(newType);
+    cost += isa<triton::LoadOp>(op) ? 2 * 4 * numRegs : numRegs;
+  }
+  return cost;
+}
+
 //
 
 Operation *cloneWithInferType(mlir::OpBuilder &rewriter, Operation *op,
@@ -344,7 +344,9 @@ std::unique_ptr<llvm::Module>
 translateTritonGPUToLLVMIR(llvm::LLVMContext *llvmContext,
                            mlir::ModuleOp module, int computeCapability,
                            mlir::triton::gpu::TMAMetadataTy &tmaInfos,
-                           Target target, int wavesPerEU) {
+                           Target target, int wavesPerEU,
+                           int matrixCoreVersion,
+                           const std::string &schedVariant) {
   mlir::PassManager pm(module->getContext());
   mlir::registerPassManagerCLOptions();
   if (failed(applyPassManagerCLOptions(pm))) {
@@ -367,7 +369,8 @@ translateTritonGPUToLLVMIR(llvm::LLVMContext *llvmContext,
   pm.addPass(mlir::createConvertSCFToCFPass());
   pm.addPass(mlir::createConvertIndexToLLVMPass());
   pm.addPass(
-      createConvertTritonGPUToLLVMPass({computeCapability, &tmaInfos, target}));
+      createConvertTritonGPUToLLVMPass({computeCapability, &tmaInfos, target,
+                                        matrixCoreVersion, schedVariant}));
 #ifndef USE_ROCM
   pm.addPass(createConvertNVGPUToLLVMPass());
 #endif
@@ -1789,6 +1789,27 @@ void init_triton_ir(py::module &&m) {
            [](mlir::PassManager &self) {
              self.addPass(mlir::triton::createReorderBroadcastPass());
            })
+      .def("add_triton_hoist_invariant_loads_pass",
+           [](mlir::PassManager &self) {
+             self.addPass(mlir::triton::createHoistInvariantLoadsPass());
+           })
+      .def("add_triton_strength_reduce_divrem_pass",
+           [](mlir::PassManager &self) {
+             self.addPass(mlir::triton::createStrengthReduceDivRemPass());
+           })
+      .def("add_triton_narrow_indices_pass",
+           [](mlir::PassManager &self) {
+             self.addPass(mlir::triton::createNarrowIndicesPass());
+           })
+      .def("add_triton_version_masked_accesses_pass",
+           [](mlir::PassManager &self, int maxVersionedOps) {
+             self.addPass(mlir::triton::createVersionMaskedAccessesPass(
+                 maxVersionedOps));
+           })
+      .def("add_triton_specialize_calls_pass",
+           [](mlir::PassManager &self, int maxClones) {
+             self.addPass(mlir::triton::createSpecializeCallsPass(maxClones));
+           })
       .def("add_rewrite_tensor_pointer_pass",
            [](mlir::PassManager &self, int computeCapability, bool isROCM) {
              self.addPass(mlir::triton::createRewriteTensorPointerPass(
@@ -1844,13 +1865,30 @@ void init_triton_ir(py::module &&m) {
              self.addPass(mlir::createTritonNvidiaGPUMaterializeLoadStorePass(
                  numWarps, computeCapability));
            })
-      .def("add_tritongpu_stream_pipeline_pass",
-           [](mlir::PassManager &self) {
-             self.addPass(mlir::createTritonGPUStreamPipelinePass());
+      .def(
+          "add_tritongpu_stream_pipeline_pass",
+          [](mlir::PassManager &self, int numStages, int wavesPerEU,
+             int matrixCoreVersion) {
+            self.addPass(mlir::createTritonGPUStreamPipelinePass(
+                numStages, wavesPerEU, matrixCoreVersion));
+          },
+          py::arg("numStages"), py::arg("wavesPerEU"),
+          py::arg("matrixCoreVersion") = 0)
+      .def("add_tritongpu_persistent_tiles_pass",
+           [](mlir::PassManager &self, int numPrograms) {
+             self.addPass(
+                 mlir::createTritonGPUPersistentTilesPass(numPrograms));
            })
-      .def("add_tritongpu_prefetch_pass",
+      .def(
+          "add_tritongpu_prefetch_pass",
+          [](mlir::PassManager &self, int wavesPerEU, int matrixCoreVersion) {
+            self.addPass(mlir::createTritonGPUPrefetchPass(wavesPerEU,
+                                                           matrixCoreVersion));
+          },
+          py::arg("wavesPerEU") = -1, py::arg("matrixCoreVersion") = 0)
+      .def("add_tritongpu_annotate_register_pressure_pass",
            [](mlir::PassManager &self) {
-             self.addPass(mlir::createTritonGPUPrefetchPass());
+             self.addPass(mlir::createTritonGPUAnnotateRegisterPressurePass());
            })
       .def("add_tritongpu_accelerate_matmul_pass",
            [](mlir::PassManager &self, int computeCapability) {
@@ -1858,9 +1896,10 @@ void init_triton_ir(py::module &&m) {
                  mlir::createTritonGPUAccelerateMatmulPass(computeCapability));
            })
       .def("add_tritonamdgpu_accelerate_matmul_pass",
-           [](mlir::PassManager &self, int tensorCoreVersion, int instrSize) {
+           [](mlir::PassManager &self, int tensorCoreVersion, int instrSize,
+              int wavesPerEU, int kPack) {
              self.addPass(mlir::createTritonAMDGPUAccelerateMatmulPass(
-                 tensorCoreVersion, instrSize));
+                 tensorCoreVersion, instrSize, wavesPerEU, kPack));
            })
       .def("add_tritongpu_optimize_dot_operands_pass",
            [](mlir::PassManager &self) {
@@ -1907,6 +1946,10 @@ void init_triton_ir(py::module &&m) {
     return mlir::triton::nvidia_gpu::TritonNvidiaGPUDialect::getWSSupportedAttr(
         mod);
   });
+
+  m.def("is_persistent_tiles", [](mlir::ModuleOp &mod) -> bool {
+    return mlir::triton::gpu::TritonGPUDialect::isPersistentTiles(mod);
+  });
 }
 
 void init_triton_env_vars(py::module &m) {
@@ -1987,11 +2030,13 @@ void init_triton_translation(py::module &m) {
       "translate_triton_gpu_to_llvmir",
       [](mlir::ModuleOp op, int computeCapability,
          mlir::triton::gpu::TMAMetadataTy &tmaInfos,
-         mlir::triton::Target target, int wavesPerEU) {
+         mlir::triton::Target target, int wavesPerEU, int matrixCoreVersion,
+         const std::string &schedVariant) {
         py::gil_scoped_release allow_threads;
         llvm::LLVMContext llvmContext;
         auto llvmModule = ::mlir::triton::translateTritonGPUToLLVMIR(
-            &llvmContext, op, computeCapability, tmaInfos, target, wavesPerEU);
+            &llvmContext, op, computeCapability, tmaInfos, target, wavesPerEU,
+            matrixCoreVersion, schedVariant);
         if (!llvmModule)
           llvm::report_fatal_error("Failed to translate TritonGPU to LLVM IR.");
 
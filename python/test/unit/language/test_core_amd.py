@@ -1894,6 +1894,9 @@ def test_dot(M, N, K, num_warps, col_a, col_b, epilogue, allow_tf32, in_dtype, o
             assert "v_mfma_f32_32x32x16_bf8_bf8" in gcn or "v_mfma_f32_16x16x32_bf8_bf8" in gcn
         if triton.language.semantic.gpu_matrix_core_version() == 3 and effective_in_dtype == tl.float8e4b8:
             assert "v_mfma_f32_32x32x16_fp8_fp8" in gcn or "v_mfma_f32_16x16x32_fp8_fp8" in gcn
+        # fp32 dots allowing tf32 precision use the xf32 instructions of CDNA3
+        if triton.language.semantic.gpu_matrix_core_version() == 3 and in_dtype == 'float32' and "v_mfma" in gcn:
+            assert ("_xf32" in gcn) == allow_tf32
         return
     # make sure ld/st are vectorized
     ptx = pgm.asm['ptx']
@@ -197,6 +197,19 @@ def test_jit_noinline() -> None:
     assert inline_ttir != noinline_ttir
 
 
+def test_jit_noalias() -> None:
+    @triton.jit(noalias=["a", "b"])
+    def kernel_add_noalias(a, b, o, N: tl.constexpr):
+        idx = tl.arange(0, N)
+        tl.store(o + idx, tl.load(a + idx) + tl.load(b + idx))
+
+    device = torch.cuda.current_device()
+    kernel_add_noalias.warmup(torch.float32, torch.float32, torch.float32, 32, grid=(1,))
+    bins = list(kernel_add_noalias.cache[device].values())
+    ttir = bins[0].asm['ttir']
+    assert ttir.count("tt.noalias") == 2
+
+
 def test_memory_leak() -> None:
     @triton.jit
     def kernel(in_ptr0, out_ptr0, xnumel, XBLOCK: tl.constexpr):
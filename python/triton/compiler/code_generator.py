@@ -1127,6 +1127,10 @@ def ast_to_ttir(fn, signature, specialization, constants, debug, arch):
         attr = new_attrs[k] if k in new_attrs else []
         attr.append(("tt.max_divisibility", 8))
         new_attrs[k] = attr
+    for k in getattr(specialization, "pointer_range_32", ()):
+        new_attrs.setdefault(k, []).append(("tt.pointer_range", 32))
+    for k in getattr(fn, "noalias", ()):
+        new_attrs.setdefault(k, []).append(("tt.noalias", 1))
 
     all_constants = constants.copy()
     all_constants.update(new_constants)
@@ -67,7 +67,15 @@ def optimize_ttir(mod, arch):
     pm.add_reorder_broadcast_pass()
     pm.add_cse_pass()
     pm.add_licm_pass()
+    pm.add_triton_hoist_invariant_loads_pass()
+    pm.add_triton_strength_reduce_divrem_pass()
+    pm.add_triton_narrow_indices_pass()
+    # Opt-in: duplicating kernel bodies trades code size for mask-free accesses
+    if is_hip() and os.environ.get("AMDGCN_VERSION_MASKED_ACCESSES", "0") == "1":
+        pm.add_triton_version_masked_accesses_pass(256)
+    pm.add_canonicalizer_pass()
     pm.add_symbol_dce_pass()
+    pm.add_triton_specialize_calls_pass(4)
     pm.run(mod)
     return mod
 
@@ -84,7 +92,8 @@ def ttir_to_ttgir(mod, num_warps, warpsize, num_ctas, arch):
 
 
 def optimize_ttgir(mod, num_stages, num_warps, num_ctas, arch,
-                   cluster_info, enable_warp_specialization, enable_persistent, optimize_epilogue, matrix_inst_type):
+                   cluster_info, enable_warp_specialization, enable_persistent, optimize_epilogue, matrix_inst_type,
+                   num_persistent_programs=0, waves_per_eu=0, kpack=1):
     pm = ir.pass_manager(mod.context)
     pm.enable_debug()
     pm.add_tritongpu_coalesce_pass()
@@ -100,13 +109,19 @@ def optimize_ttgir(mod, num_stages, num_warps, num_ctas, arch,
     if is_hip():
         matrix_core_version = gpu_matrix_core_version()
         matrix_inst_size = matrix_inst_type
-        pm.add_tritonamdgpu_accelerate_matmul_pass(matrix_core_version, matrix_inst_size)
+        pm.add_tritonamdgpu_accelerate_matmul_pass(matrix_core_version, matrix_inst_size, waves_per_eu, kpack)
     pm.add_tritongpu_remove_layout_conversions_pass()
     if optimize_epilogue:
         pm.add_tritongpu_optimize_epilogue_pass()
     pm.add_tritongpu_optimize_dot_operands_pass()
-    if num_stages == 0 and is_hip() and gpu_matrix_core_version() != 0:
-        pm.add_tritongpu_stream_pipeline_pass()
+    # num_stages == 0 selects the default two stage stream pipeline.
+    # Direct global to LDS copies (CDNA 2 and 3) are lowered from the
+    # insert_slice_async that only the async copy pipeliner emits, so opting
+    # into them routes multi-stage loops through it instead.
+    direct_to_lds = is_hip() and gpu_matrix_core_version() in (2, 3) and os.environ.get("AMDGCN_ENABLE_DIRECT_TO_LDS", "0") == "1"
+    stream_pipeline = is_hip() and gpu_matrix_core_version() != 0 and (num_stages == 0 or num_stages > 2) and not (direct_to_lds and num_stages > 2)
+    if stream_pipeline:
+        pm.add_tritongpu_stream_pipeline_pass(max(num_stages, 2), waves_per_eu, gpu_matrix_core_version())
         pm.add_canonicalizer_pass()
     ws_enabled = False
     # `num_warps` does not mean the total number of warps of a CTA when
@@ -127,30 +142,36 @@ def optimize_ttgir(mod, num_stages, num_warps, num_ctas, arch,
         pm.add_tritongpu_wsmutex_pass(arch)
         pm.add_tritongpu_wsmaterialization_pass(arch)
         pm.add_cse_pass()
-    else:
+    elif not stream_pipeline:
         if is_hip():
             pm.add_tritongpu_pipeline_pass(
                 num_stages, num_warps, num_ctas, 0)
         else:
             pm.add_tritongpu_pipeline_pass(
                 num_stages, num_warps, num_ctas, arch)
+    if num_persistent_programs > 0:
+        pm.add_tritongpu_persistent_tiles_pass(num_persistent_programs)
     if is_hip():
         pm.add_tritongpu_materialize_load_store_pass(num_warps, 0)
     else:
         pm.add_tritongpu_materialize_load_store_pass(num_warps, arch)
     if _is_cuda(arch) and arch // 10 <= 8:
         pm.add_tritongpu_prefetch_pass()
+    elif is_hip() and os.environ.get("AMDGCN_ENABLE_PREFETCH", "0") == "1":
+        pm.add_tritongpu_prefetch_pass(waves_per_eu, gpu_matrix_core_version())
     pm.add_tritongpu_optimize_dot_operands_pass()
     pm.add_tritongpu_remove_layout_conversions_pass()
     pm.add_tritongpu_decompose_conversions_pass()
     pm.add_tritongpu_ws_fixup_missing_attrs_pass()
-    if num_stages != 0:
+    if num_stages != 0 and not stream_pipeline:
         pm.add_tritongpu_reorder_instructions_pass()
     pm.add_cse_pass()
     pm.add_symbol_dce_pass()
     if _is_cuda(arch) and arch // 10 >= 9:
         pm.add_tritongpu_fence_insertion_pass()
     pm.add_tritongpu_ws_fixup_missing_attrs_pass()
+    if is_hip():
+        pm.add_tritongpu_annotate_register_pressure_pass()
     pm.run(mod)
     return mod
 
@@ -162,14 +183,15 @@ def _add_external_libs(mod, libs):
     add_external_libs(mod, list(libs.keys()), list(libs.values()))
 
 
-def ttgir_to_llir(mod, extern_libs, arch, tma_infos, waves_per_eu=0):
+def ttgir_to_llir(mod, extern_libs, arch, tma_infos, waves_per_eu=0, instruction_sched_variant="none"):
     if extern_libs:
         _add_external_libs(mod, extern_libs)
     # TODO: separate tritongpu_to_llvmir for different backends
     if _is_cuda(arch):
-        return translate_triton_gpu_to_llvmir(mod, arch, tma_infos, runtime.TARGET.NVVM, waves_per_eu)
+        return translate_triton_gpu_to_llvmir(mod, arch, tma_infos, runtime.TARGET.NVVM, waves_per_eu, 0, "none")
     else:
-        return translate_triton_gpu_to_llvmir(mod, 0, TMAInfos(), runtime.TARGET.ROCDL, waves_per_eu)
+        return translate_triton_gpu_to_llvmir(mod, 0, TMAInfos(), runtime.TARGET.ROCDL, waves_per_eu,
+                                              gpu_matrix_core_version(), instruction_sched_variant)
 
 
 # PTX translation
@@ -246,14 +268,17 @@ def make_hash(fn, arch, env_vars, **kwargs):
         num_stages = kwargs.get("num_stages", 3)
         waves_per_eu = kwargs.get("waves_per_eu", 0)
         matrix_instr_nonkdim = kwargs.get("matrix_instr_nonkdim", 0);
+        kpack = kwargs.get("kpack", 1)
+        instruction_sched_variant = kwargs.get("instruction_sched_variant", "none")
+        num_persistent_programs = kwargs.get("num_persistent_programs", 0)
         enable_warp_specialization = kwargs.get("enable_warp_specialization", False)
         enable_persistent = kwargs.get("enable_persistent", False)
         debug = kwargs.get("debug", False)
         # Get unique key for the compiled code
-        get_conf_key = lambda conf: (sorted(conf.divisible_by_16), sorted(conf.equal_to_1), sorted(conf.ids_of_folded_args), sorted(conf.divisible_by_8))
+        get_conf_key = lambda conf: (sorted(conf.divisible_by_16), sorted(conf.equal_to_1), sorted(conf.ids_of_folded_args), sorted(conf.divisible_by_8), sorted(getattr(conf, "pointer_range_32", ())))
         configs_key = [get_conf_key(conf) for conf in configs]
         env_vars_list = [f"{env_vars[k]}" for k in sorted(env_vars.keys())]
-        key = f"{fn.cache_key}-{''.join(signature.values())}-{configs_key}-{constants}-{num_warps}-{num_stages}-{waves_per_eu}-{matrix_instr_nonkdim}-{num_ctas}-{num_stages}-{enable_warp_specialization}-{enable_persistent}-{debug}-{arch}-{env_vars_list}"
+        key = f"{fn.cache_key}-{''.join(signature.values())}-{configs_key}-{constants}-{num_warps}-{num_stages}-{waves_per_eu}-{matrix_instr_nonkdim}-{kpack}-{instruction_sched_variant}-{num_persistent_programs}-{num_ctas}-{num_stages}-{enable_warp_specialization}-{enable_persistent}-{debug}-{arch}-{env_vars_list}"
         return hashlib.md5(key.encode("utf-8")).hexdigest()
     assert isinstance(fn, str)
     return hashlib.md5((Path(fn).read_text() + version_key()).encode("utf-8")).hexdigest()
@@ -308,7 +333,7 @@ def parse_mlir_module(path, context):
     return module
 
 
-instance_descriptor = namedtuple("instance_descriptor", ["divisible_by_16", "equal_to_1", "ids_of_folded_args", "divisible_by_8"], defaults=[set(), set(), set(), set()])
+instance_descriptor = namedtuple("instance_descriptor", ["divisible_by_16", "equal_to_1", "ids_of_folded_args", "divisible_by_8", "pointer_range_32"], defaults=[set(), set(), set(), set(), set()])
 
 
 # TODO: architecture descriptor class
@@ -400,6 +425,9 @@ def compile(fn, **kwargs):
     num_stages = kwargs.get("num_stages", get_arch_default_num_stages(device_type, capability=capability))
     waves_per_eu = kwargs.get("waves_per_eu", 0)
     matrix_instr_nonkdim = kwargs.get("matrix_instr_nonkdim", 0)
+    kpack = kwargs.get("kpack", 1)
+    instruction_sched_variant = kwargs.get("instruction_sched_variant", "none")
+    num_persistent_programs = kwargs.get("num_persistent_programs", 0)
     # TODO[shuhaoj]: Default should be to enable warp specialization once possible
     enable_warp_specialization = kwargs.get("enable_warp_specialization", False)
     # TODO[shuhaoj]: persistent can be decoupled with warp specialization
@@ -447,6 +475,9 @@ def compile(fn, **kwargs):
         other["tma_infos"] = tma_infos
         other["waves_per_eu"] = waves_per_eu
         other["matrix_instr_nonkdim"] = matrix_instr_nonkdim
+        other["kpack"] = kpack
+        other["instruction_sched_variant"] = instruction_sched_variant
+        other["num_persistent_programs"] = num_persistent_programs
 
         _device_backend.add_stages(arch, extern_libs, stages, other)
     elif device_type == "xpu":
@@ -524,6 +555,9 @@ def compile(fn, **kwargs):
                     "num_stages": num_stages,
                     "waves_per_eu": waves_per_eu,
                     "matrix_instr_nonkdim": matrix_instr_nonkdim,
+                    "kpack": kpack,
+                    "instruction_sched_variant": instruction_sched_variant,
+                    "num_persistent_programs": num_persistent_programs,
                     "enable_warp_specialization": enable_warp_specialization,
                     "enable_persistent": enable_persistent,
                     "constants": _get_jsonable_constants(constants),
@@ -578,6 +612,7 @@ def compile(fn, **kwargs):
             else:
                 metadata["shared"] = get_shared_memory_size(module)
         if ir_name == "ttgir":
+            metadata["persistent_tiles"] = ir.is_persistent_tiles(next_module)
             metadata["enable_warp_specialization"] = ir.is_ws_supported(next_module)
             if metadata["enable_warp_specialization"]:
                 if is_hip():
@@ -613,11 +648,15 @@ def compile(fn, **kwargs):
 
     ids_of_const_exprs = tuple(fn.constexprs) if isinstance(fn, JITFunction) else ()
     ids = {"ids_of_tensormaps": ids_of_tensormaps, "ids_of_folded_args": ids_of_folded_args, "ids_of_const_exprs": ids_of_const_exprs}
+    # persistent kernels take the number of tiles after the user arguments
+    if metadata.get("persistent_tiles", False):
+        signature = dict(signature)
+        signature[max(list(signature.keys()) + list(constants.keys()), default=-1) + 1] = "i32"
     # cache manager
     if is_cuda:
         so_path = make_stub(name, signature, constants, ids, enable_warp_specialization=enable_warp_specialization)
     else:
-        so_path = _device_backend.make_launcher_stub(name, signature, constants, ids)
+        so_path = _device_backend.make_launcher_stub(name, signature, constants, ids, warp_size=warp_size)
     # write-back metadata, if it didn't come from the cache
     if metadata_path is None:
         metadata_group[metadata_filename] = fn_cache_manager.put(json.dumps(metadata, default=vars), metadata_filename, binary=False)
@@ -649,6 +688,8 @@ class CompiledKernel:
         self.num_ctas = metadata["num_ctas"]
         self.num_stages = metadata["num_stages"]
         self.waves_per_eu = metadata["waves_per_eu"]
+        self.num_persistent_programs = metadata.get("num_persistent_programs", 0)
+        self.persistent_tiles = metadata.get("persistent_tiles", False)
         self.clusterDims = metadata["clusterDims"]
         if "tensormaps_info" in metadata:
             self.tensormaps_info = metadata["tensormaps_info"]
@@ -699,6 +740,13 @@ class CompiledKernel:
         return super().__getattribute__(name)
 
     # capture args and expand args with cutensormap*
+    def assemble_persistent_tiles(self, grid_0, args):
+        # A persistent kernel runs at most num_persistent_programs programs
+        # along x, which loop over the grid_0 tiles it takes as last argument.
+        if not self.persistent_tiles:
+            return grid_0, args
+        return min(grid_0, self.num_persistent_programs), list(args) + [grid_0]
+
     def assemble_tensormap_to_arg(self, args):
         args_with_tma = list(args)
         if hasattr(self, 'tensormaps_info'):
@@ -712,13 +760,14 @@ class CompiledKernel:
         self._init_handles()
 
         def runner(*args, stream=None):
+            grid_0, args = self.assemble_persistent_tiles(grid[0], args)
             args_expand = self.assemble_tensormap_to_arg(args)
             if stream is None:
                 if self.device_type in ["cuda"]:
                     stream = get_cuda_stream()
                 else:
                     stream = get_backend(self.device_type).get_stream(None)
-            self.c_wrapper(grid[0], grid[1], grid[2], self.num_warps, self.num_ctas, self.clusterDims[0],
+            self.c_wrapper(grid_0, grid[1], grid[2], self.num_warps, self.num_ctas, self.clusterDims[0],
                            self.clusterDims[1], self.clusterDims[2], self.shared, stream, self.cu_function,
                            CompiledKernel.launch_enter_hook, CompiledKernel.launch_exit_hook, self, *args_expand)
         return runner
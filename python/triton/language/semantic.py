@@ -1264,6 +1264,7 @@ def gpu_matrix_core_version() -> int:
         1 corresponds to MFMA in CDNA 1 architecture
         2 corresponds to MFMA in CDNA 2 architecture
         3 corresponds to MFMA in CDNA 3 architecture
+        4 corresponds to WMMA in RDNA 3 architecture
     """
 
     if not is_hip():
@@ -1280,6 +1281,8 @@ def gpu_matrix_core_version() -> int:
         return 2
     if gpu_name in ['gfx940', 'gfx941', 'gfx942']:
         return 3
+    if gpu_name in ['gfx1100', 'gfx1101', 'gfx1102', 'gfx1103']:
+        return 4
     return 0
 
 def mfma_supported_granularity(m, n, k) -> bool:
@@ -1292,16 +1295,39 @@ def mfma_supported_granularity(m, n, k) -> bool:
         if k % granularity_k != 0:
             continue
         return True
+    # 4x4 instructions compute a 64x4 or 4x64 tile of the result
+    if k % 4 == 0 and ((m % 4 == 0 and n % 64 == 0) or (m % 64 == 0 and n % 4 == 0)):
+        return True
     return False
 
-def mfma_supported(M, N, K, allow_tf32, ret_scalar_ty) -> bool:
+def wmma_supported(M, N, K, in_scalar_ty) -> bool:
+    # WMMA only has 16x16x16 instructions, for fp16, bf16 and int8 operands
+    if M % 16 != 0 or N % 16 != 0 or K % 16 != 0:
+        return False
+    return in_scalar_ty in [tl.float16, tl.bfloat16, tl.int8]
+
+def mfma_supported(M, N, K, allow_tf32, ret_scalar_ty, in_scalar_ty) -> bool:
     matrix_core_version = gpu_matrix_core_version()
+    if matrix_core_version == 4:
+        return wmma_supported(M, N, K, in_scalar_ty)
     if matrix_core_version not in [1, 2, 3]:
         return False
     if not mfma_supported_granularity(M, N ,K):
         return False
     return True
 
+def packed_dot_supported(ret_scalar_ty, in_scalar_ty) -> bool:
+    # The FMA path multiplies fp16, bf16 and int8 operands with v_dot2 and v_dot4
+    # instructions, which need no upcast of the operands
+    matrix_core_version = gpu_matrix_core_version()
+    if matrix_core_version not in [1, 2, 3, 4]:
+        return False
+    if in_scalar_ty == tl.float16:
+        return ret_scalar_ty == tl.float32
+    if in_scalar_ty == tl.bfloat16:
+        return matrix_core_version == 4 and ret_scalar_ty == tl.float32
+    return in_scalar_ty == tl.int8 and ret_scalar_ty == tl.int32
+
 def dot(lhs: tl.tensor,
         rhs: tl.tensor,
         allow_tf32: bool,
@@ -1345,9 +1371,11 @@ def dot(lhs: tl.tensor,
     assert len(lhs.shape) == 2, f"First input shape ({lhs.shape}) is not two dimensional!"
     assert len(rhs.shape) == 2, f"Second input shape ({rhs.shape}) is not two dimensional!"
     assert lhs.shape[1].value == rhs.shape[0].value, f"First input shape ({lhs.shape}) and second input shape {rhs.shape} are not compatible for matmul (second index of first shape ({lhs.shape[1].value}) must be equal to first index of second shape ({rhs.shape[0].value})"
-    assert lhs.shape[0].value >= 16 and lhs.shape[1].value >= 16 \
-        and rhs.shape[1].value >= 16, \
-        f"All values in both first input shape ({lhs.shape}) and second input shape ({rhs.shape}) must be >= 16!"
+    # 4x4 MFMA instructions let M or N go down to 4 on hip
+    min_mn = 4 if is_hip() else 16
+    assert lhs.shape[0].value >= min_mn and lhs.shape[1].value >= 16 \
+        and rhs.shape[1].value >= min_mn, \
+        f"M and N of the first input shape ({lhs.shape}) and second input shape ({rhs.shape}) must be >= {min_mn} and K must be >= 16!"
 
     # hip for now converts fp8 to fp16 for mixed input
     if is_hip():
@@ -1377,8 +1405,10 @@ def dot(lhs: tl.tensor,
     M = lhs.type.shape[0]
     N = rhs.type.shape[1]
 
-    # Cast operands of types f16 and i8 for configurations where FMA only supported.
-    if is_hip() and not mfma_supported(M, N, lhs.type.shape[1], allow_tf32, ret_scalar_ty):
+    # Cast operands of types f16 and i8 for configurations where FMA only supported,
+    # unless the target has packed dot instructions for them.
+    if is_hip() and not mfma_supported(M, N, lhs.type.shape[1], allow_tf32, ret_scalar_ty, lhs.type.scalar) \
+            and not packed_dot_supported(ret_scalar_ty, lhs.type.scalar):
         ret_cast_scalar_ty = tl.float32 if lhs.type.scalar.is_int() else ret_scalar_ty
         lhs = cast(lhs, ret_cast_scalar_ty, builder)
         rhs = cast(rhs, ret_cast_scalar_ty, builder)
@@ -1390,7 +1420,7 @@ def dot(lhs: tl.tensor,
         ret = tl.tensor(builder.create_dot(lhs.handle, rhs.handle, _0, allow_tf32),
                         ret_ty)
         return cast(ret, ret_scalar_ty, builder)
-    if is_hip() and mfma_supported(M, N, lhs.type.shape[1], allow_tf32, ret_scalar_ty) and ret_scalar_ty.primitive_bitwidth < 32:
+    if is_hip() and mfma_supported(M, N, lhs.type.shape[1], allow_tf32, ret_scalar_ty, lhs.type.scalar) and ret_scalar_ty.primitive_bitwidth < 32:
         if lhs.type.scalar.is_int():
             ret_dot_scalar_ty = tl.int32
             _0 = builder.create_splat(builder.get_int32(0), [M, N])
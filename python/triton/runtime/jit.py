@@ -197,6 +197,21 @@ class JITFunction(KernelInterface[T]):
 
         return False
 
+    @staticmethod
+    def _fits_in_int32(arg):
+        # Whether every in-bounds byte offset into the buffer of `arg` fits in
+        # a signed 32-bit integer, so that the compiler may compute pointer
+        # offsets derived from it in 32 bits.
+        if not hasattr(arg, "data_ptr"):
+            return False
+        if hasattr(arg, "untyped_storage"):
+            nbytes = arg.untyped_storage().nbytes()
+        elif hasattr(arg, "numel") and hasattr(arg, "element_size"):
+            nbytes = arg.numel() * arg.element_size()
+        else:
+            return False
+        return nbytes < 2**31
+
     @staticmethod
     def _spec_of(arg):
         if hasattr(arg, "data_ptr"):
@@ -233,8 +248,10 @@ class JITFunction(KernelInterface[T]):
         # TODO: method to collect all folded args
         none_args = {i for i, arg in enumerate(args) if arg is None and i not in self.do_not_specialize}
         ids_of_folded_args = equal_to_1 | none_args
-        return namedtuple("instance_descriptor", ["divisible_by_16", "equal_to_1", "ids_of_folded_args", "divisible_by_8"])(
-            tuple(divisible_by_16), tuple(equal_to_1), tuple(ids_of_folded_args), tuple(divisible_by_8))
+        pointer_range_32 = {i for i, arg in enumerate(
+            args) if i in self.pointer_range_32 and JITFunction._fits_in_int32(arg)}
+        return namedtuple("instance_descriptor", ["divisible_by_16", "equal_to_1", "ids_of_folded_args", "divisible_by_8", "pointer_range_32"])(
+            tuple(divisible_by_16), tuple(equal_to_1), tuple(ids_of_folded_args), tuple(divisible_by_8), tuple(pointer_range_32))
         # return _triton.code_gen.instance_descriptor(divisible_by_16,
         # equal_to_1)
 
@@ -282,13 +299,13 @@ class JITFunction(KernelInterface[T]):
         constants = dict(zip(self.constexprs, constexpr_key))
         return constants
 
-    def _call_hook(self, key, signature, device, constants, num_warps, num_ctas, num_stages, waves_per_eu, matrix_instr_nonkdim, enable_warp_specialization, extern_libs, configs):
+    def _call_hook(self, key, signature, device, constants, num_warps, num_ctas, num_stages, waves_per_eu, matrix_instr_nonkdim, kpack, instruction_sched_variant, num_persistent_programs, enable_warp_specialization, extern_libs, configs):
         if JITFunction.cache_hook is None:
             return False
         name = self.fn.__name__
         module = self.fn.__module__
         arg_reprs = ', '.join([f'{name}: {ty}' for name, ty in zip(self.arg_names, key[1])])
-        repr = f"{name}[num_warps={num_warps}, num_ctas={num_ctas}, num_stages={num_stages}, waves_per_eu={waves_per_eu}, matrix_instr_nonkdim={matrix_instr_nonkdim}, enable_warp_specialization={enable_warp_specialization}]({arg_reprs})"
+        repr = f"{name}[num_warps={num_warps}, num_ctas={num_ctas}, num_stages={num_stages}, waves_per_eu={waves_per_eu}, matrix_instr_nonkdim={matrix_instr_nonkdim}, kpack={kpack}, instruction_sched_variant={instruction_sched_variant}, num_persistent_programs={num_persistent_programs}, enable_warp_specialization={enable_warp_specialization}]({arg_reprs})"
         key = str(key)
 
         class LegacyCompiler:
@@ -298,7 +315,7 @@ class JITFunction(KernelInterface[T]):
                 pass
 
         kwargs = dict(signature=signature, device=device, constants=constants,
-                      num_warps=num_warps, num_ctas=num_ctas, num_stages=num_stages, waves_per_eu=waves_per_eu, enable_warp_specialization=enable_warp_specialization, extern_libs=extern_libs,
+                      num_warps=num_warps, num_ctas=num_ctas, num_stages=num_stages, waves_per_eu=waves_per_eu, instruction_sched_variant=instruction_sched_variant, num_persistent_programs=num_persistent_programs, enable_warp_specialization=enable_warp_specialization, extern_libs=extern_libs,
                       configs=configs)
 
         return JITFunction.cache_hook(key=key, repr=repr, fn=LegacyCompiler(module, name), compile={
@@ -306,12 +323,14 @@ class JITFunction(KernelInterface[T]):
 
     def _get_arg_specialization_key(self, arg) -> str:
         arg_annotation = self.__annotations__.get(arg, '')
+        # the buffer size is only queried for the arguments that opted in
+        fits_in_int32 = f', _fits_in_int32({arg})' if self.arg_names.index(arg) in self.pointer_range_32 else ''
         if arg_annotation == '':
-            return f'({arg}.data_ptr() % {JITFunction.divisibility} == 0) if hasattr({arg}, "data_ptr") \
+            return f'({arg}.data_ptr() % {JITFunction.divisibility} == 0{fits_in_int32}) if hasattr({arg}, "data_ptr") \
                         else ({arg} % {JITFunction.divisibility} == 0, {arg} % {JITFunction.divisibility_8} == 0, {arg} == 1) if isinstance({arg}, int) \
                         else (False,)'
         elif 'Tensor' in arg_annotation:
-            return f'({arg}.data_ptr() % {JITFunction.divisibility} == 0)'
+            return f'({arg}.data_ptr() % {JITFunction.divisibility} == 0{fits_in_int32})'
         elif arg_annotation == 'int':
             return f'({arg} % {JITFunction.divisibility} == 0, {arg} % {JITFunction.divisibility_8} == 0, {arg} == 1)'
         else:
@@ -370,7 +389,7 @@ class JITFunction(KernelInterface[T]):
 
         src = f"""
 import triton
-def {self.fn.__name__}({args_signature}grid=None, num_warps=None, num_ctas=1, num_stages=None, waves_per_eu=0, matrix_instr_nonkdim=0, enable_warp_specialization=False, extern_libs=None, stream=None, warmup=False, device=None, device_type=None):
+def {self.fn.__name__}({args_signature}grid=None, num_warps=None, num_ctas=1, num_stages=None, waves_per_eu=0, matrix_instr_nonkdim=0, kpack=1, instruction_sched_variant='none', num_persistent_programs=0, enable_warp_specialization=False, extern_libs=None, stream=None, warmup=False, device=None, device_type=None):
     from ..compiler import compile, CompiledKernel, get_arch_default_num_warps, get_arch_default_num_stages
     sig_key = {f'{sig_keys},' if len(sig_keys) > 0 else ()}
     constexpr_key = {f'{constexpr_keys},' if len(constexpr_keys) > 0 else ()}
@@ -412,7 +431,7 @@ def {self.fn.__name__}({args_signature}grid=None, num_warps=None, num_ctas=1, nu
     if num_stages is None:
         num_stages = get_arch_default_num_stages(device_type)
 
-    key = (version_key, sig_key, constexpr_key, spec_key, num_warps, num_ctas, num_stages, waves_per_eu, matrix_instr_nonkdim, enable_warp_specialization, self.debug)
+    key = (version_key, sig_key, constexpr_key, spec_key, num_warps, num_ctas, num_stages, waves_per_eu, matrix_instr_nonkdim, kpack, instruction_sched_variant, num_persistent_programs, enable_warp_specialization, self.debug)
     if not extern_libs is None:
       key = (key, tuple(extern_libs.items()))
 
@@ -420,6 +439,7 @@ def {self.fn.__name__}({args_signature}grid=None, num_warps=None, num_ctas=1, nu
     if bin is not None:
       # build dict of constant values
       args = [{args}]
+      grid_0, args = bin.assemble_persistent_tiles(grid_0, args)
       # Create tensormaps and append to args
       args = bin.assemble_tensormap_to_arg(args)
       if not warmup:
@@ -440,8 +460,9 @@ def {self.fn.__name__}({args_signature}grid=None, num_warps=None, num_ctas=1, nu
       for i, arg in constants.items():
         if callable(arg):
           raise TypeError(f"Callable constexpr at index {{i}} is not supported")
-      if not self._call_hook(key, signature, device, constants, num_warps, num_ctas, num_stages, waves_per_eu, matrix_instr_nonkdim, enable_warp_specialization, extern_libs, configs):
-        bin = compile(self, signature=signature, device=device, constants=constants, num_warps=num_warps, num_ctas=num_ctas, num_stages=num_stages, waves_per_eu=waves_per_eu, matrix_instr_nonkdim=matrix_instr_nonkdim, enable_warp_specialization=enable_warp_specialization, extern_libs=extern_libs, configs=configs, debug=self.debug, device_type=device_type)
+      if not self._call_hook(key, signature, device, constants, num_warps, num_ctas, num_stages, waves_per_eu, matrix_instr_nonkdim, kpack, instruction_sched_variant, num_persistent_programs, enable_warp_specialization, extern_libs, configs):
+        bin = compile(self, signature=signature, device=device, constants=constants, num_warps=num_warps, num_ctas=num_ctas, num_stages=num_stages, waves_per_eu=waves_per_eu, matrix_instr_nonkdim=matrix_instr_nonkdim, kpack=kpack, instruction_sched_variant=instruction_sched_variant, num_persistent_programs=num_persistent_programs, enable_warp_specialization=enable_warp_specialization, extern_libs=extern_libs, configs=configs, debug=self.debug, device_type=device_type)
+        grid_0, args = bin.assemble_persistent_tiles(grid_0, args)
         # Create tensormaps and append to args
         args = bin.assemble_tensormap_to_arg(args)
         if not warmup:
@@ -455,6 +476,7 @@ def {self.fn.__name__}({args_signature}grid=None, num_warps=None, num_ctas=1, nu
                  "self": self,
                  "_spec_of": self._spec_of,
                  "_key_of": self._key_of,
+                 "_fits_in_int32": self._fits_in_int32,
                  "_device_of": self._device_of,
                  "_pinned_memory_of": self._pinned_memory_of,
                  "cache": self.cache,
@@ -465,7 +487,7 @@ def {self.fn.__name__}({args_signature}grid=None, num_warps=None, num_ctas=1, nu
         exec(src, scope)
         return scope[self.fn.__name__]
 
-    def __init__(self, fn, version=None, do_not_specialize=None, debug=None, noinline=None):
+    def __init__(self, fn, version=None, do_not_specialize=None, debug=None, noinline=None, noalias=None, pointer_range_32=None):
         self.fn = fn
         self.module = fn.__module__
         self.version = version
@@ -494,6 +516,14 @@ def {self.fn.__name__}({args_signature}grid=None, num_warps=None, num_ctas=1, nu
         regular_args = [arg for i, arg in enumerate(self.arg_names) if i not in self.constexprs]
         self.do_not_specialize = [] if do_not_specialize is None else do_not_specialize
         self.do_not_specialize = {regular_args.index(arg) if isinstance(arg, str) else arg for arg in self.do_not_specialize}
+        # pointer arguments the caller promises do not alias any other pointer
+        # argument; lowered to the `tt.noalias` argument attribute
+        self.noalias = [] if noalias is None else noalias
+        self.noalias = {self.arg_names.index(arg) if isinstance(arg, str) else arg for arg in self.noalias}
+        # pointer arguments whose buffer size is checked at launch; those smaller
+        # than 2**31 bytes get a variant where offsets are computed in 32 bits
+        self.pointer_range_32 = [] if pointer_range_32 is None else pointer_range_32
+        self.pointer_range_32 = {self.arg_names.index(arg) if isinstance(arg, str) else arg for arg in self.pointer_range_32}
         # tma info
         self.tensormaps_info = TMAInfos()
         # launcher
@@ -510,7 +540,8 @@ def {self.fn.__name__}({args_signature}grid=None, num_warps=None, num_ctas=1, nu
         if self.hash is None:
             dependencies_finder = DependenciesFinder(globals=self.__globals__, src=self.src)
             dependencies_finder.visit(self.parse())
-            self.hash = dependencies_finder.ret + version_key()
+            noalias = str(sorted(self.noalias)) if self.noalias else ""
+            self.hash = dependencies_finder.ret + noalias + version_key()
         return self.hash
 
     def warmup(self, *args, **kwargs):
@@ -561,6 +592,8 @@ def jit(
     do_not_specialize: Optional[Iterable[int]] = None,
     debug: Optional[bool] = None,
     noinline: Optional[bool] = None,
+    noalias: Optional[Iterable[Union[int, str]]] = None,
+    pointer_range_32: Optional[Iterable[Union[int, str]]] = None,
 ) -> Callable[[T], JITFunction[T]]:
     ...
 
@@ -572,6 +605,8 @@ def jit(
     do_not_specialize: Optional[Iterable[int]] = None,
     debug: Optional[bool] = None,
     noinline: Optional[bool] = None,
+    noalias: Optional[Iterable[Union[int, str]]] = None,
+    pointer_range_32: Optional[Iterable[Union[int, str]]] = None,
     interpret: Optional[bool] = None,
 ) -> Union[JITFunction[T], Callable[[T], JITFunction[T]]]:
     """
@@ -604,6 +639,8 @@ def jit(
                 do_not_specialize=do_not_specialize,
                 debug=debug,
                 noinline=noinline,
+                noalias=noalias,
+                pointer_range_32=pointer_range_32,
             )
     if fn is not None:
         return decorator(fn)
@@ -23,16 +23,16 @@ else:
     from ..._C.libtriton import triton as _triton
 
 
-def make_stub(name, signature, constants, ids, **kwargs):
+def make_stub(name, signature, constants, ids, warp_size=64, **kwargs):
     # name of files that are cached
-    so_cache_key = make_so_cache_key(version_key(), signature, constants, ids, **kwargs)
+    so_cache_key = make_so_cache_key(version_key(), signature, constants, ids, warp_size=warp_size, **kwargs)
     so_cache_manager = get_cache_manager(so_cache_key)
     so_name = f"{name}.so"
     # retrieve stub from cache if it exists
     cache_path = so_cache_manager.get_file(so_name)
     if cache_path is None:
         with tempfile.TemporaryDirectory() as tmpdir:
-            src = generate_launcher_hip(constants, signature, ids)
+            src = generate_launcher_hip(constants, signature, ids, warp_size)
             src_path = os.path.join(tmpdir, "main.c")
             with open(src_path, "w") as f:
                 f.write(src)
@@ -62,7 +62,7 @@ def ty_to_cpp(ty):
     }[ty]
 
 
-def generate_launcher_hip(constants, signature, ids):
+def generate_launcher_hip(constants, signature, ids, warp_size=64):
     start_desc = len(signature)
     signature = generate_cu_signature(constants, signature, ids)
     arg_decls = ', '.join(f"{ty_to_cpp(ty)} arg{i}" for i, ty in signature.items())
@@ -125,7 +125,7 @@ static void _launch(int gridX, int gridY, int gridZ, int num_warps, int num_ctas
   // printf("_launch hip kernel\\n");
   void *params[] = {{ {', '.join(f"&arg{i}" for i in params)} }};
   if (gridX*gridY*gridZ > 0) {{
-      HIP_CHECK(hipModuleLaunchKernel(function, gridX, gridY, gridZ, 64*num_warps, 1, 1, shared_memory, stream, params, 0));
+      HIP_CHECK(hipModuleLaunchKernel(function, gridX, gridY, gridZ, {warp_size}*num_warps, 1, 1, shared_memory, stream, params, 0));
     }}
   }}
 
@@ -240,7 +240,7 @@ PyMODINIT_FUNC PyInit___triton_launcher(void) {{
     return src
 
 
-def get_amdgcn_bitcode_paths(gfx_arch: str):
+def get_amdgcn_bitcode_paths(gfx_arch: str, warp_size: int = 64):
     # print("get_amdgcn_bitcode_paths")
     gpu_arch_agnostic_bitcode_libraries = ["opencl.bc",
                                            "ocml.bc",
@@ -249,7 +249,7 @@ def get_amdgcn_bitcode_paths(gfx_arch: str):
                                            "oclc_daz_opt_off.bc",
                                            "oclc_correctly_rounded_sqrt_on.bc",
                                            "oclc_unsafe_math_off.bc",
-                                           "oclc_wavefrontsize64_on.bc",
+                                           "oclc_wavefrontsize64_on.bc" if warp_size == 64 else "oclc_wavefrontsize64_off.bc",
                                            "oclc_abi_version_400.bc", ]
 
     gfx_arch_id = re.search('gfx(\\w+)', gfx_arch).group(1).strip()
@@ -291,7 +291,16 @@ def get_amdgpu_arch_fulldetails():
         gfx_arch = os.environ.get('MI_GPU_ARCH', arch_name)
         if gfx_arch is None:
             raise RuntimeError('gfx_arch is None (not specified)')
-        return {"gfx_triple": arch_triple, "gfx_arch": gfx_arch, "gfx_features": arch_features}
+        # RDNA 3 runs both wave32 and wave64 and defaults to wave32. Kernels are
+        # compiled for wave64, unless AMDGCN_USE_WAVE32=1 selects its native
+        # wave size.
+        warp_size = 64
+        if gfx_arch.startswith('gfx11'):
+            if os.environ.get('AMDGCN_USE_WAVE32', '0') == '1':
+                warp_size = 32
+            else:
+                arch_features = ",".join(f for f in [arch_features, "+wavefrontsize64"] if f)
+        return {"gfx_triple": arch_triple, "gfx_arch": gfx_arch, "gfx_features": arch_features, "warp_size": warp_size}
     except BaseException as e:
         print("Error: Attempting to get amgpu ISA Details {}".format(e))
         return None
@@ -322,9 +331,9 @@ def get_arch_details(arch: dict):
     return gfx_arch, gfx_triple, gfx_features
 
 
-def update_extern_libs(extern_libs: dict, gfx_arch: str):
+def update_extern_libs(extern_libs: dict, gfx_arch: str, warp_size: int = 64):
     # append extern_libs
-    extern_libs.update(get_amdgcn_bitcode_paths(gfx_arch))
+    extern_libs.update(get_amdgcn_bitcode_paths(gfx_arch, warp_size))
     for key in list(extern_libs):
         if extern_libs[key] == '' or extern_libs[key] is None:
             extern_libs.pop(key)
@@ -350,7 +359,7 @@ def optimize_ttgir_rocm():
 
 
 def ttgir_to_llir_rocm(module: str, extern_libs: dict, arch: dict):
-    names, paths = update_extern_libs(extern_libs, arch["gfx_arch"])
+    names, paths = update_extern_libs(extern_libs, arch["gfx_arch"], arch["warp_size"])
     llvmIR = _triton.translate_ttgir_to_llvmir(module, names, paths)
     return llvmIR
 
@@ -368,7 +377,7 @@ def llir_to_amdgcn_and_hsaco_rocm(module: str, arch: dict):
 
 def ttir_to_amdgcn_and_hsaco(module, context, arch, num_warps, num_stages, extern_libs) -> Tuple[str, str]:
     gfx_arch, gfx_triple, gfx_features = get_arch_details(arch)
-    names, paths = update_extern_libs(extern_libs, gfx_arch)
+    names, paths = update_extern_libs(extern_libs, gfx_arch, arch["warp_size"])
     return _triton.translate_triton_ir_to_amdgcn_and_hsaco(str(module), gfx_arch, gfx_triple, gfx_features, num_warps, num_stages, names, paths)
 
 
@@ -410,13 +419,16 @@ class HIPBackend(BaseBackend):
             tma_infos = other["tma_infos"]
             waves_per_eu = other["waves_per_eu"]
             matrix_instr_nonkdim = other["matrix_instr_nonkdim"]
+            kpack = other["kpack"]
+            instruction_sched_variant = other["instruction_sched_variant"]
+            num_persistent_programs = other["num_persistent_programs"]
 
             stages["ttgir"] = (lambda path: parse_mlir_module(path, context),
-                               lambda src: optimize_ttgir(ttir_to_ttgir(src, num_warps, warp_size, num_ctas, arch), num_stages, num_warps, num_ctas, arch, cluster_info, enable_warp_specialization, enable_persistent, optimize_epilogue, matrix_instr_nonkdim))
+                               lambda src: optimize_ttgir(ttir_to_ttgir(src, num_warps, warp_size, num_ctas, arch), num_stages, num_warps, num_ctas, arch, cluster_info, enable_warp_specialization, enable_persistent, optimize_epilogue, matrix_instr_nonkdim, num_persistent_programs, waves_per_eu, kpack))
             stages["llir"] = (lambda path: Path(path).read_text(),
-                              lambda src: ttgir_to_llir(src, extern_libs, arch, tma_infos, waves_per_eu))
+                              lambda src: ttgir_to_llir(src, extern_libs, arch, tma_infos, waves_per_eu, instruction_sched_variant))
 
-            extern_libs.update(get_amdgcn_bitcode_paths(gfx_arch))
+            extern_libs.update(get_amdgcn_bitcode_paths(gfx_arch, warp_size))
             for key in list(extern_libs):
                 if extern_libs[key] == '' or extern_libs[key] is None:
                     extern_libs.pop(key)
@@ -466,12 +478,11 @@ class HIPBackend(BaseBackend):
         arch["num_warps"] = 4
         arch["num_stages"] = 2
         arch["num_ctas"] = 1
-        arch["warp_size"] = 64
         return arch
 
-    def make_launcher_stub(self, name, signature, constants, ids):
+    def make_launcher_stub(self, name, signature, constants, ids, warp_size=64):
         # print("HIPBackend.make_launcher_stub")
-        self.stub_so_path = make_stub(name, signature, constants, ids)
+        self.stub_so_path = make_stub(name, signature, constants, ids, warp_size)
         return self.stub_so_path
 
     def get_shared_memory_size(self, module):
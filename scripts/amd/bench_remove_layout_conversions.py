@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+# Measures the compile time of --tritongpu-remove-layout-conversions on
+# synthetic TTGIR functions of increasing size.
+#
+# Each block of the generated function loads a tile in one layout, runs a
+# chain of elementwise ops, converts the result to another layout and adds it
+# to an accumulator carried across blocks, so that the pass has to propagate
+# layouts, resolve conflicts and rematerialize slices.
+#
+# usage: bench_remove_layout_conversions.py [--triton-opt PATH] [--blocks N ...]
+import argparse
+import os
+import shutil
+import subprocess
+import tempfile
+import time
+
+HEADER = """\
+#A = #triton_gpu.blocked<{sizePerThread = [1, 4], threadsPerWarp = [8, 8], warpsPerCTA = [4, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#B = #triton_gpu.blocked<{sizePerThread = [4, 1], threadsPerWarp = [8, 8], warpsPerCTA = [1, 4], order = [0, 1], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [0, 1]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  tt.func public @kernel(%ptr_a: tensor<128x128x!tt.ptr<f32, 1>, #A>, %ptr_b: tensor<128x128x!tt.ptr<f32, 1>, #B>) {
+    %acc0 = arith.constant dense<0.000000e+00> : tensor<128x128xf32, #B>
+"""
+
+FOOTER = """\
+    tt.store %ptr_b, %acc{n} {{cache = 1 : i32, evict = 1 : i32}} : tensor<128x128xf32, #B>
+    tt.return
+  }}
+}}
+"""
+
+
+def block(i, chain):
+    lines = [f"    %x{i}_0 = tt.load %ptr_a {{cache = 1 : i32, evict = 1 : i32, isVolatile = false}} : tensor<128x128xf32, #A>"]
+    for j in range(chain):
+        op = "arith.mulf" if j % 2 else "arith.addf"
+        lines.append(f"    %x{i}_{j + 1} = {op} %x{i}_{j}, %x{i}_0 : tensor<128x128xf32, #A>")
+    lines.append(f"    %c{i} = triton_gpu.convert_layout %x{i}_{chain} : (tensor<128x128xf32, #A>) -> tensor<128x128xf32, #B>")
+    lines.append(f"    %acc{i + 1} = arith.addf %acc{i}, %c{i} : tensor<128x128xf32, #B>")
+    return "\n".join(lines) + "\n"
+
+
+def generate(num_blocks, chain):
+    body = "".join(block(i, chain) for i in range(num_blocks))
+    return HEADER + body + FOOTER.format(n=num_blocks)
+
+
+def run(triton_opt, path, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.perf_counter()
+        subprocess.run([triton_opt, path, "--tritongpu-remove-layout-conversions", "-o", os.devnull], check=True)
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--triton-opt", default=shutil.which("triton-opt") or "triton-opt")
+    parser.add_argument("--blocks", type=int, nargs="+", default=[16, 64, 256, 1024])
+    parser.add_argument("--chain", type=int, default=4, help="elementwise ops per block")
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    print(f"{'blocks':>8} {'ops':>8} {'seconds':>10} {'us/op':>8}")
+    with tempfile.TemporaryDirectory() as tmp:
+        for num_blocks in args.blocks:
+            path = os.path.join(tmp, f"kernel_{num_blocks}.mlir")
+            with open(path, "w") as f:
+                f.write(generate(num_blocks, args.chain))
+            num_ops = num_blocks * (args.chain + 3) + 3
+            seconds = run(args.triton_opt, path, args.repeat)
+            print(f"{num_blocks:>8} {num_ops:>8} {seconds:>10.3f} {1e6 * seconds / num_ops:>8.1f}")
+
+
+if __name__ == "__main__":
+    main()
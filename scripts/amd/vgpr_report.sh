@@ -0,0 +1,45 @@
+#!/bin/bash
+# Compare register usage of the tutorial kernels with and without the
+# uniformity analysis (DISABLE_UNIFORMITY_ANALYSIS).
+#
+# usage: scripts/amd/vgpr_report.sh [tutorial.py ...]
+
+ROOT=$(git rev-parse --show-toplevel)
+TUTORIALS=("$@")
+if [ ${#TUTORIALS[@]} -eq 0 ]; then
+	TUTORIALS=(
+		$ROOT/python/tutorials/01-vector-add.py
+		$ROOT/python/tutorials/02-fused-softmax.py
+		$ROOT/python/tutorials/03-matrix-multiplication.py
+		$ROOT/python/tutorials/05-layer-norm.py
+		$ROOT/python/tutorials/06-fused-attention.py
+	)
+fi
+
+WORKDIR=$(mktemp -d)
+trap "rm -rf $WORKDIR" EXIT
+
+# collect <cache dir> <disable flag>
+collect() {
+	for tutorial in ${TUTORIALS[@]}; do
+		TRITON_CACHE_DIR=$1 DISABLE_UNIFORMITY_ANALYSIS=$2 \
+			python $tutorial >/dev/null 2>&1 ||
+			echo "warning: $(basename $tutorial) failed" >&2
+	done
+	# print "<kernel> <vgprs> <sgprs>" for every compiled kernel
+	for file in $(find $1 -type f -name "*.amdgcn"); do
+		awk -v kernel=$(basename $file .amdgcn) '
+			/\.sgpr_count:/ { sgpr = $2 }
+			/\.vgpr_count:/ { vgpr = $2 }
+			END { print kernel, vgpr, sgpr }' $file
+	done | sort -u
+}
+
+collect $WORKDIR/base 1 >$WORKDIR/base.txt
+collect $WORKDIR/uniform 0 >$WORKDIR/uniform.txt
+
+printf "%-40s %12s %12s %12s %12s\n" kernel vgpr_base vgpr_uniform sgpr_base sgpr_uniform
+join $WORKDIR/base.txt $WORKDIR/uniform.txt |
+	awk '{ printf "%-40s %12d %12d %12d %12d\n", $1, $2, $4, $3, $5;
+	       total_base += $2; total_uniform += $4 }
+	     END { printf "%-40s %12d %12d\n", "total", total_base, total_uniform }'
@@ -0,0 +1,61 @@
+// RUN: triton-opt %s -test-print-uniformity -split-input-file -o %t 2>&1 | FileCheck %s
+
+// CHECK-LABEL: @splat_and_load
+tt.func @splat_and_load(%arg0: !tt.ptr<f32>, %arg1: i32) {
+  // CHECK-NEXT: %0 => uniform
+  %0 = tt.splat %arg0 : (!tt.ptr<f32>) -> tensor<128x!tt.ptr<f32>>
+  // CHECK-NEXT: %1 => uniform
+  %1 = tt.splat %arg1 : (i32) -> tensor<128xi32>
+  // CHECK-NEXT: %2 => uniform
+  %2 = tt.addptr %0, %1 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  // CHECK-NEXT: %3 => uniform
+  %3 = tt.load %2 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128xf32>
+  // CHECK-NEXT: %4 => divergent
+  %4 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  // CHECK-NEXT: %5 => divergent
+  %5 = tt.addptr %0, %4 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  // CHECK-NEXT: %6 => divergent
+  %6 = tt.load %5 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128xf32>
+  // CHECK-NEXT: %7 => divergent
+  %7 = arith.addf %3, %6 : tensor<128xf32>
+  // CHECK-NEXT: %cst => uniform
+  %cst = arith.constant dense<128> : tensor<128xi32>
+  // AxisInfo knows that every element of the range maps to the same row.
+  // CHECK-NEXT: %8 => uniform
+  %8 = arith.divsi %4, %cst : tensor<128xi32>
+  // CHECK-NEXT: %9 => divergent
+  %9 = tt.load %2 {cache = 1 : i32, evict = 1 : i32, isVolatile = true} : tensor<128xf32>
+  tt.return
+}
+
+// -----
+
+// CHECK-LABEL: @loop_carried
+tt.func @loop_carried(%arg0: !tt.ptr<f32>, %arg1: i32) {
+  %c0_i32 = arith.constant 0 : i32
+  %c1_i32 = arith.constant 1 : i32
+  // CHECK-NEXT: %0 => uniform
+  %0 = tt.splat %arg0 : (!tt.ptr<f32>) -> tensor<128x!tt.ptr<f32>>
+  // CHECK-NEXT: %1 => divergent
+  %1 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  // CHECK-NEXT: %cst => uniform
+  %cst = arith.constant dense<0.000000e+00> : tensor<128xf32>
+  // CHECK-NEXT: %arg3 => uniform
+  // CHECK-NEXT: %arg4 => divergent
+  // CHECK-NEXT: %2#0 => uniform
+  // CHECK-NEXT: %2#1 => divergent
+  %2:2 = scf.for %arg2 = %c0_i32 to %arg1 step %c1_i32 iter_args(%arg3 = %cst, %arg4 = %cst) -> (tensor<128xf32>, tensor<128xf32>) : i32 {
+    // CHECK-NEXT: %3 => uniform
+    %3 = tt.load %0 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128xf32>
+    // CHECK-NEXT: %4 => uniform
+    %4 = arith.addf %arg3, %3 : tensor<128xf32>
+    // CHECK-NEXT: %5 => divergent
+    %5 = tt.addptr %0, %1 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    // CHECK-NEXT: %6 => divergent
+    %6 = tt.load %5 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128xf32>
+    // CHECK-NEXT: %7 => divergent
+    %7 = arith.addf %arg4, %6 : tensor<128xf32>
+    scf.yield %4, %7 : tensor<128xf32>, tensor<128xf32>
+  }
+  tt.return
+}
@@ -0,0 +1,53 @@
+// RUN: triton-opt %s -split-input-file --convert-triton-gpu-to-llvm="target=rocdl matrix-core-version=2" | FileCheck %s
+
+// Each lane copies one dword per row straight to the unswizzled buffer, and
+// waiting for all but one group leaves one group of 4 loads in flight.
+
+#AL = #triton_gpu.blocked<{sizePerThread = [1, 1], threadsPerWarp = [1, 64], warpsPerCTA = [4, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#slice = #triton_gpu.slice<{dim = 0, parent = #AL}>
+#A = #triton_gpu.shared<{vec = 1, perPhase = 1, maxPhase = 1, order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: direct_to_lds
+  tt.func @direct_to_lds(%arg0: !tt.ptr<f32> {tt.divisibility = 16 : i32}) {
+    %range = tt.make_range {end = 64 : i32, start = 0 : i32} : tensor<64xi32, #slice>
+    %off0 = tt.expand_dims %range {axis = 0 : i32} : (tensor<64xi32, #slice>) -> tensor<1x64xi32, #AL>
+    %off = tt.broadcast %off0 : (tensor<1x64xi32, #AL>) -> tensor<16x64xi32, #AL>
+    %a_init = tt.splat %arg0 : (!tt.ptr<f32>) -> tensor<16x64x!tt.ptr<f32>, #AL>
+    %a_ptr = tt.addptr %a_init, %off : tensor<16x64x!tt.ptr<f32>, #AL>, tensor<16x64xi32, #AL>
+    %tensor = triton_gpu.alloc_tensor : tensor<2x16x64xf32, #A>
+    %index = arith.constant 1 : i32
+    // CHECK-COUNT-4: llvm.call @llvm.amdgcn.global.load.lds
+    // CHECK-NOT: llvm.call @llvm.amdgcn.global.load.lds
+    %a = triton_gpu.insert_slice_async %a_ptr, %tensor, %index {axis = 0 : i32, cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<16x64x!tt.ptr<f32>, #AL> -> tensor<2x16x64xf32, #A>
+    triton_gpu.async_commit_group
+    // CHECK: s_waitcnt vmcnt(4)
+    triton_gpu.async_wait {num = 1 : i32}
+    tt.return
+  }
+}
+
+// -----
+
+// Swizzled buffers are still loaded through registers.
+
+#AL = #triton_gpu.blocked<{sizePerThread = [1, 1], threadsPerWarp = [1, 64], warpsPerCTA = [4, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#slice = #triton_gpu.slice<{dim = 0, parent = #AL}>
+#A = #triton_gpu.shared<{vec = 4, perPhase = 1, maxPhase = 8, order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: swizzled_fallback
+  tt.func @swizzled_fallback(%arg0: !tt.ptr<f32> {tt.divisibility = 16 : i32}) {
+    %range = tt.make_range {end = 64 : i32, start = 0 : i32} : tensor<64xi32, #slice>
+    %off0 = tt.expand_dims %range {axis = 0 : i32} : (tensor<64xi32, #slice>) -> tensor<1x64xi32, #AL>
+    %off = tt.broadcast %off0 : (tensor<1x64xi32, #AL>) -> tensor<16x64xi32, #AL>
+    %a_init = tt.splat %arg0 : (!tt.ptr<f32>) -> tensor<16x64x!tt.ptr<f32>, #AL>
+    %a_ptr = tt.addptr %a_init, %off : tensor<16x64x!tt.ptr<f32>, #AL>, tensor<16x64xi32, #AL>
+    %tensor = triton_gpu.alloc_tensor : tensor<2x16x64xf32, #A>
+    %index = arith.constant 1 : i32
+    // CHECK-NOT: llvm.amdgcn.global.load.lds
+    // CHECK-NOT: s_waitcnt vmcnt
+    %a = triton_gpu.insert_slice_async %a_ptr, %tensor, %index {axis = 0 : i32, cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<16x64x!tt.ptr<f32>, #AL> -> tensor<2x16x64xf32, #A>
+    triton_gpu.async_commit_group
+    triton_gpu.async_wait {num = 1 : i32}
+    tt.return
+  }
+}
@@ -0,0 +1,48 @@
+// RUN: triton-opt %s -split-input-file --convert-triton-gpu-to-llvm="target=rocdl matrix-core-version=2" | FileCheck %s
+
+// fp16 operands contiguous along K are read from shared memory in pairs and
+// multiplied with v_dot2_f32_f16.
+
+#blocked = #triton_gpu.blocked<{sizePerThread = [4, 4], threadsPerWarp = [8, 8], warpsPerCTA = [1, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#shared_a = #triton_gpu.shared<{vec = 1, perPhase = 1, maxPhase = 1, order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#shared_b = #triton_gpu.shared<{vec = 1, perPhase = 1, maxPhase = 1, order = [0, 1], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx=0, parent=#blocked}>
+#dot_operand_b = #triton_gpu.dot_op<{opIdx=1, parent=#blocked}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: fma_dot_f16
+  tt.func @fma_dot_f16(%a: tensor<32x16xf16, #shared_a>, %b: tensor<16x32xf16, #shared_b>) {
+    %cst = arith.constant dense<0.000000e+00> : tensor<32x32xf32, #blocked>
+    // CHECK: llvm.load {{.*}} : !llvm.ptr<vector<2xf16>, 3>
+    // CHECK: llvm.call @llvm.amdgcn.fdot2
+    // CHECK-NOT: llvm.intr.fmuladd
+    %a_mat = triton_gpu.convert_layout %a : (tensor<32x16xf16, #shared_a>) -> tensor<32x16xf16, #dot_operand_a>
+    %b_mat = triton_gpu.convert_layout %b : (tensor<16x32xf16, #shared_b>) -> tensor<16x32xf16, #dot_operand_b>
+    %0 = tt.dot %a_mat, %b_mat, %cst {allowTF32 = false} : tensor<32x16xf16, #dot_operand_a> * tensor<16x32xf16, #dot_operand_b> -> tensor<32x32xf32, #blocked>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
+
+// -----
+
+// int8 operands are read and multiplied 4 at a time with v_dot4_i32_i8.
+
+#blocked = #triton_gpu.blocked<{sizePerThread = [4, 4], threadsPerWarp = [8, 8], warpsPerCTA = [1, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#shared_a = #triton_gpu.shared<{vec = 1, perPhase = 1, maxPhase = 1, order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#shared_b = #triton_gpu.shared<{vec = 1, perPhase = 1, maxPhase = 1, order = [0, 1], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx=0, parent=#blocked}>
+#dot_operand_b = #triton_gpu.dot_op<{opIdx=1, parent=#blocked}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: fma_dot_i8
+  tt.func @fma_dot_i8(%a: tensor<32x16xi8, #shared_a>, %b: tensor<16x32xi8, #shared_b>) {
+    %cst = arith.constant dense<0> : tensor<32x32xi32, #blocked>
+    // CHECK: llvm.load {{.*}} : !llvm.ptr<vector<4xi8>, 3>
+    // CHECK: llvm.call @llvm.amdgcn.sdot4
+    // CHECK-NOT: llvm.mul
+    %a_mat = triton_gpu.convert_layout %a : (tensor<32x16xi8, #shared_a>) -> tensor<32x16xi8, #dot_operand_a>
+    %b_mat = triton_gpu.convert_layout %b : (tensor<16x32xi8, #shared_b>) -> tensor<16x32xi8, #dot_operand_b>
+    %0 = tt.dot %a_mat, %b_mat, %cst {allowTF32 = false} : tensor<32x16xi8, #dot_operand_a> * tensor<16x32xi8, #dot_operand_b> -> tensor<32x32xi32, #blocked>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
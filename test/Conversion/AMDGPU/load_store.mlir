@@ -15,8 +15,32 @@ module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 :
     // GCN: llvm.bitcast {{.*}} : i16 to vector<1xf16>
     // GCN: llvm.bitcast {{.*}} : f16 to f16
     // GCN: llvm.bitcast {{.*}} : vector<1xf16> to i16
-    // GCN: llvm.store {{.*}} : !llvm.ptr<f16, 1>
+    // GCN: llvm.bitcast {{.*}} : !llvm.ptr<f16, 1> to !llvm.ptr<i16, 1>
+    // GCN: llvm.store {{.*}} : !llvm.ptr<i16, 1>
     tt.store %1, %2 : f16
     tt.return
   }
 }
+
+// -----
+
+// Check that a 128-bit vector is loaded and stored with one access each.
+#blocked = #triton_gpu.blocked<{sizePerThread = [8], threadsPerWarp = [64], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: @test_dwordx4
+  tt.func public @test_dwordx4(%arg0: !tt.ptr<f16> {tt.divisibility = 16 : i32}, %arg1: !tt.ptr<f16> {tt.divisibility = 16 : i32}) {
+    %0 = tt.make_range {end = 2048 : i32, start = 0 : i32} : tensor<2048xi32, #blocked>
+    %1 = tt.splat %arg0 : (!tt.ptr<f16>) -> tensor<2048x!tt.ptr<f16>, #blocked>
+    %2 = tt.addptr %1, %0 : tensor<2048x!tt.ptr<f16>, #blocked>, tensor<2048xi32, #blocked>
+    %3 = tt.splat %arg1 : (!tt.ptr<f16>) -> tensor<2048x!tt.ptr<f16>, #blocked>
+    %4 = tt.addptr %3, %0 : tensor<2048x!tt.ptr<f16>, #blocked>, tensor<2048xi32, #blocked>
+    // GCN: llvm.load {{.*}}alignment = 16{{.*}} : !llvm.ptr<i128>
+    // GCN-NOT: llvm.load
+    // GCN: llvm.bitcast {{.*}} : i128 to vector<8xf16>
+    %5 = tt.load %2 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<2048xf16, #blocked>
+    // GCN: llvm.store {{.*}}alignment = 16{{.*}} : !llvm.ptr<i128, 1>
+    // GCN-NOT: llvm.store
+    tt.store %4, %5 : tensor<2048xf16, #blocked>
+    tt.return
+  }
+}
@@ -0,0 +1,89 @@
+// RUN: triton-opt %s -split-input-file --convert-triton-gpu-to-llvm=target=rocdl | FileCheck %s
+
+// Rows of a transposed 32x32 accumulator are split between the two lane
+// groups, 32 lanes apart: a single shuffle finishes the reduction.
+
+#mfma = #triton_gpu.mfma<{nonKDim = 32, warpsPerCTA = [4, 1], isTransposed = true, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: reduce_rows_mfma_32_transposed
+  tt.func @reduce_rows_mfma_32_transposed(%arg0: tensor<128x64xf32, #mfma>) {
+    // CHECK: ds_permute_b32
+    // CHECK-NOT: ds_permute_b32
+    // CHECK-NOT: ds_swizzle_b32
+    // CHECK-NOT: barrier
+    %0 = "tt.reduce" (%arg0) ({
+    ^bb0(%arg1: f32, %arg2: f32):
+      %max = arith.maxf %arg1, %arg2 : f32
+      tt.reduce.return %max : f32
+    }) {axis = 1 : i32} : (tensor<128x64xf32, #mfma>) -> tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #mfma}>>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
+
+// -----
+
+// Rows of a non-transposed 16x16 accumulator are held by 16 consecutive lanes
+// for each of the 4 rows of a lane.
+
+#mfma = #triton_gpu.mfma<{nonKDim = 16, warpsPerCTA = [4, 1], isTransposed = false, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: reduce_rows_mfma_16
+  tt.func @reduce_rows_mfma_16(%arg0: tensor<64x64xf32, #mfma>) {
+    // CHECK-COUNT-16: ds_swizzle_b32
+    // CHECK-NOT: ds_swizzle_b32
+    // CHECK-NOT: ds_permute_b32
+    // CHECK-NOT: barrier
+    %0 = "tt.reduce" (%arg0) ({
+    ^bb0(%arg1: f32, %arg2: f32):
+      %add = arith.addf %arg1, %arg2 : f32
+      tt.reduce.return %add : f32
+    }) {axis = 1 : i32} : (tensor<64x64xf32, #mfma>) -> tensor<64xf32, #triton_gpu.slice<{dim = 1, parent = #mfma}>>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
+
+// -----
+
+// Columns of a transposed accumulator are held by consecutive lanes, and
+// stay within the wave.
+
+#mfma = #triton_gpu.mfma<{nonKDim = 32, warpsPerCTA = [1, 4], isTransposed = true, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: reduce_cols_mfma_32_transposed
+  tt.func @reduce_cols_mfma_32_transposed(%arg0: tensor<64x128xf32, #mfma>) {
+    // CHECK: ds_swizzle_b32
+    // CHECK-NOT: ds_permute_b32
+    // CHECK-NOT: barrier
+    %0 = "tt.reduce" (%arg0) ({
+    ^bb0(%arg1: f32, %arg2: f32):
+      %add = arith.addf %arg1, %arg2 : f32
+      tt.reduce.return %add : f32
+    }) {axis = 0 : i32} : (tensor<64x128xf32, #mfma>) -> tensor<128xf32, #triton_gpu.slice<{dim = 0, parent = #mfma}>>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
+
+// -----
+
+// Columns of a non-transposed 16x16 accumulator are split between the 4 lane
+// groups, 16 lanes apart, and then between the waves along M.
+
+#mfma = #triton_gpu.mfma<{nonKDim = 16, warpsPerCTA = [2, 2], isTransposed = false, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: reduce_cols_mfma_16
+  tt.func @reduce_cols_mfma_16(%arg0: tensor<64x64xf32, #mfma>) {
+    // CHECK: ds_permute_b32
+    // CHECK: ds_swizzle_b32 {{.*}}offset:16415
+    // CHECK: barrier
+    %0 = "tt.reduce" (%arg0) ({
+    ^bb0(%arg1: f32, %arg2: f32):
+      %add = arith.addf %arg1, %arg2 : f32
+      tt.reduce.return %add : f32
+    }) {axis = 0 : i32} : (tensor<64x64xf32, #mfma>) -> tensor<64xf32, #triton_gpu.slice<{dim = 0, parent = #mfma}>>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
@@ -0,0 +1,57 @@
+// RUN: triton-opt %s -split-input-file --convert-triton-gpu-to-llvm=target=rocdl | FileCheck %s
+
+// With 16x16 instructions and a swizzled layout whose pattern repeats every
+// 16 elements along K, each lane reads its 4 elements of every instruction
+// with one 8 byte LDS read: one read of A and one of B per MFMA.
+
+#blocked0 = #triton_gpu.blocked<{sizePerThread = [1, 4], threadsPerWarp = [4, 16], warpsPerCTA = [1, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#blocked1 = #triton_gpu.blocked<{sizePerThread = [4, 1], threadsPerWarp = [16, 4], warpsPerCTA = [1, 1], order = [0, 1], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [0, 1]}>
+#sharedA = #triton_gpu.shared<{vec = 4, perPhase = 1, maxPhase = 4, order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#sharedB = #triton_gpu.shared<{vec = 4, perPhase = 1, maxPhase = 4, order = [0, 1], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [0, 1]}>
+#mfma = #triton_gpu.mfma<{nonKDim = 16, warpsPerCTA = [1, 1], isTransposed = false, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx = 0, parent = #mfma, kWidth = 4}>
+#dot_operand_b = #triton_gpu.dot_op<{opIdx = 1, parent = #mfma, kWidth = 4}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: swizzled_mfma_16
+  tt.func @swizzled_mfma_16(%A: tensor<16x64xf16, #blocked0>, %B: tensor<64x16xf16, #blocked1>) {
+    %AA = triton_gpu.convert_layout %A : (tensor<16x64xf16, #blocked0>) -> tensor<16x64xf16, #sharedA>
+    %BB = triton_gpu.convert_layout %B : (tensor<64x16xf16, #blocked1>) -> tensor<64x16xf16, #sharedB>
+    // CHECK-COUNT-8: llvm.load {{.*}} : !llvm.ptr<vector<4xf16>, 3>
+    // CHECK-NOT: llvm.load
+    // CHECK-COUNT-4: rocdl.mfma.f32.16x16x16f16
+    %AA_DOT = triton_gpu.convert_layout %AA : (tensor<16x64xf16, #sharedA>) -> tensor<16x64xf16, #dot_operand_a>
+    %BB_DOT = triton_gpu.convert_layout %BB : (tensor<64x16xf16, #sharedB>) -> tensor<64x16xf16, #dot_operand_b>
+    %cst0 = arith.constant dense<0.000000e+00> : tensor<16x16xf32, #mfma>
+    %D = tt.dot %AA_DOT, %BB_DOT, %cst0 {allowTF32 = true} : tensor<16x64xf16, #dot_operand_a> * tensor<64x16xf16, #dot_operand_b> -> tensor<16x16xf32, #mfma>
+    tt.return
+  }
+}
+
+// -----
+
+// With kPack = 2, a lane reads the 8 elements of two consecutive 16x16x16
+// instructions with one 16 byte LDS read: one read of A and one of B per two
+// MFMAs.
+
+#blocked0 = #triton_gpu.blocked<{sizePerThread = [1, 8], threadsPerWarp = [8, 8], warpsPerCTA = [1, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#blocked1 = #triton_gpu.blocked<{sizePerThread = [8, 1], threadsPerWarp = [8, 8], warpsPerCTA = [1, 1], order = [0, 1], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [0, 1]}>
+#sharedA = #triton_gpu.shared<{vec = 8, perPhase = 1, maxPhase = 8, order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#sharedB = #triton_gpu.shared<{vec = 8, perPhase = 1, maxPhase = 8, order = [0, 1], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [0, 1]}>
+#mfma = #triton_gpu.mfma<{nonKDim = 16, warpsPerCTA = [1, 1], isTransposed = false, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx = 0, parent = #mfma, kWidth = 8, kPack = 2}>
+#dot_operand_b = #triton_gpu.dot_op<{opIdx = 1, parent = #mfma, kWidth = 8, kPack = 2}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: kpack_mfma_16
+  tt.func @kpack_mfma_16(%A: tensor<16x64xf16, #blocked0>, %B: tensor<64x16xf16, #blocked1>) {
+    %AA = triton_gpu.convert_layout %A : (tensor<16x64xf16, #blocked0>) -> tensor<16x64xf16, #sharedA>
+    %BB = triton_gpu.convert_layout %B : (tensor<64x16xf16, #blocked1>) -> tensor<64x16xf16, #sharedB>
+    // CHECK-COUNT-4: llvm.load {{.*}} : !llvm.ptr<vector<8xf16>, 3>
+    // CHECK-NOT: llvm.load
+    // CHECK-COUNT-4: rocdl.mfma.f32.16x16x16f16
+    %AA_DOT = triton_gpu.convert_layout %AA : (tensor<16x64xf16, #sharedA>) -> tensor<16x64xf16, #dot_operand_a>
+    %BB_DOT = triton_gpu.convert_layout %BB : (tensor<64x16xf16, #sharedB>) -> tensor<64x16xf16, #dot_operand_b>
+    %cst0 = arith.constant dense<0.000000e+00> : tensor<16x16xf32, #mfma>
+    %D = tt.dot %AA_DOT, %BB_DOT, %cst0 {allowTF32 = true} : tensor<16x64xf16, #dot_operand_a> * tensor<64x16xf16, #dot_operand_b> -> tensor<16x16xf32, #mfma>
+    tt.return
+  }
+}
@@ -0,0 +1,58 @@
+// RUN: triton-opt %s -split-input-file --convert-triton-gpu-to-llvm=target=rocdl | FileCheck %s
+
+// A lane of a transposed 32x32 accumulator holds 4 consecutive f16 of a row
+// in each of its groups: pairs of lanes 32 apart exchange one group to store
+// 8 consecutive elements each.
+
+#mfma = #triton_gpu.mfma<{nonKDim = 32, warpsPerCTA = [1, 1], isTransposed = true, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: store_mfma_32_transposed
+  tt.func @store_mfma_32_transposed(%arg0: !tt.ptr<f16> {tt.divisibility = 16 : i32}, %arg1: tensor<32x32xf16, #mfma>) {
+    %c32 = arith.constant dense<32> : tensor<32x1xi32, #mfma>
+    %0 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32, #triton_gpu.slice<{dim = 1, parent = #mfma}>>
+    %1 = tt.expand_dims %0 {axis = 1 : i32} : (tensor<32xi32, #triton_gpu.slice<{dim = 1, parent = #mfma}>>) -> tensor<32x1xi32, #mfma>
+    %2 = arith.muli %1, %c32 : tensor<32x1xi32, #mfma>
+    %3 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32, #triton_gpu.slice<{dim = 0, parent = #mfma}>>
+    %4 = tt.expand_dims %3 {axis = 0 : i32} : (tensor<32xi32, #triton_gpu.slice<{dim = 0, parent = #mfma}>>) -> tensor<1x32xi32, #mfma>
+    %5 = tt.broadcast %2 : (tensor<32x1xi32, #mfma>) -> tensor<32x32xi32, #mfma>
+    %6 = tt.broadcast %4 : (tensor<1x32xi32, #mfma>) -> tensor<32x32xi32, #mfma>
+    %7 = arith.addi %5, %6 : tensor<32x32xi32, #mfma>
+    %8 = tt.splat %arg0 : (!tt.ptr<f16>) -> tensor<32x32x!tt.ptr<f16>, #mfma>
+    %9 = tt.addptr %8, %7 : tensor<32x32x!tt.ptr<f16>, #mfma>, tensor<32x32xi32, #mfma>
+    // CHECK-COUNT-4: llvm.call @llvm.amdgcn.ds.bpermute
+    // CHECK-NOT: llvm.amdgcn.ds.bpermute
+    // CHECK-COUNT-2: llvm.store {{.*}}alignment = 16{{.*}} : !llvm.ptr<i128, 1>
+    // CHECK-NOT: llvm.store
+    tt.store %9, %arg1 : tensor<32x32xf16, #mfma>
+    tt.return
+  }
+}
+
+// -----
+
+// A lane of a non-transposed 16x16 accumulator holds one element of each of
+// 4 rows: 4 consecutive lanes transpose them to store 4 f32 of a row each.
+
+#mfma = #triton_gpu.mfma<{nonKDim = 16, warpsPerCTA = [1, 1], isTransposed = false, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: store_mfma_16
+  tt.func @store_mfma_16(%arg0: !tt.ptr<f32> {tt.divisibility = 16 : i32}, %arg1: tensor<16x16xf32, #mfma>) {
+    %c16 = arith.constant dense<16> : tensor<16x1xi32, #mfma>
+    %0 = tt.make_range {end = 16 : i32, start = 0 : i32} : tensor<16xi32, #triton_gpu.slice<{dim = 1, parent = #mfma}>>
+    %1 = tt.expand_dims %0 {axis = 1 : i32} : (tensor<16xi32, #triton_gpu.slice<{dim = 1, parent = #mfma}>>) -> tensor<16x1xi32, #mfma>
+    %2 = arith.muli %1, %c16 : tensor<16x1xi32, #mfma>
+    %3 = tt.make_range {end = 16 : i32, start = 0 : i32} : tensor<16xi32, #triton_gpu.slice<{dim = 0, parent = #mfma}>>
+    %4 = tt.expand_dims %3 {axis = 0 : i32} : (tensor<16xi32, #triton_gpu.slice<{dim = 0, parent = #mfma}>>) -> tensor<1x16xi32, #mfma>
+    %5 = tt.broadcast %2 : (tensor<16x1xi32, #mfma>) -> tensor<16x16xi32, #mfma>
+    %6 = tt.broadcast %4 : (tensor<1x16xi32, #mfma>) -> tensor<16x16xi32, #mfma>
+    %7 = arith.addi %5, %6 : tensor<16x16xi32, #mfma>
+    %8 = tt.splat %arg0 : (!tt.ptr<f32>) -> tensor<16x16x!tt.ptr<f32>, #mfma>
+    %9 = tt.addptr %8, %7 : tensor<16x16x!tt.ptr<f32>, #mfma>, tensor<16x16xi32, #mfma>
+    // CHECK-COUNT-4: llvm.call @llvm.amdgcn.ds.bpermute
+    // CHECK-NOT: llvm.amdgcn.ds.bpermute
+    // CHECK: llvm.store {{.*}}alignment = 16{{.*}} : !llvm.ptr<i128, 1>
+    // CHECK-NOT: llvm.store
+    tt.store %9, %arg1 : tensor<16x16xf32, #mfma>
+    tt.return
+  }
+}
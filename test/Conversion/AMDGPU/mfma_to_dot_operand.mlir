@@ -0,0 +1,73 @@
+// RUN: triton-opt %s -split-input-file --convert-triton-gpu-to-llvm=target=rocdl | FileCheck %s
+
+// A transposed 32x32 accumulator already holds operand A of a chained dot in
+// the lanes that need it: the conversion only regroups registers.
+
+#mfma = #triton_gpu.mfma<{nonKDim = 32, warpsPerCTA = [1, 1], isTransposed = true, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx = 0, parent = #mfma, kWidth = 4}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: mfma_32_to_dot_a
+  tt.func @mfma_32_to_dot_a(%arg0: tensor<32x32xf16, #mfma>) {
+    // CHECK-NOT: llvm.amdgcn.ds.bpermute
+    // CHECK-NOT: barrier
+    %0 = triton_gpu.convert_layout %arg0 : (tensor<32x32xf16, #mfma>) -> tensor<32x32xf16, #dot_operand_a>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
+
+// -----
+
+// Non-transposed accumulators hold operand B the same way.
+
+#mfma = #triton_gpu.mfma<{nonKDim = 16, warpsPerCTA = [1, 1], isTransposed = false, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_b = #triton_gpu.dot_op<{opIdx = 1, parent = #mfma, kWidth = 4}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: mfma_16_to_dot_b
+  tt.func @mfma_16_to_dot_b(%arg0: tensor<32x64xf16, #mfma>) {
+    // CHECK-NOT: llvm.amdgcn.ds.bpermute
+    // CHECK-NOT: barrier
+    %0 = triton_gpu.convert_layout %arg0 : (tensor<32x64xf16, #mfma>) -> tensor<32x64xf16, #dot_operand_b>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
+
+// -----
+
+// fp8 operands take 8 elements along K per lane, twice the 4 consecutive
+// elements of the accumulator: half of each operand element comes from
+// another lane group, with one dword ds_bpermute per 4 elements.
+
+#mfma = #triton_gpu.mfma<{nonKDim = 16, warpsPerCTA = [1, 1], isTransposed = true, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx = 0, parent = #mfma, kWidth = 8}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: mfma_16_fp8_to_dot_a
+  tt.func @mfma_16_fp8_to_dot_a(%arg0: tensor<32x32xf8E4M3FNUZ, #mfma>) {
+    // CHECK-COUNT-8: llvm.call @llvm.amdgcn.ds.bpermute
+    // CHECK-NOT: llvm.amdgcn.ds.bpermute
+    // CHECK-NOT: barrier
+    %0 = triton_gpu.convert_layout %arg0 : (tensor<32x32xf8E4M3FNUZ, #mfma>) -> tensor<32x32xf8E4M3FNUZ, #dot_operand_a>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
+
+// -----
+
+// Waves along N of a 2D grid hold copies of the same 32 columns, so they
+// still have the whole K extent of their rows.
+
+#mfma = #triton_gpu.mfma<{nonKDim = 32, warpsPerCTA = [2, 2], isTransposed = true, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx = 0, parent = #mfma, kWidth = 8}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: mfma_2d_warps_to_dot_a
+  tt.func @mfma_2d_warps_to_dot_a(%arg0: tensor<64x32xf16, #mfma>) {
+    // CHECK-COUNT-8: llvm.call @llvm.amdgcn.ds.bpermute
+    // CHECK-NOT: llvm.amdgcn.ds.bpermute
+    // CHECK-NOT: barrier
+    %0 = triton_gpu.convert_layout %arg0 : (tensor<64x32xf16, #mfma>) -> tensor<64x32xf16, #dot_operand_a>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
@@ -0,0 +1,36 @@
+// RUN: triton-opt %s -split-input-file --convert-triton-gpu-to-llvm=target=rocdl | FileCheck %s
+
+// fp32 operands with 2 elements along K per lane are multiplied with the
+// xf32 instructions, one per pair of elements.
+
+#mfma = #triton_gpu.mfma<{nonKDim = 32, warpsPerCTA = [1, 1], isTransposed = false, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx = 0, parent = #mfma, kWidth = 2}>
+#dot_operand_b = #triton_gpu.dot_op<{opIdx = 1, parent = #mfma, kWidth = 2}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: mfma_32_xf32
+  tt.func @mfma_32_xf32(%a: tensor<32x16xf32, #dot_operand_a>, %b: tensor<16x32xf32, #dot_operand_b>) {
+    %cst = arith.constant dense<0.000000e+00> : tensor<32x32xf32, #mfma>
+    // CHECK-COUNT-4: rocdl.mfma.f32.32x32x4.xf32 {{.*}}vector<2xf32>
+    // CHECK-NOT: rocdl.mfma
+    %d = tt.dot %a, %b, %cst {allowTF32 = true} : tensor<32x16xf32, #dot_operand_a> * tensor<16x32xf32, #dot_operand_b> -> tensor<32x32xf32, #mfma>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
+
+// -----
+
+#mfma = #triton_gpu.mfma<{nonKDim = 16, warpsPerCTA = [1, 1], isTransposed = false, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx = 0, parent = #mfma, kWidth = 2}>
+#dot_operand_b = #triton_gpu.dot_op<{opIdx = 1, parent = #mfma, kWidth = 2}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: mfma_16_xf32
+  tt.func @mfma_16_xf32(%a: tensor<16x16xf32, #dot_operand_a>, %b: tensor<16x16xf32, #dot_operand_b>) {
+    %cst = arith.constant dense<0.000000e+00> : tensor<16x16xf32, #mfma>
+    // CHECK-COUNT-2: rocdl.mfma.f32.16x16x8.xf32 {{.*}}vector<2xf32>
+    // CHECK-NOT: rocdl.mfma
+    %d = tt.dot %a, %b, %cst {allowTF32 = true} : tensor<16x16xf32, #dot_operand_a> * tensor<16x16xf32, #dot_operand_b> -> tensor<16x16xf32, #mfma>
+    // CHECK: llvm.return
+    tt.return
+  }
+}
@@ -0,0 +1,31 @@
+// RUN: triton-opt %s -tritongpu-pipeline="num-stages=3 compute-capability=0" -canonicalize -convert-triton-gpu-to-llvm="target=rocdl matrix-core-version=2" | FileCheck %s
+
+// End to end from TTGIR: the async copy pipeliner stages the B operand in an
+// unswizzled buffer (K is its outer dimension), so the copies it emits are
+// lowered to direct global to LDS loads. Each lane copies 8 dwords per
+// stage, and the waits leave the last stage in flight.
+
+#AL = #triton_gpu.blocked<{sizePerThread = [1, 1], threadsPerWarp = [1, 64], warpsPerCTA = [4, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#mfma = #triton_gpu.mfma<{nonKDim = 32, warpsPerCTA = [2, 2], isTransposed = false, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_a = #triton_gpu.dot_op<{opIdx = 0, parent = #mfma, kWidth = 1}>
+#dot_b = #triton_gpu.dot_op<{opIdx = 1, parent = #mfma, kWidth = 1}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: pipelined_dot
+  // CHECK-COUNT-16: llvm.call @llvm.amdgcn.global.load.lds
+  // CHECK: s_waitcnt vmcnt(8)
+  // CHECK: llvm.call @llvm.amdgcn.global.load.lds
+  tt.func @pipelined_dot(%lb : index, %ub : index, %step : index,
+                         %a : tensor<64x32xf32, #dot_a>,
+                         %b_ptr_init : tensor<32x64x!tt.ptr<f32>, #AL>) -> tensor<64x64xf32, #mfma> {
+    %off = arith.constant dense<2048> : tensor<32x64xi32, #AL>
+    %acc_init = arith.constant dense<0.000000e+00> : tensor<64x64xf32, #mfma>
+    %loop:2 = scf.for %iv = %lb to %ub step %step iter_args(%b_ptr = %b_ptr_init, %acc = %acc_init) -> (tensor<32x64x!tt.ptr<f32>, #AL>, tensor<64x64xf32, #mfma>) {
+      %b = tt.load %b_ptr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<32x64xf32, #AL>
+      %b_dot = triton_gpu.convert_layout %b : (tensor<32x64xf32, #AL>) -> tensor<32x64xf32, #dot_b>
+      %d = tt.dot %a, %b_dot, %acc {allowTF32 = false} : tensor<64x32xf32, #dot_a> * tensor<32x64xf32, #dot_b> -> tensor<64x64xf32, #mfma>
+      %next_b_ptr = tt.addptr %b_ptr, %off : tensor<32x64x!tt.ptr<f32>, #AL>, tensor<32x64xi32, #AL>
+      scf.yield %next_b_ptr, %d : tensor<32x64x!tt.ptr<f32>, #AL>, tensor<64x64xf32, #mfma>
+    }
+    tt.return %loop#1 : tensor<64x64xf32, #mfma>
+  }
+}
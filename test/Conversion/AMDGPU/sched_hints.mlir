@@ -0,0 +1,36 @@
+// RUN: triton-opt %s -split-input-file --convert-triton-gpu-to-llvm="target=rocdl sched-variant=interleave-lds" | FileCheck %s
+// RUN: triton-opt %s -split-input-file --convert-triton-gpu-to-llvm=target=rocdl | FileCheck %s --check-prefix=NONE
+
+// The 20 LDS reads feeding the dot are spread evenly over its 4 MFMAs.
+
+#blocked0 = #triton_gpu.blocked<{sizePerThread = [1, 4], threadsPerWarp = [16, 4], warpsPerCTA = [1, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#shared0 = #triton_gpu.shared<{vec = 1, perPhase=1, maxPhase=1, order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#mfma0 = #triton_gpu.mfma<{nonKDim = 32, warpsPerCTA=[1,1], isTranspose=false, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx=0, parent=#mfma0, kWidth = 4}>
+#dot_operand_b = #triton_gpu.dot_op<{opIdx=1, parent=#mfma0, kWidth = 4}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 1 : i32} {
+  // CHECK-LABEL: interleave_mfma_ds_read
+  // NONE-LABEL: interleave_mfma_ds_read
+  tt.func @interleave_mfma_ds_read(%A: tensor<32x32xf16, #blocked0>, %B: tensor<32x32xf16, #blocked0>) {
+    %AA = triton_gpu.convert_layout %A : (tensor<32x32xf16, #blocked0>) -> tensor<32x32xf16, #shared0>
+    %BB = triton_gpu.convert_layout %B : (tensor<32x32xf16, #blocked0>) -> tensor<32x32xf16, #shared0>
+    %AA_DOT = triton_gpu.convert_layout %AA : (tensor<32x32xf16, #shared0>) -> tensor<32x32xf16, #dot_operand_a>
+    %BB_DOT = triton_gpu.convert_layout %BB : (tensor<32x32xf16, #shared0>) -> tensor<32x32xf16, #dot_operand_b>
+    %cst0 = arith.constant dense<0.000000e+00> : tensor<32x32xf32, #mfma0>
+    // CHECK-COUNT-4: rocdl.mfma.f32.32x32x8f16
+    // CHECK: llvm.mlir.constant(8 : i32) : i32
+    // CHECK-NEXT: llvm.mlir.constant(1 : i32) : i32
+    // CHECK-NEXT: llvm.mlir.constant(0 : i32) : i32
+    // CHECK-NEXT: llvm.call @llvm.amdgcn.sched.group.barrier
+    // CHECK-NEXT: llvm.mlir.constant(256 : i32) : i32
+    // CHECK-NEXT: llvm.mlir.constant(5 : i32) : i32
+    // CHECK-NEXT: llvm.mlir.constant(0 : i32) : i32
+    // CHECK-NEXT: llvm.call @llvm.amdgcn.sched.group.barrier
+    // CHECK-COUNT-6: llvm.call @llvm.amdgcn.sched.group.barrier
+    // CHECK-NOT: llvm.call @llvm.amdgcn.sched.group.barrier
+    // CHECK: llvm.return
+    // NONE-NOT: llvm.amdgcn.sched.group.barrier
+    %D = tt.dot %AA_DOT, %BB_DOT, %cst0 {allowTF32 = true, transA = false, transB = false} : tensor<32x32xf16, #dot_operand_a> * tensor<32x32xf16, #dot_operand_b> -> tensor<32x32xf32, #mfma0>
+    tt.return
+  }
+}
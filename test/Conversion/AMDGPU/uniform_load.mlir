@@ -0,0 +1,74 @@
+// RUN: triton-opt %s -split-input-file --convert-triton-gpu-to-llvm=target=rocdl | FileCheck %s
+
+// Every element reads the same address: the pointer is made wave-uniform with
+// readfirstlane (twice, one per dword) and a single element is loaded and
+// shared by the 4 elements of each thread.
+
+#blocked = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [64], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: uniform_load
+  tt.func public @uniform_load(%arg0: !tt.ptr<f32> {tt.divisibility = 16 : i32}, %arg1: !tt.ptr<f32> {tt.divisibility = 16 : i32}) {
+    %0 = tt.get_program_id x : i32
+    %1 = tt.addptr %arg0, %0 : !tt.ptr<f32>, i32
+    %2 = tt.splat %1 : (!tt.ptr<f32>) -> tensor<1024x!tt.ptr<f32>, #blocked>
+    // CHECK-COUNT-2: llvm.call @llvm.amdgcn.readfirstlane
+    // CHECK-NOT: llvm.call @llvm.amdgcn.readfirstlane
+    // CHECK: llvm.load {{.*}} : !llvm.ptr<i32>
+    // CHECK-NOT: llvm.load
+    // CHECK: llvm.bitcast {{.*}} : i32 to f32
+    %3 = tt.load %2 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<1024xf32, #blocked>
+    %4 = tt.make_range {end = 1024 : i32, start = 0 : i32} : tensor<1024xi32, #blocked>
+    %5 = tt.splat %arg1 : (!tt.ptr<f32>) -> tensor<1024x!tt.ptr<f32>, #blocked>
+    %6 = tt.addptr %5, %4 : tensor<1024x!tt.ptr<f32>, #blocked>, tensor<1024xi32, #blocked>
+    tt.store %6, %3 : tensor<1024xf32, #blocked>
+    tt.return
+  }
+}
+
+// -----
+
+// A uniform mask and `other` value are broadcast with readfirstlane as well
+// and guard the single load.
+
+#blocked = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [64], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: uniform_masked_load
+  tt.func public @uniform_masked_load(%arg0: !tt.ptr<f32> {tt.divisibility = 16 : i32}, %arg1: !tt.ptr<f32> {tt.divisibility = 16 : i32}, %arg2: i32) {
+    %cst = arith.constant dense<1.000000e+00> : tensor<1024xf32, #blocked>
+    %0 = tt.get_program_id x : i32
+    %1 = arith.cmpi slt, %0, %arg2 : i32
+    %2 = tt.splat %1 : (i1) -> tensor<1024xi1, #blocked>
+    %3 = tt.splat %arg0 : (!tt.ptr<f32>) -> tensor<1024x!tt.ptr<f32>, #blocked>
+    // CHECK-COUNT-4: llvm.call @llvm.amdgcn.readfirstlane
+    // CHECK-NOT: llvm.call @llvm.amdgcn.readfirstlane
+    // CHECK: llvm.load {{.*}} : !llvm.ptr<i32>
+    // CHECK-NOT: llvm.load
+    %4 = tt.load %3, %2, %cst {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<1024xf32, #blocked>
+    %5 = tt.make_range {end = 1024 : i32, start = 0 : i32} : tensor<1024xi32, #blocked>
+    %6 = tt.splat %arg1 : (!tt.ptr<f32>) -> tensor<1024x!tt.ptr<f32>, #blocked>
+    %7 = tt.addptr %6, %5 : tensor<1024x!tt.ptr<f32>, #blocked>, tensor<1024xi32, #blocked>
+    tt.store %7, %4 : tensor<1024xf32, #blocked>
+    tt.return
+  }
+}
+
+// -----
+
+// Addresses that differ per element keep the vector load path.
+
+#blocked = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [64], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: non_uniform_load
+  tt.func public @non_uniform_load(%arg0: !tt.ptr<f32> {tt.divisibility = 16 : i32}, %arg1: !tt.ptr<f32> {tt.divisibility = 16 : i32}) {
+    %0 = tt.make_range {end = 1024 : i32, start = 0 : i32} : tensor<1024xi32, #blocked>
+    %1 = tt.splat %arg0 : (!tt.ptr<f32>) -> tensor<1024x!tt.ptr<f32>, #blocked>
+    %2 = tt.addptr %1, %0 : tensor<1024x!tt.ptr<f32>, #blocked>, tensor<1024xi32, #blocked>
+    // CHECK-NOT: llvm.amdgcn.readfirstlane
+    // CHECK: llvm.load {{.*}}alignment = 16{{.*}} : !llvm.ptr<i128>
+    %3 = tt.load %2 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<1024xf32, #blocked>
+    %4 = tt.splat %arg1 : (!tt.ptr<f32>) -> tensor<1024x!tt.ptr<f32>, #blocked>
+    %5 = tt.addptr %4, %0 : tensor<1024x!tt.ptr<f32>, #blocked>, tensor<1024xi32, #blocked>
+    tt.store %5, %3 : tensor<1024xf32, #blocked>
+    tt.return
+  }
+}
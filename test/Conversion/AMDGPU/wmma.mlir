@@ -0,0 +1,47 @@
+// RUN: triton-opt %s -split-input-file --convert-triton-gpu-to-llvm="target=rocdl matrix-core-version=4" | FileCheck %s
+
+// Each wave computes one 16x16 tile of the result, in two steps along K. In
+// wave32 a lane holds 8 elements of the tile.
+
+#shared0 = #triton_gpu.shared<{vec = 1, perPhase = 1, maxPhase = 1, order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#shared1 = #triton_gpu.shared<{vec = 1, perPhase = 1, maxPhase = 1, order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#wmma = #triton_gpu.wmma<{warpSize = 32, warpsPerCTA = [2, 2], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx = 0, parent = #wmma, kWidth = 16}>
+#dot_operand_b = #triton_gpu.dot_op<{opIdx = 1, parent = #wmma, kWidth = 16}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 32 : i32} {
+  // CHECK-LABEL: wmma_dot_f16
+  tt.func @wmma_dot_f16(%a: tensor<32x32xf16, #shared0>, %b: tensor<32x32xf16, #shared1>) {
+    %cst = arith.constant dense<0.000000e+00> : tensor<32x32xf32, #wmma>
+    // A is contiguous along K: one 16-element load per tile
+    // CHECK-COUNT-2: llvm.load {{.*}}vector<16xf16>
+    %a_op = triton_gpu.convert_layout %a : (tensor<32x32xf16, #shared0>) -> tensor<32x32xf16, #dot_operand_a>
+    %b_op = triton_gpu.convert_layout %b : (tensor<32x32xf16, #shared1>) -> tensor<32x32xf16, #dot_operand_b>
+    // CHECK-COUNT-2: llvm.call @llvm.amdgcn.wmma.f32.16x16x16.f16.v8f32(
+    // CHECK-NOT: llvm.call @llvm.amdgcn.wmma
+    %d = tt.dot %a_op, %b_op, %cst {allowTF32 = false} : tensor<32x32xf16, #dot_operand_a> * tensor<32x32xf16, #dot_operand_b> -> tensor<32x32xf32, #wmma>
+    tt.return
+  }
+}
+
+// -----
+
+// In wave64 the two halves of the wave hold the same operands and a lane holds
+// 4 elements of the result tile. The int8 operands are packed in dwords.
+
+#shared0 = #triton_gpu.shared<{vec = 1, perPhase = 1, maxPhase = 1, order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#shared1 = #triton_gpu.shared<{vec = 1, perPhase = 1, maxPhase = 1, order = [0, 1], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [0, 1]}>
+#wmma = #triton_gpu.wmma<{warpSize = 64, warpsPerCTA = [2, 2], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx = 0, parent = #wmma, kWidth = 16}>
+#dot_operand_b = #triton_gpu.dot_op<{opIdx = 1, parent = #wmma, kWidth = 16}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: wmma_dot_i8
+  tt.func @wmma_dot_i8(%a: tensor<32x16xi8, #shared0>, %b: tensor<16x32xi8, #shared1>) {
+    %cst = arith.constant dense<0> : tensor<32x32xi32, #wmma>
+    %a_op = triton_gpu.convert_layout %a : (tensor<32x16xi8, #shared0>) -> tensor<32x16xi8, #dot_operand_a>
+    %b_op = triton_gpu.convert_layout %b : (tensor<16x32xi8, #shared1>) -> tensor<16x32xi8, #dot_operand_b>
+    // CHECK: llvm.call @llvm.amdgcn.wmma.i32.16x16x16.iu8.v4i32(
+    // CHECK-NOT: llvm.call @llvm.amdgcn.wmma
+    %d = tt.dot %a_op, %b_op, %cst {allowTF32 = false} : tensor<32x16xi8, #dot_operand_a> * tensor<16x32xi8, #dot_operand_b> -> tensor<32x32xi32, #wmma>
+    tt.return
+  }
+}
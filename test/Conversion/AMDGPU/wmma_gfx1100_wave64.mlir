@@ -0,0 +1,46 @@
+// RUN: triton-translate %s -target=amdgcn -gfx=gfx1100 -amdgcn=amdgcn-amd-amdhsa -features=+wavefrontsize64 | FileCheck %s
+// RUN: triton-translate %s -target=llvmir | FileCheck %s --check-prefix=LLVM
+
+// Compiles a WMMA dot down to gfx1100 ISA in wave64. Each wave computes one
+// 16x16 tile of the result, in two steps along K.
+
+#blocked = #triton_gpu.blocked<{sizePerThread = [1, 8], threadsPerWarp = [8, 8], warpsPerCTA = [4, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#shared = #triton_gpu.shared<{vec = 8, perPhase = 1, maxPhase = 4, order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#wmma = #triton_gpu.wmma<{warpSize = 64, warpsPerCTA = [2, 2], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot_operand_a = #triton_gpu.dot_op<{opIdx = 0, parent = #wmma, kWidth = 16}>
+#dot_operand_b = #triton_gpu.dot_op<{opIdx = 1, parent = #wmma, kWidth = 16}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: wmma_kernel:
+  // CHECK-COUNT-2: v_wmma_f32_16x16x16_f16
+  // CHECK-NOT: v_wmma
+  // CHECK: .amdhsa_wavefront_size32 0
+  // LLVM-COUNT-2: call <4 x float> @llvm.amdgcn.wmma.f32.16x16x16.f16.v4f32(<16 x half>
+  tt.func public @wmma_kernel(%pa: !tt.ptr<f16, 1> {tt.divisibility = 16 : i32}, %pb: !tt.ptr<f16, 1> {tt.divisibility = 16 : i32}, %pc: !tt.ptr<f32, 1> {tt.divisibility = 16 : i32}) {
+    %cst = arith.constant dense<0.000000e+00> : tensor<32x32xf32, #wmma>
+    %stride = arith.constant dense<32> : tensor<32x1xi32, #blocked>
+    %rm = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32, #triton_gpu.slice<{dim = 1, parent = #blocked}>>
+    %rn = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32, #triton_gpu.slice<{dim = 0, parent = #blocked}>>
+    %m = tt.expand_dims %rm {axis = 1 : i32} : (tensor<32xi32, #triton_gpu.slice<{dim = 1, parent = #blocked}>>) -> tensor<32x1xi32, #blocked>
+    %n = tt.expand_dims %rn {axis = 0 : i32} : (tensor<32xi32, #triton_gpu.slice<{dim = 0, parent = #blocked}>>) -> tensor<1x32xi32, #blocked>
+    %ms = arith.muli %m, %stride : tensor<32x1xi32, #blocked>
+    %mb = tt.broadcast %ms : (tensor<32x1xi32, #blocked>) -> tensor<32x32xi32, #blocked>
+    %nb = tt.broadcast %n : (tensor<1x32xi32, #blocked>) -> tensor<32x32xi32, #blocked>
+    %off = arith.addi %mb, %nb : tensor<32x32xi32, #blocked>
+    %pa0 = tt.splat %pa : (!tt.ptr<f16, 1>) -> tensor<32x32x!tt.ptr<f16, 1>, #blocked>
+    %pa1 = tt.addptr %pa0, %off : tensor<32x32x!tt.ptr<f16, 1>, #blocked>, tensor<32x32xi32, #blocked>
+    %pb0 = tt.splat %pb : (!tt.ptr<f16, 1>) -> tensor<32x32x!tt.ptr<f16, 1>, #blocked>
+    %pb1 = tt.addptr %pb0, %off : tensor<32x32x!tt.ptr<f16, 1>, #blocked>, tensor<32x32xi32, #blocked>
+    %pc0 = tt.splat %pc : (!tt.ptr<f32, 1>) -> tensor<32x32x!tt.ptr<f32, 1>, #blocked>
+    %pc1 = tt.addptr %pc0, %off : tensor<32x32x!tt.ptr<f32, 1>, #blocked>, tensor<32x32xi32, #blocked>
+    %a = tt.load %pa1 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<32x32xf16, #blocked>
+    %b = tt.load %pb1 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<32x32xf16, #blocked>
+    %as = triton_gpu.convert_layout %a : (tensor<32x32xf16, #blocked>) -> tensor<32x32xf16, #shared>
+    %bs = triton_gpu.convert_layout %b : (tensor<32x32xf16, #blocked>) -> tensor<32x32xf16, #shared>
+    %a_op = triton_gpu.convert_layout %as : (tensor<32x32xf16, #shared>) -> tensor<32x32xf16, #dot_operand_a>
+    %b_op = triton_gpu.convert_layout %bs : (tensor<32x32xf16, #shared>) -> tensor<32x32xf16, #dot_operand_b>
+    %d = tt.dot %a_op, %b_op, %cst {allowTF32 = false} : tensor<32x32xf16, #dot_operand_a> * tensor<32x32xf16, #dot_operand_b> -> tensor<32x32xf32, #wmma>
+    %c = triton_gpu.convert_layout %d : (tensor<32x32xf32, #wmma>) -> tensor<32x32xf32, #blocked>
+    tt.store %pc1, %c {cache = 1 : i32, evict = 1 : i32} : tensor<32x32xf32, #blocked>
+    tt.return
+  }
+}
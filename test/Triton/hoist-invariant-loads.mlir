@@ -0,0 +1,74 @@
+// RUN: triton-opt %s -split-input-file -triton-hoist-invariant-loads | FileCheck %s
+
+// The stores go through %out, which may not alias %in (marked noalias), so the
+// invariant load is hoisted and predicated on the loop being entered.
+
+// CHECK-LABEL: @hoist_noalias
+tt.func @hoist_noalias(%in: !tt.ptr<f32> {tt.noalias}, %out: !tt.ptr<f32>, %n: i32) {
+  %c0 = arith.constant 0 : i32
+  %c1 = arith.constant 1 : i32
+  %offs = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %in_splat = tt.splat %in : (!tt.ptr<f32>) -> tensor<128x!tt.ptr<f32>>
+  %in_ptrs = tt.addptr %in_splat, %offs : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %out_splat = tt.splat %out : (!tt.ptr<f32>) -> tensor<128x!tt.ptr<f32>>
+  // CHECK: %[[ENTERED:.*]] = arith.cmpi slt, %c0_i32, %arg2 : i32
+  // CHECK-NEXT: %[[MASK:.*]] = tt.splat %[[ENTERED]] : (i1) -> tensor<128xi1>
+  // CHECK-NEXT: %[[X:.*]] = tt.load %{{.*}}, %[[MASK]]
+  // CHECK-NEXT: scf.for
+  // CHECK-NOT: tt.load
+  // CHECK: tt.store %{{.*}}, %[[X]]
+  scf.for %i = %c0 to %n step %c1 : i32 {
+    %x = tt.load %in_ptrs {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128xf32>
+    %i_splat = tt.splat %i : (i32) -> tensor<128xi32>
+    %out_ptrs = tt.addptr %out_splat, %i_splat : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    tt.store %out_ptrs, %x : tensor<128xf32>
+  }
+  tt.return
+}
+
+// -----
+
+// Without noalias, %in and %out may point to the same buffer.
+
+// CHECK-LABEL: @no_hoist_may_alias
+tt.func @no_hoist_may_alias(%in: !tt.ptr<f32>, %out: !tt.ptr<f32>, %n: i32) {
+  %c0 = arith.constant 0 : i32
+  %c1 = arith.constant 1 : i32
+  %offs = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %in_splat = tt.splat %in : (!tt.ptr<f32>) -> tensor<128x!tt.ptr<f32>>
+  %in_ptrs = tt.addptr %in_splat, %offs : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %out_splat = tt.splat %out : (!tt.ptr<f32>) -> tensor<128x!tt.ptr<f32>>
+  // CHECK: scf.for
+  // CHECK-NEXT: tt.load
+  scf.for %i = %c0 to %n step %c1 : i32 {
+    %x = tt.load %in_ptrs {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128xf32>
+    %i_splat = tt.splat %i : (i32) -> tensor<128xi32>
+    %out_ptrs = tt.addptr %out_splat, %i_splat : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    tt.store %out_ptrs, %x : tensor<128xf32>
+  }
+  tt.return
+}
+
+// -----
+
+// The loop is known to run, so the existing mask is kept as is.
+
+// CHECK-LABEL: @hoist_constant_bounds
+tt.func @hoist_constant_bounds(%in: !tt.ptr<f32> {tt.noalias}, %out: !tt.ptr<f32>, %mask: tensor<128xi1>) {
+  %c0 = arith.constant 0 : i32
+  %c1 = arith.constant 1 : i32
+  %c8 = arith.constant 8 : i32
+  %offs = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %in_splat = tt.splat %in : (!tt.ptr<f32>) -> tensor<128x!tt.ptr<f32>>
+  %in_ptrs = tt.addptr %in_splat, %offs : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %out_splat = tt.splat %out : (!tt.ptr<f32>) -> tensor<128x!tt.ptr<f32>>
+  // CHECK: %[[X:.*]] = tt.load %{{.*}}, %arg2 {
+  // CHECK-NEXT: scf.for
+  scf.for %i = %c0 to %c8 step %c1 : i32 {
+    %x = tt.load %in_ptrs, %mask {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128xf32>
+    %i_splat = tt.splat %i : (i32) -> tensor<128xi32>
+    %out_ptrs = tt.addptr %out_splat, %i_splat : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    tt.store %out_ptrs, %x : tensor<128xf32>
+  }
+  tt.return
+}
@@ -0,0 +1,157 @@
+// RUN: triton-opt %s -split-input-file -triton-narrow-indices | FileCheck %s
+
+// i * 256 + [0, 256) with i <= 1024 (known from the loop bounds) fits in 32
+// bits, so the offset is computed in 32 bits.
+
+// CHECK-LABEL: @range_proven
+tt.func @range_proven(%ptr: !tt.ptr<f32>) {
+  %c0 = arith.constant 0 : i32
+  %c1 = arith.constant 1 : i32
+  %c1024 = arith.constant 1024 : i32
+  %c256_i64 = arith.constant 256 : i64
+  %range = tt.make_range {end = 256 : i32, start = 0 : i32} : tensor<256xi32>
+  %ptrs = tt.splat %ptr : (!tt.ptr<f32>) -> tensor<256x!tt.ptr<f32>>
+  // CHECK: scf.for %[[I:.*]] =
+  scf.for %i = %c0 to %c1024 step %c1 : i32 {
+    // CHECK-NEXT: %[[BASE:.*]] = arith.muli %[[I]], %c256_i32 : i32
+    // CHECK-NEXT: %[[SPLAT:.*]] = tt.splat %[[BASE]] : (i32) -> tensor<256xi32>
+    // CHECK-NEXT: %[[OFFS:.*]] = arith.addi %[[SPLAT]], %{{.*}} : tensor<256xi32>
+    // CHECK-NEXT: tt.addptr %{{.*}}, %[[OFFS]] : tensor<256x!tt.ptr<f32>>, tensor<256xi32>
+    %i64 = arith.extsi %i : i32 to i64
+    %base = arith.muli %i64, %c256_i64 : i64
+    %base_splat = tt.splat %base : (i64) -> tensor<256xi64>
+    %range64 = arith.extsi %range : tensor<256xi32> to tensor<256xi64>
+    %offs = arith.addi %base_splat, %range64 : tensor<256xi64>
+    %addrs = tt.addptr %ptrs, %offs : tensor<256x!tt.ptr<f32>>, tensor<256xi64>
+    %x = tt.load %addrs {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<256xf32>
+    tt.store %addrs, %x : tensor<256xf32>
+  }
+  tt.return
+}
+
+// -----
+
+// The buffer behind %ptr is smaller than 2^31 bytes, so the offset computed
+// from the 64-bit stride is computed modulo 2^32.
+
+// CHECK-LABEL: @pointer_range_hint
+tt.func @pointer_range_hint(%ptr: !tt.ptr<f16> {tt.pointer_range = 32 : i32}, %stride: i64) {
+  %pid = tt.get_program_id x : i32
+  %range = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  // CHECK: %[[STRIDE:.*]] = arith.trunci %arg1 : i64 to i32
+  // CHECK: %[[ROW:.*]] = arith.muli %{{.*}}, %[[STRIDE]] : i32
+  // CHECK: tt.splat %[[ROW]] : (i32) -> tensor<128xi32>
+  // CHECK-NOT: i64
+  // CHECK: tt.addptr %{{.*}}, %{{.*}} : tensor<128x!tt.ptr<f16>>, tensor<128xi32>
+  %pid64 = arith.extsi %pid : i32 to i64
+  %row = arith.muli %pid64, %stride : i64
+  %row_splat = tt.splat %row : (i64) -> tensor<128xi64>
+  %range64 = arith.extsi %range : tensor<128xi32> to tensor<128xi64>
+  %offs = arith.addi %row_splat, %range64 : tensor<128xi64>
+  %ptrs = tt.splat %ptr : (!tt.ptr<f16>) -> tensor<128x!tt.ptr<f16>>
+  %addrs = tt.addptr %ptrs, %offs : tensor<128x!tt.ptr<f16>>, tensor<128xi64>
+  %x = tt.load %addrs {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128xf16>
+  tt.store %addrs, %x : tensor<128xf16>
+  tt.return
+}
+
+// -----
+
+// Without the hint, pid * stride may not fit in 32 bits.
+
+// CHECK-LABEL: @no_narrow
+tt.func @no_narrow(%ptr: !tt.ptr<f16>, %stride: i64) {
+  %pid = tt.get_program_id x : i32
+  // CHECK-NOT: arith.trunci
+  // CHECK: tt.addptr %{{.*}}, %{{.*}} : !tt.ptr<f16>, i64
+  %pid64 = arith.extsi %pid : i32 to i64
+  %row = arith.muli %pid64, %stride : i64
+  %addr = tt.addptr %ptr, %row : !tt.ptr<f16>, i64
+  %x = tt.load %addr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : f16
+  tt.store %addr, %x : f16
+  tt.return
+}
+
+// -----
+
+// Each offset fits in 32 bits on its own, but their sum along the chain may
+// not: only the first one is narrowed.
+
+// CHECK-LABEL: @chain_overflow
+tt.func @chain_overflow(%ptr: !tt.ptr<f16>) {
+  %pid = tt.get_program_id x : i32
+  %pid64 = arith.extsi %pid : i32 to i64
+  // CHECK: %[[P1:.*]] = tt.addptr %arg0, %{{.*}} : !tt.ptr<f16>, i32
+  // CHECK: tt.addptr %[[P1]], %{{.*}} : !tt.ptr<f16>, i64
+  %p1 = tt.addptr %ptr, %pid64 : !tt.ptr<f16>, i64
+  %p2 = tt.addptr %p1, %pid64 : !tt.ptr<f16>, i64
+  %x = tt.load %p2 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : f16
+  tt.store %p2, %x : f16
+  tt.return
+}
+
+// -----
+
+// The hint bounds the offsets of the accessed pointers from the argument, not
+// the offsets of the individual tt.addptr of a chain.
+
+// CHECK-LABEL: @pointer_range_hint_chain
+tt.func @pointer_range_hint_chain(%ptr: !tt.ptr<f16> {tt.pointer_range = 32 : i32}, %stride: i64) {
+  %pid = tt.get_program_id x : i32
+  // CHECK-NOT: arith.trunci
+  // CHECK: %[[P1:.*]] = tt.addptr %arg0, %{{.*}} : !tt.ptr<f16>, i64
+  // CHECK: tt.addptr %[[P1]], %{{.*}} : !tt.ptr<f16>, i64
+  %pid64 = arith.extsi %pid : i32 to i64
+  %row = arith.muli %pid64, %stride : i64
+  %p1 = tt.addptr %ptr, %row : !tt.ptr<f16>, i64
+  %p2 = tt.addptr %p1, %stride : !tt.ptr<f16>, i64
+  %x = tt.load %p2 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : f16
+  tt.store %p2, %x : f16
+  tt.return
+}
+
+// -----
+
+// The divisor may be 0, so nothing is known about the remainder and the offset
+// stays in 64 bits.
+
+// CHECK-LABEL: @remsi_divisor_may_be_zero
+tt.func @remsi_divisor_may_be_zero(%ptr: !tt.ptr<f16>, %x: i64) {
+  %c0 = arith.constant 0 : i32
+  %c1 = arith.constant 1 : i32
+  %c1024 = arith.constant 1024 : i32
+  // CHECK-NOT: arith.trunci
+  // CHECK: tt.addptr %{{.*}}, %{{.*}} : !tt.ptr<f16>, i64
+  scf.for %i = %c0 to %c1024 step %c1 : i32 {
+    %d = arith.extsi %i : i32 to i64
+    %r = arith.remsi %x, %d : i64
+    %addr = tt.addptr %ptr, %r : !tt.ptr<f16>, i64
+    %v = tt.load %addr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : f16
+    tt.store %addr, %v : f16
+  }
+  tt.return
+}
+
+// -----
+
+// With a positive divisor of at most 1025, the remainder fits in 32 bits.
+
+// CHECK-LABEL: @remsi_positive_divisor
+tt.func @remsi_positive_divisor(%ptr: !tt.ptr<f16>, %x: i64) {
+  %c0 = arith.constant 0 : i32
+  %c1 = arith.constant 1 : i32
+  %c1024 = arith.constant 1024 : i32
+  %c1_i64 = arith.constant 1 : i64
+  // CHECK: %[[R:.*]] = arith.remsi %{{.*}}, %{{.*}} : i64
+  // CHECK: %[[R32:.*]] = arith.trunci %[[R]] : i64 to i32
+  // CHECK: tt.addptr %{{.*}}, %[[R32]] : !tt.ptr<f16>, i32
+  scf.for %i = %c0 to %c1024 step %c1 : i32 {
+    %i64 = arith.extsi %i : i32 to i64
+    %d = arith.addi %i64, %c1_i64 : i64
+    %r = arith.remsi %x, %d : i64
+    %addr = tt.addptr %ptr, %r : !tt.ptr<f16>, i64
+    %v = tt.load %addr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : f16
+    tt.store %addr, %v : f16
+  }
+  tt.return
+}
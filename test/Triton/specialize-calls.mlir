@@ -0,0 +1,60 @@
+// RUN: triton-opt %s -split-input-file -triton-specialize-calls | FileCheck %s
+
+module {
+
+// CHECK-LABEL: tt.func @kernel
+// CHECK: tt.call @load_helper(%arg0)
+// CHECK-NEXT: tt.call @load_helper__spec0(%arg1)
+// CHECK-NEXT: tt.call @load_helper(%arg0)
+tt.func @kernel(%arg0: !tt.ptr<f32> {tt.divisibility = 16 : i32}, %arg1: !tt.ptr<f32>) {
+  tt.call @load_helper(%arg0) : (!tt.ptr<f32>) -> ()
+  tt.call @load_helper(%arg1) : (!tt.ptr<f32>) -> ()
+  tt.call @load_helper(%arg0) : (!tt.ptr<f32>) -> ()
+  tt.return
+}
+
+// CHECK: tt.func private @load_helper(%arg0: !tt.ptr<f32, 1> {{.*}}tt.divisibility = 16 : i64
+// CHECK: tt.func private @load_helper__spec0(%arg0: !tt.ptr<f32, 1> {{.*}}tt.divisibility = 1 : i64
+tt.func private @load_helper(%arg0: !tt.ptr<f32>) attributes {noinline = true} {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg0 : (!tt.ptr<f32>) -> tensor<128x!tt.ptr<f32>>
+  %2 = tt.addptr %1, %0 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %3 = tt.load %2 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128xf32>
+  tt.store %2, %3 : tensor<128xf32>
+  tt.return
+}
+
+}
+
+// -----
+
+module {
+
+// Specializing @outer gives @inner two distinct call sites, which are then
+// specialized as well.
+
+// CHECK-LABEL: tt.func @kernel
+// CHECK: tt.call @outer(%arg0)
+// CHECK-NEXT: tt.call @outer__spec0(%arg1)
+tt.func @kernel(%arg0: i32 {tt.divisibility = 16 : i32}, %arg1: i32) {
+  tt.call @outer(%arg0) : (i32) -> ()
+  tt.call @outer(%arg1) : (i32) -> ()
+  tt.return
+}
+
+// CHECK: tt.func private @outer(%arg0: i32 {{.*}}tt.divisibility = 16 : i64
+// CHECK-NEXT: tt.call @inner(%arg0)
+// CHECK: tt.func private @outer__spec0(%arg0: i32 {{.*}}tt.divisibility = 1 : i64
+// CHECK-NEXT: tt.call @inner__spec0(%arg0)
+tt.func private @outer(%arg0: i32) attributes {noinline = true} {
+  tt.call @inner(%arg0) : (i32) -> ()
+  tt.return
+}
+
+// CHECK: tt.func private @inner(%arg0: i32 {{.*}}tt.divisibility = 16 : i64
+// CHECK: tt.func private @inner__spec0(%arg0: i32 {{.*}}tt.divisibility = 1 : i64
+tt.func private @inner(%arg0: i32) attributes {noinline = true} {
+  tt.return
+}
+
+}
@@ -0,0 +1,78 @@
+// RUN: triton-opt %s -split-input-file -triton-strength-reduce-divrem | FileCheck %s
+
+// The magic numbers of a splatted divisor are computed once, at the start of
+// the kernel, and each element is divided with a multiply and a shift.
+
+// CHECK-LABEL: @tensor_div_rem
+tt.func @tensor_div_rem(%arg0: i32, %out: !tt.ptr<i32>) {
+  // CHECK: %[[CLZ:.*]] = math.ctlz
+  // CHECK: %[[SHIFT:.*]] = arith.extui
+  // CHECK: %[[IS_ZERO:.*]] = arith.cmpi eq
+  // CHECK: %[[SAFE:.*]] = arith.select %[[IS_ZERO]], %{{.*}}, %{{.*}} : i32
+  // CHECK: %[[SAFE64:.*]] = arith.extui %[[SAFE]] : i32 to i64
+  // CHECK: %[[MAGIC:.*]] = arith.divui %{{.*}}, %[[SAFE64]] : i64
+  // CHECK-NOT: arith.divsi
+  // CHECK-NOT: arith.remsi
+  // CHECK: %[[M:.*]] = tt.splat %[[MAGIC]] : (i64) -> tensor<128xi64>
+  // CHECK: arith.muli %{{.*}}, %[[M]] : tensor<128xi64>
+  // CHECK: %[[S:.*]] = tt.splat %[[SHIFT]] : (i64) -> tensor<128xi64>
+  // CHECK: arith.shrui %{{.*}}, %[[S]] : tensor<128xi64>
+  // CHECK-NOT: math.ctlz
+  // CHECK-NOT: arith.divui
+  %offs = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %d = tt.splat %arg0 : (i32) -> tensor<128xi32>
+  %q = arith.divsi %offs, %d : tensor<128xi32>
+  %r = arith.remsi %offs, %d : tensor<128xi32>
+  %sum = arith.addi %q, %r : tensor<128xi32>
+  %ptrs = tt.splat %out : (!tt.ptr<i32>) -> tensor<128x!tt.ptr<i32>>
+  %out_ptrs = tt.addptr %ptrs, %offs : tensor<128x!tt.ptr<i32>>, tensor<128xi32>
+  tt.store %out_ptrs, %sum : tensor<128xi32>
+  tt.return
+}
+
+// -----
+
+// Divisions by constants and by non-uniform divisors are left alone.
+
+// CHECK-LABEL: @no_rewrite
+tt.func @no_rewrite(%arg0: i32, %arg1: i32, %out: !tt.ptr<i32>) {
+  // CHECK-NOT: math.ctlz
+  // CHECK: arith.divsi %{{.*}}, %cst
+  // CHECK: arith.divsi %{{.*}}, %{{.*}} : tensor<128xi32>
+  // CHECK: arith.divsi %arg0, %arg1 : i32
+  %offs = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %cst = arith.constant dense<7> : tensor<128xi32>
+  %0 = arith.divsi %offs, %cst : tensor<128xi32>
+  %1 = arith.divsi %0, %offs : tensor<128xi32>
+  %2 = arith.divsi %arg0, %arg1 : i32
+  %3 = tt.splat %2 : (i32) -> tensor<128xi32>
+  %4 = arith.addi %1, %3 : tensor<128xi32>
+  %ptrs = tt.splat %out : (!tt.ptr<i32>) -> tensor<128x!tt.ptr<i32>>
+  %out_ptrs = tt.addptr %ptrs, %offs : tensor<128x!tt.ptr<i32>>, tensor<128xi32>
+  tt.store %out_ptrs, %4 : tensor<128xi32>
+  tt.return
+}
+
+// -----
+
+// A scalar division in a loop by a loop-invariant divisor has its magic
+// numbers computed before the loop.
+
+// CHECK-LABEL: @scalar_in_loop
+tt.func @scalar_in_loop(%arg0: i32, %n: i32) -> i32 {
+  // CHECK: arith.divui
+  // CHECK: scf.for
+  // CHECK-NOT: arith.divui
+  // CHECK-NOT: arith.divsi
+  // CHECK: arith.muli %{{.*}} : i64
+  // CHECK: arith.shrui %{{.*}} : i64
+  // CHECK: scf.yield
+  %c0 = arith.constant 0 : i32
+  %c1 = arith.constant 1 : i32
+  %res = scf.for %i = %c0 to %n step %c1 iter_args(%acc = %c0) -> (i32) : i32 {
+    %q = arith.divsi %i, %arg0 : i32
+    %next = arith.addi %acc, %q : i32
+    scf.yield %next : i32
+  }
+  tt.return %res : i32
+}
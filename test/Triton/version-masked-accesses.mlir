@@ -0,0 +1,130 @@
+// RUN: triton-opt %s -split-input-file -triton-version-masked-accesses | FileCheck %s
+
+// The mask `pid * 1024 + [0, 1024) < n` is all true unless pid * 1024 + 1023
+// >= n, so the kernel body is duplicated with the mask replaced by true.
+
+// CHECK-LABEL: @vecadd
+tt.func @vecadd(%x: !tt.ptr<f32>, %y: !tt.ptr<f32>, %n: i32) {
+  // CHECK: %[[PID:.*]] = tt.get_program_id x : i32
+  // CHECK: %[[OFF:.*]] = arith.muli %[[PID]], %{{.*}} : i32
+  // CHECK: %[[OFF64:.*]] = arith.extsi %[[OFF]] : i32 to i64
+  // CHECK: %[[SUM:.*]] = arith.addi %{{.*}}, %[[OFF64]] : i64
+  // CHECK: %[[HI:.*]] = arith.addi %[[SUM]], %c1023_i64 : i64
+  // CHECK: %[[IN:.*]] = arith.cmpi slt, %[[HI]], %{{.*}} : i64
+  // CHECK: %[[COND:.*]] = arith.andi %{{.*}}, %[[IN]] : i1
+  // CHECK: scf.if %[[COND]] {
+  // CHECK: %[[TRUE:.*]] = arith.constant dense<true> : tensor<1024xi1>
+  // CHECK: tt.load %{{.*}}, %[[TRUE]]
+  // CHECK: tt.store %{{.*}}, %{{.*}}, %[[TRUE]]
+  // CHECK: } else {
+  // CHECK: %[[MASK:.*]] = arith.cmpi slt, %{{.*}}, %{{.*}} : tensor<1024xi32>
+  // CHECK: tt.load %{{.*}}, %[[MASK]]
+  // CHECK: tt.store %{{.*}}, %{{.*}}, %[[MASK]]
+  // CHECK: }
+  // CHECK-NEXT: tt.return
+  %c1024 = arith.constant 1024 : i32
+  %pid = tt.get_program_id x : i32
+  %off = arith.muli %pid, %c1024 : i32
+  %range = tt.make_range {end = 1024 : i32, start = 0 : i32} : tensor<1024xi32>
+  %off_splat = tt.splat %off : (i32) -> tensor<1024xi32>
+  %offs = arith.addi %off_splat, %range : tensor<1024xi32>
+  %n_splat = tt.splat %n : (i32) -> tensor<1024xi32>
+  %mask = arith.cmpi slt, %offs, %n_splat : tensor<1024xi32>
+  %x_splat = tt.splat %x : (!tt.ptr<f32>) -> tensor<1024x!tt.ptr<f32>>
+  %x_ptrs = tt.addptr %x_splat, %offs : tensor<1024x!tt.ptr<f32>>, tensor<1024xi32>
+  %val = tt.load %x_ptrs, %mask {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<1024xf32>
+  %y_splat = tt.splat %y : (!tt.ptr<f32>) -> tensor<1024x!tt.ptr<f32>>
+  %y_ptrs = tt.addptr %y_splat, %offs : tensor<1024x!tt.ptr<f32>>, tensor<1024xi32>
+  tt.store %y_ptrs, %val, %mask : tensor<1024xf32>
+  tt.return
+}
+
+// -----
+
+// The mask of the loop depends on the induction variable, so the loop body is
+// versioned and yields the pointers from both versions.
+
+// CHECK-LABEL: @fill
+tt.func @fill(%x: !tt.ptr<f32>, %n: i32) {
+  %c0 = arith.constant 0 : i32
+  %c256 = arith.constant 256 : i32
+  %one = arith.constant dense<1.000000e+00> : tensor<256xf32>
+  %range = tt.make_range {end = 256 : i32, start = 0 : i32} : tensor<256xi32>
+  %n_splat = tt.splat %n : (i32) -> tensor<256xi32>
+  %x_splat = tt.splat %x : (!tt.ptr<f32>) -> tensor<256x!tt.ptr<f32>>
+  // CHECK: scf.for %[[I:.*]] = {{.*}} iter_args(%[[PTRS:.*]] = {{.*}})
+  %end = scf.for %i = %c0 to %n step %c256 iter_args(%ptrs = %x_splat) -> (tensor<256x!tt.ptr<f32>>) : i32 {
+    // CHECK: %[[I64:.*]] = arith.extsi %[[I]] : i32 to i64
+    // CHECK: %[[R:.*]] = scf.if %{{.*}} -> (tensor<256x!tt.ptr<f32>>) {
+    // CHECK: %[[TRUE:.*]] = arith.constant dense<true> : tensor<256xi1>
+    // CHECK: tt.store %{{.*}}, %{{.*}}, %[[TRUE]]
+    // CHECK: scf.yield %{{.*}} : tensor<256x!tt.ptr<f32>>
+    // CHECK: } else {
+    // CHECK: arith.cmpi slt
+    // CHECK: scf.yield %{{.*}} : tensor<256x!tt.ptr<f32>>
+    // CHECK: }
+    // CHECK-NEXT: scf.yield %[[R]] : tensor<256x!tt.ptr<f32>>
+    %i_splat = tt.splat %i : (i32) -> tensor<256xi32>
+    %offs = arith.addi %i_splat, %range : tensor<256xi32>
+    %mask = arith.cmpi slt, %offs, %n_splat : tensor<256xi32>
+    tt.store %ptrs, %one, %mask : tensor<256xf32>
+    %next = tt.addptr %ptrs, %range : tensor<256x!tt.ptr<f32>>, tensor<256xi32>
+    scf.yield %next : tensor<256x!tt.ptr<f32>>
+  }
+  tt.return
+}
+
+// -----
+
+// The load is at the top level of the loop body, where the software
+// pipeliners look for loads, so the loop is not versioned.
+
+// CHECK-LABEL: @row_sum
+// CHECK-NOT: scf.if
+tt.func @row_sum(%x: !tt.ptr<f32>, %n: i32) -> tensor<256xf32> {
+  %c0 = arith.constant 0 : i32
+  %c256 = arith.constant 256 : i32
+  %zero = arith.constant dense<0.000000e+00> : tensor<256xf32>
+  %range = tt.make_range {end = 256 : i32, start = 0 : i32} : tensor<256xi32>
+  %n_splat = tt.splat %n : (i32) -> tensor<256xi32>
+  %x_splat = tt.splat %x : (!tt.ptr<f32>) -> tensor<256x!tt.ptr<f32>>
+  %sum = scf.for %i = %c0 to %n step %c256 iter_args(%acc = %zero) -> (tensor<256xf32>) : i32 {
+    %i_splat = tt.splat %i : (i32) -> tensor<256xi32>
+    %offs = arith.addi %i_splat, %range : tensor<256xi32>
+    %mask = arith.cmpi slt, %offs, %n_splat : tensor<256xi32>
+    %ptrs = tt.addptr %x_splat, %offs : tensor<256x!tt.ptr<f32>>, tensor<256xi32>
+    %val = tt.load %ptrs, %mask, %zero {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<256xf32>
+    %next = arith.addf %acc, %val : tensor<256xf32>
+    scf.yield %next : tensor<256xf32>
+  }
+  tt.return %sum : tensor<256xf32>
+}
+
+// -----
+
+// Loops with a dot are left to the pipeliners, and the mask depends on the
+// induction variable of the loop, so nothing is versioned.
+
+// CHECK-LABEL: @dot_loop
+// CHECK-NOT: scf.if
+tt.func @dot_loop(%a: !tt.ptr<f16>, %k: i32) -> tensor<32x32xf32> {
+  %c0 = arith.constant 0 : i32
+  %c32 = arith.constant 32 : i32
+  %zero = arith.constant dense<0.000000e+00> : tensor<32x32xf32>
+  %other = arith.constant dense<0.000000e+00> : tensor<32x32xf16>
+  %range = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+  %cols = tt.expand_dims %range {axis = 0 : i32} : (tensor<32xi32>) -> tensor<1x32xi32>
+  %cols_b = tt.broadcast %cols : (tensor<1x32xi32>) -> tensor<32x32xi32>
+  %k_splat = tt.splat %k : (i32) -> tensor<32x32xi32>
+  %a_splat = tt.splat %a : (!tt.ptr<f16>) -> tensor<32x32x!tt.ptr<f16>>
+  %a_ptrs = tt.addptr %a_splat, %cols_b : tensor<32x32x!tt.ptr<f16>>, tensor<32x32xi32>
+  %res = scf.for %i = %c0 to %k step %c32 iter_args(%acc = %zero) -> (tensor<32x32xf32>) : i32 {
+    %i_splat = tt.splat %i : (i32) -> tensor<32x32xi32>
+    %offs = arith.addi %i_splat, %cols_b : tensor<32x32xi32>
+    %mask = arith.cmpi slt, %offs, %k_splat : tensor<32x32xi32>
+    %tile = tt.load %a_ptrs, %mask, %other {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<32x32xf16>
+    %d = tt.dot %tile, %tile, %acc {allowTF32 = true} : tensor<32x32xf16> * tensor<32x32xf16> -> tensor<32x32xf32>
+    scf.yield %d : tensor<32x32xf32>
+  }
+  tt.return %res : tensor<32x32xf32>
+}
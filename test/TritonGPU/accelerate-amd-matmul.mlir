@@ -0,0 +1,65 @@
+// RUN: triton-opt %s -split-input-file --tritonamdgpu-accelerate-matmul=matrix-core-version=2 | FileCheck %s
+// RUN: triton-opt %s -split-input-file --tritonamdgpu-accelerate-matmul="matrix-core-version=2 kpack=2" | FileCheck %s --check-prefix=KPACK
+// RUN: triton-opt %s -split-input-file --tritonamdgpu-accelerate-matmul=matrix-core-version=3 | FileCheck %s --check-prefix=CDNA3
+
+// With 8 warps, 32x32 instructions only give 4 tiles of a 64x64 result, so
+// half of the warps would duplicate the work. 16x16 instructions keep all the
+// warps busy and halve the estimated time.
+
+// CHECK: #[[MFMA:.*]] = #triton_gpu.mfma<{nonKDim = 16, warpsPerCTA = [2, 4], isTransposed = false
+#blocked = #triton_gpu.blocked<{sizePerThread = [1, 4], threadsPerWarp = [4, 16], warpsPerCTA = [8, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 8 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: small_dot
+  tt.func @small_dot(%a: tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>>, %b: tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>>, %c: tensor<64x64xf32, #blocked>) -> tensor<64x64xf32, #blocked> {
+    // CHECK: tt.dot {{.*}}triton_gpu.estimated_cycles = 512{{[^0-9]}}{{.*}} -> tensor<64x64xf32, #[[MFMA]]>
+    // With kpack=2, each thread loads the 4 elements of two 16x16x16
+    // instructions at once.
+    // KPACK-LABEL: small_dot
+    // KPACK: tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #{{.*}}, kWidth = 8, kPack = 2}>>
+    // KPACK: tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #{{.*}}, kWidth = 8, kPack = 2}>>
+    %d = tt.dot %a, %b, %c {allowTF32 = true} : tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>> * tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>> -> tensor<64x64xf32, #blocked>
+    tt.return %d : tensor<64x64xf32, #blocked>
+  }
+}
+
+// -----
+
+// A 4x64 result is too thin for 16x16 instructions. The 16 blocks of a 4x4
+// instruction are laid side by side along N, and each thread holds all the
+// 4 elements along K of its row or column.
+
+// CHECK: #[[MFMA:.*]] = #triton_gpu.mfma<{nonKDim = 4, warpsPerCTA = [4, 1], isTransposed = true
+#blocked = #triton_gpu.blocked<{sizePerThread = [1, 4], threadsPerWarp = [4, 16], warpsPerCTA = [1, 4], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: thin_dot
+  tt.func @thin_dot(%a: tensor<4x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>>, %b: tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>>, %c: tensor<4x64xf32, #blocked>) -> tensor<4x64xf32, #blocked> {
+    // CHECK: triton_gpu.convert_layout {{.*}} -> tensor<4x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #[[MFMA]], kWidth = 4}>>
+    // CHECK: tt.dot {{.*}}triton_gpu.estimated_cycles = 272{{[^0-9]}}{{.*}} -> tensor<4x64xf32, #[[MFMA]]>
+    %d = tt.dot %a, %b, %c {allowTF32 = true} : tensor<4x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>> * tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>> -> tensor<4x64xf32, #blocked>
+    tt.return %d : tensor<4x64xf32, #blocked>
+  }
+}
+
+// -----
+
+// fp32 dots allowing tf32 precision use the xf32 instructions of CDNA3, which
+// take 2 elements along K per lane, twice as many as the fp32 ones.
+
+#blocked = #triton_gpu.blocked<{sizePerThread = [1, 4], threadsPerWarp = [4, 16], warpsPerCTA = [4, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: fp32_dot_tf32
+  // CDNA3-LABEL: fp32_dot_tf32
+  tt.func @fp32_dot_tf32(%a: tensor<64x64xf32, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>>, %b: tensor<64x64xf32, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>>, %c: tensor<64x64xf32, #blocked>) -> tensor<64x64xf32, #blocked> {
+    // CHECK: tensor<64x64xf32, #triton_gpu.dot_op<{opIdx = 0, parent = #{{.*}}, kWidth = 1}>>
+    // CDNA3: tensor<64x64xf32, #triton_gpu.dot_op<{opIdx = 0, parent = #{{.*}}, kWidth = 2}>>
+    %d = tt.dot %a, %b, %c {allowTF32 = true} : tensor<64x64xf32, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>> * tensor<64x64xf32, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>> -> tensor<64x64xf32, #blocked>
+    tt.return %d : tensor<64x64xf32, #blocked>
+  }
+
+  // CDNA3-LABEL: fp32_dot_ieee
+  tt.func @fp32_dot_ieee(%a: tensor<64x64xf32, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>>, %b: tensor<64x64xf32, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>>, %c: tensor<64x64xf32, #blocked>) -> tensor<64x64xf32, #blocked> {
+    // CDNA3: tensor<64x64xf32, #triton_gpu.dot_op<{opIdx = 0, parent = #{{.*}}, kWidth = 1}>>
+    %d = tt.dot %a, %b, %c {allowTF32 = false} : tensor<64x64xf32, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>> * tensor<64x64xf32, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>> -> tensor<64x64xf32, #blocked>
+    tt.return %d : tensor<64x64xf32, #blocked>
+  }
+}
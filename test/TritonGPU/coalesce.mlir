@@ -69,3 +69,22 @@ tt.func @load_tensor(%arg0: !tt.ptr<f32, 1> {tt.divisibility = 16 : i32}, %arg1:
 }
 
 }
+
+// -----
+
+#blocked = #triton_gpu.blocked<{sizePerThread = [1], threadsPerWarp = [64], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+
+// Each lane of a 64-wide wavefront gets a full 128-bit vector.
+// CHECK: [[WIDE_LAYOUT:#.*]] = #triton_gpu.blocked<{sizePerThread = [8], threadsPerWarp = [64], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+// CHECK-LABEL: @load_f16_wavefront64
+tt.func @load_f16_wavefront64(%arg0: !tt.ptr<f16> {tt.divisibility = 16 : i32}) {
+  %0 = tt.make_range {end = 2048 : i32, start = 0 : i32} : tensor<2048xi32, #blocked>
+  %1 = tt.splat %arg0 : (!tt.ptr<f16>) -> tensor<2048x!tt.ptr<f16>, #blocked>
+  %2 = tt.addptr %1, %0 : tensor<2048x!tt.ptr<f16>, #blocked>, tensor<2048xi32, #blocked>
+  // CHECK: tt.load {{.*}} : tensor<2048xf16, [[WIDE_LAYOUT]]>
+  %3 = tt.load %2 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<2048xf16, #blocked>
+  tt.return
+}
+
+}
@@ -0,0 +1,58 @@
+// RUN: triton-opt %s -split-input-file -tritongpu-persistent-tiles=num-programs=304 | FileCheck %s
+
+#blocked = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [64], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+// The kernel takes the number of tiles as a new last argument, and uses it in
+// place of the grid size along x. The loop steps by the size of the grid it is
+// launched with.
+// CHECK: module attributes {{.*}}"triton_gpu.persistent-tiles"
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: @add_kernel
+  // CHECK-SAME: %[[NUM_TILES:[a-z0-9]+]]: i32)
+  // CHECK: %[[PID:.*]] = tt.get_program_id x : i32
+  // CHECK: %[[STEP:.*]] = tt.get_num_programs {axis = 0 : i32} : i32
+  // CHECK: scf.for %[[TILE:.*]] = %[[PID]] to %[[NUM_TILES]] step %[[STEP]] : i32 {
+  // CHECK-NOT: tt.get_program_id
+  // CHECK-NOT: tt.get_num_programs
+  // CHECK: arith.muli %[[TILE]]
+  // CHECK: arith.cmpi slt, {{.*}}, %[[NUM_TILES]]
+  // CHECK: tt.store
+  // CHECK: }
+  // CHECK-NEXT: tt.return
+  tt.func public @add_kernel(%arg0: !tt.ptr<f32> {tt.divisibility = 16 : i32}, %arg1: !tt.ptr<f32> {tt.divisibility = 16 : i32}) {
+    %c1024_i32 = arith.constant 1024 : i32
+    %0 = tt.get_program_id x : i32
+    %1 = arith.muli %0, %c1024_i32 : i32
+    %2 = tt.make_range {end = 1024 : i32, start = 0 : i32} : tensor<1024xi32, #blocked>
+    %3 = tt.splat %1 : (i32) -> tensor<1024xi32, #blocked>
+    %4 = arith.addi %3, %2 : tensor<1024xi32, #blocked>
+    %5 = tt.splat %arg0 : (!tt.ptr<f32>) -> tensor<1024x!tt.ptr<f32>, #blocked>
+    %6 = tt.addptr %5, %4 : tensor<1024x!tt.ptr<f32>, #blocked>, tensor<1024xi32, #blocked>
+    %7 = tt.load %6 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<1024xf32, #blocked>
+    // Stores are masked against the grid size
+    %n = tt.get_num_programs {axis = 0 : i32} : i32
+    %in_grid = arith.cmpi slt, %0, %n : i32
+    %8 = tt.splat %arg1 : (!tt.ptr<f32>) -> tensor<1024x!tt.ptr<f32>, #blocked>
+    %9 = tt.addptr %8, %4 : tensor<1024x!tt.ptr<f32>, #blocked>, tensor<1024xi32, #blocked>
+    %mask = tt.splat %in_grid : (i1) -> tensor<1024xi1, #blocked>
+    tt.store %9, %7, %mask {cache = 1 : i32, evict = 1 : i32} : tensor<1024xf32, #blocked>
+    tt.return
+  }
+}
+
+// -----
+
+#blocked = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [64], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // A 2D grid is left as is.
+  // CHECK-LABEL: @grid_2d
+  // CHECK-NOT: scf.for
+  tt.func public @grid_2d(%arg0: !tt.ptr<f32> {tt.divisibility = 16 : i32}) {
+    %0 = tt.get_program_id x : i32
+    %1 = tt.get_program_id y : i32
+    %2 = arith.addi %0, %1 : i32
+    %3 = tt.addptr %arg0, %2 : !tt.ptr<f32>, i32
+    %cst = arith.constant 0.000000e+00 : f32
+    tt.store %3, %cst {cache = 1 : i32, evict = 1 : i32} : f32
+    tt.return
+  }
+}
@@ -1,4 +1,6 @@
 // RUN: triton-opt %s -split-input-file -tritongpu-prefetch -canonicalize | FileCheck %s
+// RUN: triton-opt %s -split-input-file -tritongpu-prefetch=waves-per-eu=8 -canonicalize | FileCheck %s --check-prefix=BUDGET
+// RUN: triton-opt %s -split-input-file -tritongpu-prefetch="waves-per-eu=1 matrix-core-version=1" -canonicalize | FileCheck %s --check-prefix=BUDGET
 
 // 4 warps
 // matmul: 128x32 @ 32x128 -> 128x128
@@ -11,6 +13,12 @@
 #B_OP = #triton_gpu.dot_op<{opIdx = 1, parent = #C, kWidth = 2}>
 
 
+// With 8 waves per EU, the 64 registers of the budget are already taken by
+// the accumulator: the dot is not prefetched. Neither is it on gfx908 with a
+// single wave, whose 256 VGPRs are taken by the accumulator and the pointers.
+// BUDGET-LABEL: tt.func @matmul_loop_mixed
+// BUDGET-NOT: triton_gpu.extract_slice
+
 // CHECK: tt.func @matmul_loop_mixed
 // CHECK-DAG: %[[A0_PREFETCH_SMEM:.*]] = triton_gpu.extract_slice %[[A0:.*]][0, 0] [128, 16]
 // CHECK-DAG: %[[A0_PREFETCH:.*]] = triton_gpu.convert_layout %[[A0_PREFETCH_SMEM]]
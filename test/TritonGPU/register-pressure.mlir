@@ -0,0 +1,57 @@
+// RUN: triton-opt %s -split-input-file -tritongpu-annotate-register-pressure | FileCheck %s
+
+// Each thread holds 4 elements of the tiles: 4 regs for f32, 8 for pointers.
+#blocked = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [64], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // The peak is at the add: the pointers, the loaded tile and the sum.
+  // CHECK-LABEL: @straight_line
+  // CHECK-SAME: triton_gpu.estimated_vgprs = 16 : i32
+  tt.func public @straight_line(%ptr: tensor<1024x!tt.ptr<f32>, #blocked>) {
+    %0 = tt.load %ptr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<1024xf32, #blocked>
+    %1 = arith.addf %0, %0 : tensor<1024xf32, #blocked>
+    tt.store %ptr, %1 {cache = 1 : i32, evict = 1 : i32} : tensor<1024xf32, #blocked>
+    tt.return
+  }
+}
+
+// -----
+
+// Loop invariants stay live in the whole loop, even after their last use in
+// the body: %in and %out take 16 regs, on top of the accumulator, the loaded
+// tile and the sum.
+#blocked = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [64], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: @loop
+  // CHECK-SAME: triton_gpu.estimated_vgprs = 28 : i32
+  // CHECK: scf.for
+  // CHECK: } {triton_gpu.estimated_vgprs = 28 : i32}
+  tt.func public @loop(%in: tensor<1024x!tt.ptr<f32>, #blocked>, %out: tensor<1024x!tt.ptr<f32>, #blocked>, %n: i32) {
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i32 = arith.constant 1 : i32
+    %cst = arith.constant dense<0.000000e+00> : tensor<1024xf32, #blocked>
+    %0 = scf.for %i = %c0_i32 to %n step %c1_i32 iter_args(%acc = %cst) -> (tensor<1024xf32, #blocked>) : i32 {
+      %1 = tt.load %in {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<1024xf32, #blocked>
+      %2 = arith.addf %acc, %1 : tensor<1024xf32, #blocked>
+      scf.yield %2 : tensor<1024xf32, #blocked>
+    }
+    tt.store %out, %0 {cache = 1 : i32, evict = 1 : i32} : tensor<1024xf32, #blocked>
+    tt.return
+  }
+}
+
+// -----
+
+// Tiles in shared memory do not take registers.
+#blocked = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [64], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+#shared = #triton_gpu.shared<{vec = 1, perPhase = 1, maxPhase = 1, order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: @shared
+  // CHECK-SAME: triton_gpu.estimated_vgprs = 12 : i32
+  tt.func public @shared(%ptr: tensor<1024x!tt.ptr<f32>, #blocked>) {
+    %0 = tt.load %ptr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<1024xf32, #blocked>
+    %1 = triton_gpu.convert_layout %0 : (tensor<1024xf32, #blocked>) -> tensor<1024xf32, #shared>
+    %2 = triton_gpu.convert_layout %1 : (tensor<1024xf32, #shared>) -> tensor<1024xf32, #blocked>
+    tt.store %ptr, %2 {cache = 1 : i32, evict = 1 : i32} : tensor<1024xf32, #blocked>
+    tt.return
+  }
+}
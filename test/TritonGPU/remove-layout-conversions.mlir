@@ -57,3 +57,150 @@ module attributes {"triton_gpu.compute-capability" = 0 : i32, "triton_gpu.num-ct
     tt.return
   }
 }
+
+// -----
+
+// %c receives both layouts. Computing it in the layout of %b, which is also
+// the layout of the store, only needs %a to be converted, while the blocked
+// layout of %a would need a conversion of %b and another for the store.
+
+#A = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [32], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+#B = #triton_gpu.blocked<{sizePerThread = [1], threadsPerWarp = [32], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 32 : i32} {
+  // CHECK-LABEL: resolve_conflict_by_cost
+  tt.func public @resolve_conflict_by_cost(%arg0: !tt.ptr<f32, 1>, %arg1: !tt.ptr<f32, 1>, %arg2: !tt.ptr<f32, 1>) {
+    %rb = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32, #B>
+    %pb0 = tt.splat %arg1 : (!tt.ptr<f32, 1>) -> tensor<128x!tt.ptr<f32, 1>, #B>
+    %pb = tt.addptr %pb0, %rb : tensor<128x!tt.ptr<f32, 1>, #B>, tensor<128xi32, #B>
+    %b = tt.load %pb {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128xf32, #B>
+    %ra = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32, #A>
+    %pa0 = tt.splat %arg0 : (!tt.ptr<f32, 1>) -> tensor<128x!tt.ptr<f32, 1>, #A>
+    %pa = tt.addptr %pa0, %ra : tensor<128x!tt.ptr<f32, 1>, #A>, tensor<128xi32, #A>
+    %a = tt.load %pa {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128xf32, #A>
+    // CHECK: triton_gpu.convert_layout
+    // CHECK-NOT: triton_gpu.convert_layout
+    // CHECK: arith.addf
+    // CHECK-NOT: triton_gpu.convert_layout
+    // CHECK: tt.store
+    %ac = triton_gpu.convert_layout %a : (tensor<128xf32, #A>) -> tensor<128xf32, #B>
+    %c = arith.addf %ac, %b : tensor<128xf32, #B>
+    %pc0 = tt.splat %arg2 : (!tt.ptr<f32, 1>) -> tensor<128x!tt.ptr<f32, 1>, #B>
+    %pc = tt.addptr %pc0, %rb : tensor<128x!tt.ptr<f32, 1>, #B>, tensor<128xi32, #B>
+    tt.store %pc, %c {cache = 1 : i32, evict = 1 : i32} : tensor<128xf32, #B>
+    tt.return
+  }
+}
+
+// -----
+
+// The softmax of attention reduces the rows of the first dot while they are
+// still in the MFMA layout, and the probabilities only get converted to the
+// operand of the second dot.
+
+#blocked = #triton_gpu.blocked<{sizePerThread = [1, 4], threadsPerWarp = [16, 4], warpsPerCTA = [4, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#mfma = #triton_gpu.mfma<{nonKDim = 32, warpsPerCTA = [4, 1], isTransposed = true, CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [1, 0]}>
+#dot0 = #triton_gpu.dot_op<{opIdx = 0, parent = #mfma, kWidth = 4}>
+#dot1 = #triton_gpu.dot_op<{opIdx = 1, parent = #mfma, kWidth = 4}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 64 : i32} {
+  // CHECK-LABEL: attention_softmax_mfma
+  tt.func public @attention_softmax_mfma(%q: tensor<128x64xf16, #dot0>, %k: tensor<64x64xf16, #dot1>, %v: tensor<64x64xf16, #dot1>, %ptr: tensor<128x64x!tt.ptr<f32, 1>, #blocked>) {
+    %zero = arith.constant dense<0.000000e+00> : tensor<128x64xf32, #mfma>
+    // CHECK: tt.dot
+    // CHECK-NOT: triton_gpu.convert_layout
+    // CHECK: tt.reduce
+    // CHECK-NOT: triton_gpu.convert_layout
+    // CHECK: math.exp
+    // CHECK-NOT: triton_gpu.convert_layout
+    // CHECK: tt.reduce
+    // CHECK-NOT: triton_gpu.convert_layout
+    // CHECK: arith.truncf
+    // CHECK-NEXT: triton_gpu.convert_layout {{.*}} -> tensor<128x64xf16, #triton_gpu.dot_op<{opIdx = 0
+    // CHECK: tt.dot
+    %qk = tt.dot %q, %k, %zero {allowTF32 = true} : tensor<128x64xf16, #dot0> * tensor<64x64xf16, #dot1> -> tensor<128x64xf32, #mfma>
+    %qk_b = triton_gpu.convert_layout %qk : (tensor<128x64xf32, #mfma>) -> tensor<128x64xf32, #blocked>
+    %m = "tt.reduce" (%qk_b) ({
+    ^bb0(%a: f32, %b: f32):
+      %max = arith.maxf %a, %b : f32
+      tt.reduce.return %max : f32
+    }) {axis = 1 : i32} : (tensor<128x64xf32, #blocked>) -> tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #blocked}>>
+    %m2 = tt.expand_dims %m {axis = 1 : i32} : (tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #blocked}>>) -> tensor<128x1xf32, #blocked>
+    %mb = tt.broadcast %m2 : (tensor<128x1xf32, #blocked>) -> tensor<128x64xf32, #blocked>
+    %d = arith.subf %qk_b, %mb : tensor<128x64xf32, #blocked>
+    %p = math.exp %d : tensor<128x64xf32, #blocked>
+    %l = "tt.reduce" (%p) ({
+    ^bb0(%a: f32, %b: f32):
+      %add = arith.addf %a, %b : f32
+      tt.reduce.return %add : f32
+    }) {axis = 1 : i32} : (tensor<128x64xf32, #blocked>) -> tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #blocked}>>
+    %l2 = tt.expand_dims %l {axis = 1 : i32} : (tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #blocked}>>) -> tensor<128x1xf32, #blocked>
+    %lb = tt.broadcast %l2 : (tensor<128x1xf32, #blocked>) -> tensor<128x64xf32, #blocked>
+    %pn = arith.divf %p, %lb : tensor<128x64xf32, #blocked>
+    %p16 = arith.truncf %pn : tensor<128x64xf32, #blocked> to tensor<128x64xf16, #blocked>
+    %pa = triton_gpu.convert_layout %p16 : (tensor<128x64xf16, #blocked>) -> tensor<128x64xf16, #dot0>
+    %o = tt.dot %pa, %v, %zero {allowTF32 = true} : tensor<128x64xf16, #dot0> * tensor<64x64xf16, #dot1> -> tensor<128x64xf32, #mfma>
+    %ob = triton_gpu.convert_layout %o : (tensor<128x64xf32, #mfma>) -> tensor<128x64xf32, #blocked>
+    tt.store %ptr, %ob {cache = 1 : i32, evict = 1 : i32} : tensor<128x64xf32, #blocked>
+    tt.return
+  }
+}
+
+// -----
+
+// Conversions of pointer tensors are costed with 64-bit elements. The
+// addptr chain is cheaper to recompute in the layout of the load than the
+// conversion through shared memory.
+
+#A = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [32], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+#B = #triton_gpu.blocked<{sizePerThread = [1], threadsPerWarp = [32], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 32 : i32} {
+  // CHECK-LABEL: convert_ptr_tensor
+  tt.func public @convert_ptr_tensor(%arg0: !tt.ptr<f32, 1>, %arg1: !tt.ptr<f32, 1>) {
+    // CHECK-NOT: triton_gpu.convert_layout
+    // CHECK: tt.load
+    // CHECK-NOT: triton_gpu.convert_layout
+    // CHECK: tt.store
+    %ra = tt.make_range {end = 512 : i32, start = 0 : i32} : tensor<512xi32, #A>
+    %pa0 = tt.splat %arg0 : (!tt.ptr<f32, 1>) -> tensor<512x!tt.ptr<f32, 1>, #A>
+    %pa = tt.addptr %pa0, %ra : tensor<512x!tt.ptr<f32, 1>, #A>, tensor<512xi32, #A>
+    %pb = triton_gpu.convert_layout %pa : (tensor<512x!tt.ptr<f32, 1>, #A>) -> tensor<512x!tt.ptr<f32, 1>, #B>
+    %x = tt.load %pb {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<512xf32, #B>
+    %rb = tt.make_range {end = 512 : i32, start = 0 : i32} : tensor<512xi32, #B>
+    %pc0 = tt.splat %arg1 : (!tt.ptr<f32, 1>) -> tensor<512x!tt.ptr<f32, 1>, #B>
+    %pc = tt.addptr %pc0, %rb : tensor<512x!tt.ptr<f32, 1>, #B>, tensor<512xi32, #B>
+    tt.store %pc, %x {cache = 1 : i32, evict = 1 : i32} : tensor<512xf32, #B>
+    tt.return
+  }
+}
+
+// -----
+
+// Both conversions of %o share one rematerialized slice: the second one
+// reuses the values rematerialized for the first one instead of cloning the
+// slice again.
+
+#A = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [32], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+#B = #triton_gpu.blocked<{sizePerThread = [1], threadsPerWarp = [32], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 32 : i32} {
+  // CHECK-LABEL: remat_shared_slice
+  tt.func public @remat_shared_slice(%arg0: !tt.ptr<f32, 1>, %arg1: !tt.ptr<f32, 1>, %arg2: i32) {
+    // CHECK-NOT: triton_gpu.convert_layout
+    // CHECK: arith.addi
+    // CHECK-NOT: arith.addi
+    // CHECK-NOT: triton_gpu.convert_layout
+    // CHECK: tt.load
+    // CHECK-NOT: triton_gpu.convert_layout
+    // CHECK: tt.store
+    %r = tt.make_range {end = 512 : i32, start = 0 : i32} : tensor<512xi32, #A>
+    %s = tt.splat %arg2 : (i32) -> tensor<512xi32, #A>
+    %o = arith.addi %r, %s : tensor<512xi32, #A>
+    %o0 = triton_gpu.convert_layout %o : (tensor<512xi32, #A>) -> tensor<512xi32, #B>
+    %p0 = tt.splat %arg0 : (!tt.ptr<f32, 1>) -> tensor<512x!tt.ptr<f32, 1>, #B>
+    %p = tt.addptr %p0, %o0 : tensor<512x!tt.ptr<f32, 1>, #B>, tensor<512xi32, #B>
+    %x = tt.load %p {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<512xf32, #B>
+    %o1 = triton_gpu.convert_layout %o : (tensor<512xi32, #A>) -> tensor<512xi32, #B>
+    %q0 = tt.splat %arg1 : (!tt.ptr<f32, 1>) -> tensor<512x!tt.ptr<f32, 1>, #B>
+    %q = tt.addptr %q0, %o1 : tensor<512x!tt.ptr<f32, 1>, #B>, tensor<512xi32, #B>
+    tt.store %q, %x {cache = 1 : i32, evict = 1 : i32} : tensor<512xf32, #B>
+    tt.return
+  }
+}
@@ -47,3 +47,25 @@ module attributes {"triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-war
     tt.return
   }
 }
+
+// -----
+
+// check that loads move above stores to unrelated (noalias) buffers, but not
+// above stores that may alias them.
+// CHECK-LABEL: load_above_noalias_store
+//       CHECK: %[[A:.+]] = tt.load %arg1
+//  CHECK-NEXT: tt.store %arg0
+//  CHECK-NEXT: tt.store %arg2
+//  CHECK-NEXT: tt.load %arg2
+#blocked = #triton_gpu.blocked<{sizePerThread = [1, 1], threadsPerWarp = [32, 1], warpsPerCTA = [1, 4], order = [0, 1]}>
+module attributes {"triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 32 : i32} {
+  tt.func public @load_above_noalias_store(%arg0: tensor<32x32x!tt.ptr<f32>, #blocked>, %arg1: tensor<32x32x!tt.ptr<f32>, #blocked> {tt.noalias}, %arg2: tensor<32x32x!tt.ptr<f32>, #blocked>, %arg3: tensor<32x32xf32, #blocked>) attributes {noinline = false} {
+    tt.store %arg0, %arg3 {cache = 1 : i32, evict = 1 : i32} : tensor<32x32xf32, #blocked>
+    tt.store %arg2, %arg3 {cache = 1 : i32, evict = 1 : i32} : tensor<32x32xf32, #blocked>
+    %A = tt.load %arg1 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<32x32xf32, #blocked>
+    %B = tt.load %arg2 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<32x32xf32, #blocked>
+    %C = arith.addf %A, %B : tensor<32x32xf32, #blocked>
+    tt.store %arg0, %C {cache = 1 : i32, evict = 1 : i32} : tensor<32x32xf32, #blocked>
+    tt.return
+  }
+}
@@ -0,0 +1,45 @@
+// RUN: triton-opt %s -triton-version-masked-accesses -tritongpu-stream-pipeline -canonicalize | FileCheck %s
+
+#AL = #triton_gpu.blocked<{sizePerThread = [1, 4], threadsPerWarp = [4, 8], warpsPerCTA = [4, 1], order = [1, 0], CTAsPerCGA = [1, 1], CTASplitNum = [1, 1], CTAOrder = [0, 1]}>
+#SL = #triton_gpu.slice<{dim = 1, parent = #AL}>
+
+// The load of this loop without a dot has a boundary mask, so versioning the
+// loop body would move the load into an scf.if where the stream pipeliner no
+// longer sees it. The loop is left alone and the load is still pipelined.
+// CHECK-LABEL: tt.func @masked_row_sum_loop
+// CHECK-NOT: scf.if
+// Prologue
+// CHECK: %[[X0_LOAD:.*]] = tt.load %{{.*}}, %{{.*}}
+// Restructured for-loop
+// CHECK: scf.for {{.*}} iter_args({{.*}}, %[[X_ARG:.*]] = %[[X0_LOAD]]
+// CHECK-NOT: scf.if
+// CHECK:   %[[XN_LOAD:.*]] = tt.load
+// CHECK:   arith.extf %[[X_ARG]]
+// CHECK:   scf.yield {{.*}}, %[[XN_LOAD]]
+tt.func @masked_row_sum_loop(%x : !tt.ptr<f16>, %n : i32) -> tensor<128xf32, #SL> {
+  %c0 = arith.constant 0 : i32
+  %c32 = arith.constant 32 : i32
+  %zero = arith.constant dense<0.00e+00> : tensor<128x32xf16, #AL>
+  %sum_init = arith.constant dense<0.00e+00> : tensor<128xf32, #SL>
+  %range = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32, #triton_gpu.slice<{dim = 0, parent = #AL}>>
+  %cols = tt.expand_dims %range {axis = 0 : i32} : (tensor<32xi32, #triton_gpu.slice<{dim = 0, parent = #AL}>>) -> tensor<1x32xi32, #AL>
+  %cols_b = tt.broadcast %cols : (tensor<1x32xi32, #AL>) -> tensor<128x32xi32, #AL>
+  %n_splat = tt.splat %n : (i32) -> tensor<128x32xi32, #AL>
+  %x_splat = tt.splat %x : (!tt.ptr<f16>) -> tensor<128x32x!tt.ptr<f16>, #AL>
+  %loop = scf.for %i = %c0 to %n step %c32 iter_args(%prev_sum = %sum_init) -> (tensor<128xf32, #SL>) : i32 {
+    %i_splat = tt.splat %i : (i32) -> tensor<128x32xi32, #AL>
+    %offs = arith.addi %i_splat, %cols_b : tensor<128x32xi32, #AL>
+    %mask = arith.cmpi slt, %offs, %n_splat : tensor<128x32xi32, #AL>
+    %ptrs = tt.addptr %x_splat, %offs : tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32xi32, #AL>
+    %val = tt.load %ptrs, %mask, %zero {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128x32xf16, #AL>
+    %val32 = arith.extf %val : tensor<128x32xf16, #AL> to tensor<128x32xf32, #AL>
+    %row = "tt.reduce" (%val32) ({
+    ^bb0(%a: f32, %b: f32):
+      %add = arith.addf %a, %b : f32
+      tt.reduce.return %add : f32
+    }) {axis = 1 : i32} : (tensor<128x32xf32, #AL>) -> tensor<128xf32, #SL>
+    %sum = arith.addf %prev_sum, %row : tensor<128xf32, #SL>
+    scf.yield %sum : tensor<128xf32, #SL>
+  }
+  tt.return %loop : tensor<128xf32, #SL>
+}
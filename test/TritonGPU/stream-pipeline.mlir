@@ -1,4 +1,6 @@
 // RUN: triton-opt %s -split-input-file -tritongpu-stream-pipeline -canonicalize | FileCheck %s
+// RUN: triton-opt %s -split-input-file -tritongpu-stream-pipeline=num-stages=3 -canonicalize | FileCheck %s --check-prefix=STAGES3
+// RUN: triton-opt %s -split-input-file -tritongpu-stream-pipeline=num-stages=4 -canonicalize | FileCheck %s --check-prefix=STAGES4
 
 // 4 warps
 // matmul: 128x32 @ 32x128 -> 128x128
@@ -556,3 +558,194 @@ tt.func @matmul_mixed_kernel(%arg0: !tt.ptr<f8E4M3FNUZ> {tt.divisibility = 16 :
     tt.store %77, %85, %84 {cache = 1 : i32, evict = 1 : i32} : tensor<64x32xf16, #blocked2>
     tt.return
 }
+
+// With 3 stages, the tiles of the first two iterations are loaded in the
+// prologue. The loop loads the tile of iteration i + 2 and stores the one of
+// iteration i + 1, kept in registers, to the other buffer of the ring.
+// STAGES3-LABEL: tt.func @matmul_loop_multi_stage
+// Prologue
+// STAGES3: %[[A0_LOAD:.*]] = tt.load
+// STAGES3: %[[A_RING:.*]] = triton_gpu.alloc_tensor : tensor<2x128x32xf16, #{{.*}}>
+// STAGES3: %[[A_RING0:.*]] = tensor.insert_slice %[[A0_LOAD]] into %[[A_RING]][0, 0, 0] [1, 128, 32] [1, 1, 1]
+// STAGES3: %[[B0_LOAD:.*]] = tt.load
+// STAGES3: %[[B_RING:.*]] = triton_gpu.alloc_tensor : tensor<2x32x128xf16, #{{.*}}>
+// STAGES3: %[[B_RING0:.*]] = tensor.insert_slice %[[B0_LOAD]] into %[[B_RING]][0, 0, 0] [1, 32, 128] [1, 1, 1]
+// STAGES3: %[[A1_LOAD:.*]] = tt.load
+// STAGES3: %[[B1_LOAD:.*]] = tt.load
+// STAGES3-NOT: tt.load
+// Restructured for-loop
+// STAGES3: %[[FOR_OUTPUT:.*]]:{{.*}} = scf.for {{.*}} iter_args({{.*}}, %[[A_RING_ARG:.*]] = %[[A_RING0]], %[[B_RING_ARG:.*]] = %[[B_RING0]], %[[A1_ARG:.*]] = %[[A1_LOAD]], %[[B1_ARG:.*]] = %[[B1_LOAD]], %[[IDX:.*]] = %c0_i32, %{{.*}} = %{{.*}}, %{{.*}} = %{{.*}})
+// STAGES3:   %[[A_CUR:.*]] = triton_gpu.extract_slice %[[A_RING_ARG]][%[[IDX]], 0, 0] [1, 128, 32] [1, 1, 1]
+// STAGES3:   %[[B_CUR:.*]] = triton_gpu.extract_slice %[[B_RING_ARG]][%[[IDX]], 0, 0] [1, 32, 128] [1, 1, 1]
+// STAGES3:   %[[A2_LOAD:.*]] = tt.load
+// STAGES3:   %[[B2_LOAD:.*]] = tt.load
+// STAGES3:   %[[A_CVT:.*]] = triton_gpu.convert_layout %[[A_CUR]]
+// STAGES3:   %[[B_CVT:.*]] = triton_gpu.convert_layout %[[B_CUR]]
+// STAGES3:   tt.dot %[[A_CVT]], %[[B_CVT]]
+// STAGES3:   %[[A_NEXT:.*]] = tensor.insert_slice %[[A1_ARG]] into %[[A_RING_ARG]]
+// STAGES3:   %[[B_NEXT:.*]] = tensor.insert_slice %[[B1_ARG]] into %[[B_RING_ARG]]
+// STAGES3:   scf.yield {{.*}}, %[[A_NEXT]], %[[B_NEXT]], %[[A2_LOAD]], %[[B2_LOAD]], %{{.*}}, %{{.*}}, %{{.*}}
+// No epilogue: the loads past the end of the loop are masked off
+// STAGES3-NEXT: }
+// STAGES3-NEXT: tt.return %[[FOR_OUTPUT]]#0
+
+// With 4 stages, two tiles of each operand are kept in registers.
+// STAGES4-LABEL: tt.func @matmul_loop_multi_stage
+// STAGES4: triton_gpu.alloc_tensor : tensor<2x128x32xf16, #{{.*}}>
+// STAGES4: triton_gpu.alloc_tensor : tensor<2x32x128xf16, #{{.*}}>
+// STAGES4: %[[A1_LOAD:.*]] = tt.load
+// STAGES4: %[[B1_LOAD:.*]] = tt.load
+// STAGES4: %[[A2_LOAD:.*]] = tt.load
+// STAGES4: %[[B2_LOAD:.*]] = tt.load
+// STAGES4-NOT: tt.load
+// STAGES4: scf.for {{.*}} iter_args({{.*}}, %[[A_RING_ARG:.*]] = %{{.*}}, %[[B_RING_ARG:.*]] = %{{.*}}, %[[A1_ARG:.*]] = %[[A1_LOAD]], %[[A2_ARG:.*]] = %[[A2_LOAD]], %[[B1_ARG:.*]] = %[[B1_LOAD]], %[[B2_ARG:.*]] = %[[B2_LOAD]], %[[IDX:.*]] = %c0_i32,
+// STAGES4:   triton_gpu.extract_slice %[[A_RING_ARG]][%[[IDX]], 0, 0]
+// STAGES4:   triton_gpu.extract_slice %[[B_RING_ARG]][%[[IDX]], 0, 0]
+// STAGES4:   %[[A3_LOAD:.*]] = tt.load
+// STAGES4:   %[[B3_LOAD:.*]] = tt.load
+// STAGES4:   tt.dot
+// STAGES4:   %[[A_NEXT:.*]] = tensor.insert_slice %[[A1_ARG]] into %[[A_RING_ARG]]
+// STAGES4:   %[[B_NEXT:.*]] = tensor.insert_slice %[[B1_ARG]] into %[[B_RING_ARG]]
+// STAGES4:   scf.yield {{.*}}, %[[A_NEXT]], %[[B_NEXT]], %[[A2_ARG]], %[[A3_LOAD]], %[[B2_ARG]], %[[B3_LOAD]], %{{.*}}, %{{.*}}, %{{.*}}
+// STAGES4-NEXT: }
+// STAGES4-NEXT: tt.return
+
+tt.func @matmul_loop_multi_stage(%lb : index, %ub : index, %step : index,
+                                 %A : !tt.ptr<f16> {tt.divisibility = 16 : i32},
+                                 %B : !tt.ptr<f16> {tt.divisibility = 16 : i32}) -> tensor<128x128xf32, #C> {
+  // A ptrs
+  %a_ptr_splat = tt.splat %A : (!tt.ptr<f16>) -> tensor<128x32x!tt.ptr<f16>, #AL>
+  %a_tmp0 = tt.make_range {end = 32: i32, start = 0: i32} : tensor<32xi32, #ALs0>
+  %a_tmp1 = tt.expand_dims %a_tmp0 {axis = 0 : i32} : (tensor<32xi32, #ALs0>) -> tensor<1x32xi32, #AL>
+  %a_offs = tt.broadcast %a_tmp1 : (tensor<1x32xi32, #AL>) -> tensor<128x32xi32, #AL>
+  %a_ptr_init = tt.addptr %a_ptr_splat, %a_offs : tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32xi32, #AL>
+  // B ptrs
+  %b_ptr_splat = tt.splat %B : (!tt.ptr<f16>) -> tensor<32x128x!tt.ptr<f16>, #BL>
+  %b_tmp0 = tt.make_range {end = 128: i32, start = 0: i32} : tensor<128xi32, #BLs0>
+  %b_tmp1 = tt.expand_dims %b_tmp0 {axis = 0 : i32} : (tensor<128xi32, #BLs0>) -> tensor<1x128xi32, #BL>
+  %b_offs = tt.broadcast %b_tmp1 : (tensor<1x128xi32, #BL>) -> tensor<32x128xi32, #BL>
+  %b_ptr_init = tt.addptr %b_ptr_splat, %b_offs : tensor<32x128x!tt.ptr<f16>, #BL>, tensor<32x128xi32, #BL>
+
+  %c_init = arith.constant dense<0.00e+00> : tensor<128x128xf32, #C>
+  %a_off = arith.constant dense<4> : tensor<128x32xi32, #AL>
+  %b_off = arith.constant dense<4> : tensor<32x128xi32, #BL>
+
+  %loop:3 = scf.for %iv = %lb to %ub step %step iter_args(%a_ptr = %a_ptr_init, %b_ptr = %b_ptr_init, %prev_c = %c_init) -> (tensor<128x32x!tt.ptr<f16>, #AL>, tensor<32x128x!tt.ptr<f16>, #BL>, tensor<128x128xf32, #C>) {
+    %a_ = tt.load %a_ptr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128x32xf16, #AL>
+    %a = triton_gpu.convert_layout %a_ : (tensor<128x32xf16, #AL>) -> tensor<128x32xf16, #A>
+    %b_ = tt.load %b_ptr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<32x128xf16, #BL>
+    %b = triton_gpu.convert_layout %b_ : (tensor<32x128xf16, #BL>) -> tensor<32x128xf16, #B>
+
+    %c = tt.dot %a, %b, %prev_c {allowTF32 = true, transA = false, transB = false} : tensor<128x32xf16, #A> * tensor<32x128xf16, #B> -> tensor<128x128xf32, #C>
+
+    %next_a_ptr = tt.addptr %a_ptr, %a_off : tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32xi32, #AL>
+    %next_b_ptr = tt.addptr %b_ptr, %b_off : tensor<32x128x!tt.ptr<f16>, #BL>, tensor<32x128xi32, #BL>
+    scf.yield %next_a_ptr, %next_b_ptr, %c : tensor<128x32x!tt.ptr<f16>, #AL>, tensor<32x128x!tt.ptr<f16>, #BL>, tensor<128x128xf32, #C>
+  }
+  tt.return %loop#2: tensor<128x128xf32, #C>
+}
+
+// Loads that do not feed a dot are pipelined too. The f16 tile of the next
+// iteration fits in the register budget and is carried in registers as it
+// is. The f32 one does not and is staged through shared memory, then
+// converted back to its blocked layout before its first use.
+// CHECK-LABEL: tt.func @row_sum_loop
+// Prologue
+// CHECK: %[[A0_LOAD:.*]] = tt.load
+// CHECK: %[[B0_LOAD:.*]] = tt.load
+// CHECK: %[[B0_SHARED:.*]] = triton_gpu.convert_layout %[[B0_LOAD]] : (tensor<128x32xf32, #blocked{{.*}}>) -> tensor<128x32xf32, #shared{{.*}}>
+// Restructured for-loop
+// CHECK: %[[FOR_OUTPUT:.*]]:{{.*}} = scf.for {{.*}} iter_args({{.*}}, %[[A_ARG:.*]] = %[[A0_LOAD]], %[[B_ARG:.*]] = %[[B0_SHARED]],
+// CHECK:   %[[B_CUR:.*]] = triton_gpu.convert_layout %[[B_ARG]] : (tensor<128x32xf32, #shared{{.*}}>) -> tensor<128x32xf32, #blocked{{.*}}>
+// CHECK:   %[[AN_LOAD:.*]] = tt.load
+// CHECK:   %[[BN_LOAD:.*]] = tt.load
+// CHECK:   arith.extf %[[A_ARG]]
+// CHECK:   arith.mulf %{{.*}}, %[[B_CUR]]
+// CHECK:   "tt.reduce"
+// CHECK:   %[[BN_SHARED:.*]] = triton_gpu.convert_layout %[[BN_LOAD]]
+// CHECK:   scf.yield {{.*}}, %[[AN_LOAD]], %[[BN_SHARED]],
+// Epilogue
+// CHECK-NOT: tt.load
+// CHECK: triton_gpu.convert_layout %[[FOR_OUTPUT]]#{{.*}} : (tensor<128x32xf32, #shared{{.*}}>) -> tensor<128x32xf32, #blocked{{.*}}>
+// CHECK: arith.extf %[[FOR_OUTPUT]]#{{.*}}
+// CHECK: "tt.reduce"
+tt.func @row_sum_loop(%lb : index, %ub : index, %step : index,
+                      %a_ptr_init : tensor<128x32x!tt.ptr<f16>, #AL>,
+                      %b_ptr_init : tensor<128x32x!tt.ptr<f32>, #AL>) -> tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #AL}>> {
+  %off = arith.constant dense<32> : tensor<128x32xi32, #AL>
+  %sum_init = arith.constant dense<0.00e+00> : tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #AL}>>
+
+  %loop:3 = scf.for %iv = %lb to %ub step %step iter_args(%a_ptr = %a_ptr_init, %b_ptr = %b_ptr_init, %prev_sum = %sum_init) -> (tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32x!tt.ptr<f32>, #AL>, tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #AL}>>) {
+    %a = tt.load %a_ptr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128x32xf16, #AL>
+    %b = tt.load %b_ptr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128x32xf32, #AL>
+    %a32 = arith.extf %a : tensor<128x32xf16, #AL> to tensor<128x32xf32, #AL>
+    %ab = arith.mulf %a32, %b : tensor<128x32xf32, #AL>
+    %row = "tt.reduce" (%ab) ({
+    ^bb0(%x: f32, %y: f32):
+      %add = arith.addf %x, %y : f32
+      tt.reduce.return %add : f32
+    }) {axis = 1 : i32} : (tensor<128x32xf32, #AL>) -> tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #AL}>>
+    %sum = arith.addf %prev_sum, %row : tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #AL}>>
+    %next_a_ptr = tt.addptr %a_ptr, %off : tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32xi32, #AL>
+    %next_b_ptr = tt.addptr %b_ptr, %off : tensor<128x32x!tt.ptr<f32>, #AL>, tensor<128x32xi32, #AL>
+    scf.yield %next_a_ptr, %next_b_ptr, %sum : tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32x!tt.ptr<f32>, #AL>, tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #AL}>>
+  }
+  tt.return %loop#2 : tensor<128xf32, #triton_gpu.slice<{dim = 1, parent = #AL}>>
+}
+
+// The load reads what the previous iteration stored: issuing it ahead of
+// that store would read stale data, so the loop is not pipelined.
+// CHECK-LABEL: tt.func @load_store_same_buffer
+// CHECK-NOT: tt.load
+// CHECK: scf.for
+// CHECK:   tt.load
+// CHECK:   tt.store
+// CHECK:   scf.yield
+tt.func @load_store_same_buffer(%lb : index, %ub : index, %step : index,
+                                %ptr_init : tensor<128x32x!tt.ptr<f32>, #AL>) {
+  %off = arith.constant dense<32> : tensor<128x32xi32, #AL>
+  %two = arith.constant dense<2.00e+00> : tensor<128x32xf32, #AL>
+  %loop = scf.for %iv = %lb to %ub step %step iter_args(%ptr = %ptr_init) -> (tensor<128x32x!tt.ptr<f32>, #AL>) {
+    %x = tt.load %ptr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128x32xf32, #AL>
+    %y = arith.mulf %x, %two : tensor<128x32xf32, #AL>
+    %next_ptr = tt.addptr %ptr, %off : tensor<128x32x!tt.ptr<f32>, #AL>, tensor<128x32xi32, #AL>
+    tt.store %next_ptr, %y : tensor<128x32xf32, #AL>
+    scf.yield %next_ptr : tensor<128x32x!tt.ptr<f32>, #AL>
+  }
+  tt.return
+}
+
+// The pointer of the previous row is forwarded from one iteration to the next.
+// With two stages, the prologue loads it from its initial value, and the loop
+// carries the pointer of the current row into it.
+// CHECK-LABEL: tt.func @forwarded_ptr_loop
+// Prologue
+// CHECK: %[[PREV0_LOAD:.*]] = tt.load
+// CHECK: %[[CUR0_LOAD:.*]] = tt.load
+// Restructured for-loop
+// CHECK: %[[FOR_OUTPUT:.*]]:{{.*}} = scf.for {{.*}} iter_args({{.*}}, %[[PREV_ARG:.*]] = %[[PREV0_LOAD]], %[[CUR_ARG:.*]] = %[[CUR0_LOAD]],
+// CHECK:   %[[PREVN_LOAD:.*]] = tt.load
+// CHECK:   %[[CURN_LOAD:.*]] = tt.load
+// CHECK:   arith.subf %[[CUR_ARG]], %[[PREV_ARG]]
+// CHECK:   scf.yield {{.*}}, %[[PREVN_LOAD]], %[[CURN_LOAD]],
+// Epilogue
+// CHECK-NOT: tt.load
+// CHECK: arith.subf %[[FOR_OUTPUT]]#{{.*}}, %[[FOR_OUTPUT]]#{{.*}}
+tt.func @forwarded_ptr_loop(%lb : index, %ub : index, %step : index,
+                            %prev_init : tensor<128x32x!tt.ptr<f16>, #AL>,
+                            %row_init : tensor<128x32x!tt.ptr<f16>, #AL>) -> tensor<128x32xf16, #AL> {
+  %cols = arith.constant dense<1> : tensor<128x32xi32, #AL>
+  %off = arith.constant dense<32> : tensor<128x32xi32, #AL>
+  %acc_init = arith.constant dense<0.00e+00> : tensor<128x32xf16, #AL>
+  %loop:3 = scf.for %iv = %lb to %ub step %step iter_args(%prev_row = %prev_init, %row = %row_init, %acc = %acc_init) -> (tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32xf16, #AL>) {
+    %prev_ptr = tt.addptr %prev_row, %cols : tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32xi32, #AL>
+    %prev = tt.load %prev_ptr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128x32xf16, #AL>
+    %cur_ptr = tt.addptr %row, %cols : tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32xi32, #AL>
+    %cur = tt.load %cur_ptr {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<128x32xf16, #AL>
+    %diff = arith.subf %cur, %prev : tensor<128x32xf16, #AL>
+    %sum = arith.addf %acc, %diff : tensor<128x32xf16, #AL>
+    %next_row = tt.addptr %row, %off : tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32xi32, #AL>
+    scf.yield %row, %next_row, %sum : tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32x!tt.ptr<f16>, #AL>, tensor<128x32xf16, #AL>
+  }
+  tt.return %loop#2 : tensor<128x32xf16, #AL>
+}
@@ -0,0 +1,55 @@
+#include "mlir/IR/AsmState.h"
+#include "mlir/Pass/Pass.h"
+#include "triton/Analysis/AxisInfo.h"
+#include "triton/Analysis/Uniformity.h"
+
+using namespace mlir;
+
+namespace {
+
+struct TestUniformityPass
+    : public PassWrapper<TestUniformityPass, OperationPass<ModuleOp>> {
+
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(TestUniformityPass);
+
+  StringRef getArgument() const final { return "test-print-uniformity"; }
+  StringRef getDescription() const final {
+    return "print the result of the uniformity analysis pass";
+  }
+
+  void runOnOperation() override {
+    ModuleOp moduleOp = getOperation();
+    ModuleAxisInfoAnalysis axisInfoAnalysis(moduleOp);
+    UniformityAnalysis uniformityAnalysis(moduleOp, axisInfoAnalysis);
+    AsmState state(moduleOp);
+    auto &os = llvm::errs();
+    auto print = [&](Value value) {
+      // Scalars are trivially uniform.
+      if (!value.getType().isa<RankedTensorType>())
+        return;
+      value.printAsOperand(os, state);
+      os << " => "
+         << (uniformityAnalysis.isUniform(value) ? "uniform" : "divergent")
+         << "\n";
+    };
+    moduleOp.walk([&](triton::FuncOp funcOp) {
+      os << "@" << funcOp.getSymName() << "\n";
+      funcOp.walk<WalkOrder::PreOrder>([&](Operation *op) {
+        for (Region &region : op->getRegions())
+          for (Block &block : region)
+            for (BlockArgument arg : block.getArguments())
+              print(arg);
+        for (Value result : op->getResults())
+          print(result);
+      });
+    });
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace test {
+void registerTestUniformityPass() { PassRegistration<TestUniformityPass>(); }
+} // namespace test
+} // namespace mlir
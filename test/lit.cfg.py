@@ -62,6 +62,7 @@ for d in tool_dirs:
     llvm_config.with_environment('PATH', d, append_path=True)
 tools = [
     'triton-opt',
+    'triton-translate',
     ToolSubst('%PYTHON', config.python_executable, unresolved='ignore'),
 ]
 
@@ -24,6 +24,7 @@
 #include "DumpLayout.h"
 
 #include "../../../lib/Conversion/TritonGPUToLLVM/TritonGPUToLLVMBase.h"
+#include "triton/Analysis/Utility.h"
 
 namespace mlir {
 namespace triton {
@@ -379,6 +380,77 @@ std::string dumpSharedLayout(Attribute layout, llvm::ArrayRef<int64_t> shape,
   return oss.str();
 }
 
+#ifdef USE_ROCM
+//===----------------------------------------------------------------------===//
+// Dump MFMA to Dot Operand Shortcut
+//===----------------------------------------------------------------------===//
+
+std::string dumpMfmaToDotShortcut(Attribute srcLayout, Attribute dstLayout,
+                                  llvm::ArrayRef<int64_t> shape) {
+  assert(shape.size() == 2 && "Only 2d shape supported");
+  auto f16Ty = FloatType::getF16(srcLayout.getContext());
+  auto srcTy = RankedTensorType::get(shape, f16Ty, srcLayout);
+  auto dstTy = RankedTensorType::get(shape, f16Ty, dstLayout);
+  auto shortcut = getMfmaToDotShortcut(srcTy, dstTy);
+  assert(shortcut && "No register-only conversion between the layouts");
+
+  int warpSize = getWarpSize(srcLayout);
+  int numThreads = warpSize * getNumWarpsPerCTA(srcLayout);
+  int numSrcElems = getTotalElemsPerThread(srcLayout, shape, f16Ty);
+
+  IndexEmitter emitter(srcLayout.getContext());
+  auto indices =
+      emitter.emitIndices(srcLayout, shape, /*withCTAOffset=*/false);
+  assert(indices.size() == numSrcElems &&
+         "Incorrect number of indices emitted");
+
+  // Coordinates of the source elements of every thread
+  std::vector<std::vector<std::pair<int, int>>> srcCoords(numThreads);
+  for (int tid = 0; tid < numThreads; ++tid)
+    for (int idx = 0; idx < numSrcElems; ++idx)
+      srcCoords[tid].push_back({eval(indices[idx][0], 0, tid),
+                                eval(indices[idx][1], 0, tid)});
+
+  int row = shape[0], col = shape[1];
+  std::vector<std::vector<std::string>> mapping(
+      row, std::vector<std::string>(col));
+  int nonKDim = shortcut->nonKDim;
+  const int chunkSize = 4;
+  for (int tid = 0; tid < numThreads; ++tid) {
+    int lane = tid % warpSize;
+    int group = lane / nonKDim;
+    for (int c = 0; c < (int)shortcut->srcChunks.size(); ++c) {
+      int srcTid = tid - lane + lane % nonKDim +
+                   nonKDim * shortcut->srcGroups[c][group];
+      int srcChunk = shortcut->srcChunks[c][group];
+      for (int elem = 0; elem < chunkSize; ++elem) {
+        auto [r, cl] = srcCoords[srcTid][srcChunk * chunkSize + elem];
+        assert(r >= 0 && r < row && cl >= 0 && cl < col &&
+               "Invalid index emitted");
+        std::ostringstream oss;
+        oss << "T" << tid << ":" << c * chunkSize + elem;
+        std::string &value = mapping[r][cl];
+        if (value.empty())
+          value = oss.str();
+        else
+          value = value + "|" + oss.str();
+      }
+    }
+  }
+
+  std::ostringstream oss;
+  for (int r = 0; r < row; ++r) {
+    for (int c = 0; c < col; ++c) {
+      if (c > 0)
+        oss << ",";
+      oss << mapping[r][c];
+    }
+    oss << "\n";
+  }
+  return oss.str();
+}
+#endif
+
 } // namespace gpu
 } // namespace triton
 } // namespace mlir
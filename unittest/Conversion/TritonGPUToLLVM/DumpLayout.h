@@ -36,6 +36,15 @@ std::string dumpDistributedLayout(Attribute layout,
 std::string dumpSharedLayout(Attribute layout, llvm::ArrayRef<int64_t> shape,
                              Type elemTy, bool multiCTA);
 
+#ifdef USE_ROCM
+// Dumps the MFMA dot operand layout `dstLayout` the way the register-only
+// conversion from the MFMA layout `srcLayout` builds it, in the format of
+// dumpDistributedLayout. The operand elements of a thread are numbered in
+// register order.
+std::string dumpMfmaToDotShortcut(Attribute srcLayout, Attribute dstLayout,
+                                  llvm::ArrayRef<int64_t> shape);
+#endif
+
 } // namespace gpu
 } // namespace triton
 } // namespace mlir
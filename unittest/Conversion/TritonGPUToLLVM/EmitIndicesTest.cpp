@@ -149,6 +149,24 @@ protected:
     runShared(row, col, layout, elemTy, /*multiCTA=*/false, refStr);
   }
 
+#ifdef USE_ROCM
+  // Checks that the register-only conversion from an MFMA layout builds the
+  // dot operand layout the shared memory loads of the operand produce
+  void runMfmaToDotShortcut(int row, int col, unsigned nonKDim,
+                            llvm::ArrayRef<unsigned> warpsPerCTA,
+                            bool isTransposed, unsigned opIdx,
+                            unsigned kWidth) {
+    auto mfmaLayout =
+        MfmaEncodingAttr::get(&context, nonKDim, warpsPerCTA, isTransposed,
+                              getSingleCTALayout2d());
+    auto dotLayout =
+        DotOperandEncodingAttr::get(&context, opIdx, mfmaLayout, kWidth);
+    assertSameStr(
+        getMfmaDotOperandRefStr(row, col, nonKDim, warpsPerCTA, opIdx, kWidth),
+        dumpMfmaToDotShortcut(mfmaLayout, dotLayout, {row, col}));
+  }
+#endif
+
 private:
   std::string skipSpaces(const std::string &input) {
     std::string output;
@@ -187,6 +205,57 @@ private:
                   dumpSharedLayout(layout, {row, col}, elemTy, multiCTA));
   }
 
+#ifdef USE_ROCM
+  // Lane l holds row (A) or column (B) l % nonKDim of every instruction, and
+  // the kWidth elements along K starting at kWidth * (l / nonKDim). Waves
+  // along the non-K axis take consecutive instructions, like in the result.
+  std::string getMfmaDotOperandRefStr(int row, int col, unsigned nonKDim,
+                                      llvm::ArrayRef<unsigned> warpsPerCTA,
+                                      unsigned opIdx, unsigned kWidth) {
+    int shape[2] = {row, col};
+    int kDimIdx = opIdx == 0 ? 1 : 0;
+    int nonKDimIdx = 1 - kDimIdx;
+    int warpSize = 64;
+    int numGroups = warpSize / nonKDim;
+    int numWarps = warpsPerCTA[0] * warpsPerCTA[1];
+    int instrsNonK = shape[nonKDimIdx] / nonKDim;
+    int warpsPerGroup = std::min<int>(warpsPerCTA[nonKDimIdx], instrsNonK);
+    int numRepNonK = std::max<int>(
+        1, shape[nonKDimIdx] / (nonKDim * warpsPerCTA[nonKDimIdx]));
+    int numRepK = shape[kDimIdx] / (kWidth * numGroups);
+
+    std::vector<std::vector<std::string>> mapping(
+        row, std::vector<std::string>(col));
+    for (int tid = 0; tid < warpSize * numWarps; ++tid) {
+      int wave = tid / warpSize, lane = tid % warpSize;
+      int waveNonK = opIdx == 0 ? wave % warpsPerCTA[0]
+                                : wave / warpsPerCTA[0] % warpsPerCTA[1];
+      waveNonK %= instrsNonK;
+      int idx = 0;
+      for (int nonK = 0; nonK < numRepNonK; ++nonK)
+        for (int k = 0; k < numRepK; ++k)
+          for (int elem = 0; elem < (int)kWidth; ++elem, ++idx) {
+            int nonKIdx = (nonK * warpsPerGroup + waveNonK) * nonKDim +
+                          lane % nonKDim;
+            int kIdx = (k * numGroups + lane / nonKDim) * kWidth + elem;
+            std::string &value = opIdx == 0 ? mapping[nonKIdx][kIdx]
+                                            : mapping[kIdx][nonKIdx];
+            std::string entry =
+                "T" + std::to_string(tid) + ":" + std::to_string(idx);
+            value = value.empty() ? entry : value + "|" + entry;
+          }
+    }
+
+    std::string refStr;
+    for (int r = 0; r < row; ++r) {
+      for (int c = 0; c < col; ++c)
+        refStr += (c > 0 ? "," : "") + mapping[r][c];
+      refStr += "\n";
+    }
+    return refStr;
+  }
+#endif
+
   CTALayoutAttr getSingleCTALayout1d() {
     return CTALayoutAttr::get(/*context=*/&context, /*CTAsPerCGA=*/{1},
                               /*CTASplitNum=*/{1}, /*CTAOrder=*/{0});
@@ -569,6 +638,42 @@ TEST_F(EmitIndicesTest, MmaLayout) {
                   /*refStr=*/refStr);
 }
 
+#ifdef USE_ROCM
+//===----------------------------------------------------------------------===//
+// Tests for the MFMA to dot operand shortcut
+//===----------------------------------------------------------------------===//
+
+TEST_F(EmitIndicesTest, MfmaToDotShortcut_32_Transposed) {
+  runMfmaToDotShortcut(/*row=*/64, /*col=*/64, /*nonKDim=*/32,
+                       /*warpsPerCTA=*/{2, 1}, /*isTransposed=*/true,
+                       /*opIdx=*/0, /*kWidth=*/4);
+}
+
+TEST_F(EmitIndicesTest, MfmaToDotShortcut_16_Transposed) {
+  runMfmaToDotShortcut(/*row=*/128, /*col=*/64, /*nonKDim=*/16,
+                       /*warpsPerCTA=*/{4, 1}, /*isTransposed=*/true,
+                       /*opIdx=*/0, /*kWidth=*/4);
+}
+
+TEST_F(EmitIndicesTest, MfmaToDotShortcut_16_NonTransposed) {
+  runMfmaToDotShortcut(/*row=*/64, /*col=*/128, /*nonKDim=*/16,
+                       /*warpsPerCTA=*/{1, 4}, /*isTransposed=*/false,
+                       /*opIdx=*/1, /*kWidth=*/8);
+}
+
+TEST_F(EmitIndicesTest, MfmaToDotShortcut_16_KWidth8) {
+  runMfmaToDotShortcut(/*row=*/32, /*col=*/32, /*nonKDim=*/16,
+                       /*warpsPerCTA=*/{2, 1}, /*isTransposed=*/true,
+                       /*opIdx=*/0, /*kWidth=*/8);
+}
+
+TEST_F(EmitIndicesTest, MfmaToDotShortcut_32_Warps2D) {
+  runMfmaToDotShortcut(/*row=*/64, /*col=*/32, /*nonKDim=*/32,
+                       /*warpsPerCTA=*/{2, 2}, /*isTransposed=*/true,
+                       /*opIdx=*/0, /*kWidth=*/16);
+}
+#endif
+
 //===----------------------------------------------------------------------===//
 // Tests for SharedEncodingAttr
 //===----------------------------------------------------------------------===//